@@ -0,0 +1,49 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    task_heap.h
+  * @brief   Heap for task TCBs and stacks in the CCM-RAM.
+  ******************************************************************************
+  * @attention
+  *
+  * With configTASK_MEMORY_FROM_SEPARATE_HEAP set to 1 in FreeRTOSConfig.h,
+  * xTaskCreate() takes the TCB and stack of each task from this heap, a
+  * TASK_HEAP_SIZE byte array in the 64 KB CCM-RAM, instead of from the
+  * FreeRTOS heap.  The FreeRTOS heap, which also holds queue storage, osPool
+  * and osMail blocks and anything else pvPortMalloc() returns, stays in the
+  * main SRAM, where the DMA controllers can reach it.
+  *
+  * Should the CCM-RAM heap be full, a task is given memory from the FreeRTOS
+  * heap instead, so task creation only fails when both are full.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TASK_HEAP_H
+#define __TASK_HEAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Bytes of CCM-RAM given to task TCBs and stacks.  The rest holds the
+   scheduler's data and the idle and timer task buffers. */
+#ifndef TASK_HEAP_SIZE
+  #define TASK_HEAP_SIZE          (32U * 1024U)
+#endif
+
+/* Exported functions prototypes ---------------------------------------------*/
+size_t xTaskHeapGetFreeSize(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TASK_HEAP_H */
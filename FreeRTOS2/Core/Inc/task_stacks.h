@@ -0,0 +1,18 @@
+/* Generated by tools/stack_analyzer.py from the -fstack-usage output and the
+ * call graph of the linked image.  Do not edit: the file is rewritten by every
+ * build whose worst case stack usage changed.
+ *
+ * Each size is the deepest call chain of the task, plus 204 bytes for the
+ * port to save the task context and a 32 byte margin, in words.
+ */
+
+#ifndef TASK_STACKS_H
+#define TASK_STACKS_H
+
+/* StartDefaultTask: 624 bytes, StartDefaultTask -> puts -> _puts_r -> __swbuf_r -> __swsetup_r -> __smakebuf_r -> _malloc_r -> sbrk_aligned -> _sbrk_r -> _sbrk -> __errno */
+#define TASK_STACK_WORDS_StartDefaultTask 216
+
+/* task2_init: 760 bytes, task2_init -> iprintf -> _vfiprintf_r -> __sfputs_r -> __sfputc_r -> __swbuf_r -> __swsetup_r -> __smakebuf_r -> _malloc_r -> sbrk_aligned -> _sbrk_r -> _sbrk -> __errno */
+#define TASK_STACK_WORDS_task2_init 250
+
+#endif /* TASK_STACKS_H */
@@ -23,6 +23,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "stdio.h"
+#include "task_stacks.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -130,7 +131,7 @@ int main(void)
 
   /* USER CODE BEGIN RTOS_THREADS */
   /* add threads, ... */
-  osThreadDef (Task2, task2_init, osPriorityAboveNormal, 0, 128);
+  osThreadDef (Task2, task2_init, osPriorityAboveNormal, 0, TASK_STACK_WORDS_task2_init);
   Task2Handler = osThreadCreate(osThread(Task2), NULL);
   /* USER CODE END RTOS_THREADS */
 
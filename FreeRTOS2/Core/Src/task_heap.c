@@ -0,0 +1,213 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    task_heap.c
+  * @brief   Heap for task TCBs and stacks in the CCM-RAM, used by the kernel
+  *          through pvPortMallocTaskMemory() and vPortFreeTaskMemory().
+  ******************************************************************************
+  * @attention
+  *
+  * A first fit allocator over a free list kept in address order, so a freed
+  * block is merged with free neighbours and deleting tasks does not fragment
+  * the heap.  Each block starts with a header holding its size, whose top bit
+  * is set while the block is allocated.  Like heap_4.c the list is protected
+  * by suspending the scheduler, so neither function may be called from an
+  * interrupt.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "task_heap.h"
+#include "task.h"
+#include "main.h"
+
+#if (configTASK_MEMORY_FROM_SEPARATE_HEAP == 1)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct TaskHeapBlock
+{
+  struct TaskHeapBlock *pxNext;   /* Next free block, in address order */
+  size_t xSize;                   /* Size including this header */
+} TaskHeapBlock_t;
+
+/* Private define ------------------------------------------------------------*/
+#define TASK_HEAP_HEADER_SIZE     ((sizeof(TaskHeapBlock_t) + (size_t)portBYTE_ALIGNMENT_MASK) \
+                                   & ~((size_t)portBYTE_ALIGNMENT_MASK))
+#define TASK_HEAP_MIN_BLOCK_SIZE  (TASK_HEAP_HEADER_SIZE * 2U)
+#define TASK_HEAP_ALLOCATED       ((size_t)1U << ((sizeof(size_t) * 8U) - 1U))
+
+/* Private macro -------------------------------------------------------------*/
+#define taskheapCONTAINS(pv) \
+  (((uint8_t *)(pv) >= ucTaskHeap) && ((uint8_t *)(pv) < &ucTaskHeap[TASK_HEAP_SIZE]))
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t ucTaskHeap[TASK_HEAP_SIZE] CCMRAM_BSS __attribute__((aligned(portBYTE_ALIGNMENT)));
+static TaskHeapBlock_t *pxFreeList = NULL;
+static size_t xFreeBytes = 0U;
+static BaseType_t xHeapInitialised = pdFALSE;
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvInitialiseTaskHeap(void);
+
+/**
+  * @brief  Allocate memory for a TCB or a task stack.  Called by
+  *         xTaskCreate().
+  * @param  xSize: Bytes wanted.
+  * @retval The memory, from the CCM-RAM if there is room there and otherwise
+  *         from pvPortMalloc(), or NULL if neither has room.
+  */
+void *pvPortMallocTaskMemory(size_t xSize)
+{
+  TaskHeapBlock_t *pxPrevious = NULL, *pxBlock, *pxRemainder;
+  void *pvReturn = NULL;
+  size_t xWantedSize;
+
+  if ((xSize != 0U) && (xSize <= (TASK_HEAP_SIZE - TASK_HEAP_HEADER_SIZE)))
+  {
+    xWantedSize = TASK_HEAP_HEADER_SIZE
+                + ((xSize + (size_t)portBYTE_ALIGNMENT_MASK) & ~((size_t)portBYTE_ALIGNMENT_MASK));
+
+    vTaskSuspendAll();
+    {
+      if (xHeapInitialised == pdFALSE)
+      {
+        prvInitialiseTaskHeap();
+      }
+
+      for (pxBlock = pxFreeList; pxBlock != NULL; pxBlock = pxBlock->pxNext)
+      {
+        if (pxBlock->xSize >= xWantedSize)
+        {
+          break;
+        }
+        pxPrevious = pxBlock;
+      }
+
+      if (pxBlock != NULL)
+      {
+        /* Split the block if what is left over is worth keeping. */
+        if ((pxBlock->xSize - xWantedSize) >= TASK_HEAP_MIN_BLOCK_SIZE)
+        {
+          pxRemainder = (TaskHeapBlock_t *)((uint8_t *)pxBlock + xWantedSize);
+          pxRemainder->xSize = pxBlock->xSize - xWantedSize;
+          pxRemainder->pxNext = pxBlock->pxNext;
+          pxBlock->xSize = xWantedSize;
+          pxBlock->pxNext = pxRemainder;
+        }
+
+        if (pxPrevious == NULL)
+        {
+          pxFreeList = pxBlock->pxNext;
+        }
+        else
+        {
+          pxPrevious->pxNext = pxBlock->pxNext;
+        }
+
+        xFreeBytes -= pxBlock->xSize;
+        pxBlock->xSize |= TASK_HEAP_ALLOCATED;
+        pxBlock->pxNext = NULL;
+        pvReturn = (uint8_t *)pxBlock + TASK_HEAP_HEADER_SIZE;
+      }
+    }
+    (void)xTaskResumeAll();
+  }
+
+  if (pvReturn == NULL)
+  {
+    pvReturn = pvPortMalloc(xSize);
+  }
+
+  return pvReturn;
+}
+
+/**
+  * @brief  Free memory returned by pvPortMallocTaskMemory().  Called when a
+  *         task created by xTaskCreate() is deleted.
+  * @param  pv: Memory to free, or NULL.
+  * @retval None
+  */
+void vPortFreeTaskMemory(void *pv)
+{
+  TaskHeapBlock_t *pxBlock, *pxPrevious = NULL, *pxNext;
+
+  if (pv == NULL)
+  {
+    return;
+  }
+
+  if (!taskheapCONTAINS(pv))
+  {
+    /* Allocated from the FreeRTOS heap when the CCM-RAM was full. */
+    vPortFree(pv);
+    return;
+  }
+
+  pxBlock = (TaskHeapBlock_t *)((uint8_t *)pv - TASK_HEAP_HEADER_SIZE);
+
+  /* Catches a double free, or a pointer that is not the start of a block. */
+  configASSERT((pxBlock->xSize & TASK_HEAP_ALLOCATED) != 0U);
+  configASSERT(pxBlock->pxNext == NULL);
+
+  vTaskSuspendAll();
+  {
+    pxBlock->xSize &= ~TASK_HEAP_ALLOCATED;
+    xFreeBytes += pxBlock->xSize;
+
+    for (pxNext = pxFreeList; (pxNext != NULL) && (pxNext < pxBlock); pxNext = pxNext->pxNext)
+    {
+      pxPrevious = pxNext;
+    }
+
+    /* Merge with the block after, then with the block before. */
+    if ((pxNext != NULL) && (((uint8_t *)pxBlock + pxBlock->xSize) == (uint8_t *)pxNext))
+    {
+      pxBlock->xSize += pxNext->xSize;
+      pxNext = pxNext->pxNext;
+    }
+    pxBlock->pxNext = pxNext;
+
+    if (pxPrevious == NULL)
+    {
+      pxFreeList = pxBlock;
+    }
+    else if (((uint8_t *)pxPrevious + pxPrevious->xSize) == (uint8_t *)pxBlock)
+    {
+      pxPrevious->xSize += pxBlock->xSize;
+      pxPrevious->pxNext = pxBlock->pxNext;
+    }
+    else
+    {
+      pxPrevious->pxNext = pxBlock;
+    }
+  }
+  (void)xTaskResumeAll();
+}
+
+/**
+  * @brief  Bytes free in the CCM-RAM heap.  Some of it may be in blocks too
+  *         small for a task.
+  * @retval Free bytes, headers included.
+  */
+size_t xTaskHeapGetFreeSize(void)
+{
+  return (xHeapInitialised != pdFALSE) ? xFreeBytes : (size_t)TASK_HEAP_SIZE;
+}
+
+/**
+  * @brief  Make the whole heap one free block.  Called with the scheduler
+  *         suspended.
+  * @retval None
+  */
+static void prvInitialiseTaskHeap(void)
+{
+  pxFreeList = (TaskHeapBlock_t *)ucTaskHeap;
+  pxFreeList->pxNext = NULL;
+  pxFreeList->xSize = TASK_HEAP_SIZE & ~((size_t)portBYTE_ALIGNMENT_MASK);
+  xFreeBytes = pxFreeList->xSize;
+  xHeapInitialised = pdTRUE;
+}
+
+#endif /* configTASK_MEMORY_FROM_SEPARATE_HEAP */
@@ -777,6 +777,74 @@ typedef QueueHandle_t SemaphoreHandle_t;
 	#define xSemaphoreCreateMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority )</pre>
+ *
+ * Creates a new mutex type semaphore that uses the immediate priority ceiling
+ * protocol, and returns a handle by which the new mutex can be referenced.
+ * configUSE_MUTEX_PRIORITY_CEILING must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * A task that takes the mutex is raised to uxCeilingPriority straight away,
+ * rather than only when a higher priority task blocks on the mutex as happens
+ * with priority inheritance.  Provided the ceiling is at least the priority of
+ * every task that uses the mutex, no task that uses it can run while it is
+ * held, so on a single core no task ever blocks on the mutex and contention
+ * costs no additional context switches.  The holder returns to its base
+ * priority once it has given back every mutex it holds.
+ *
+ * Mutexes created using this macro are accessed using the xSemaphoreTake() and
+ * xSemaphoreGive() macros, cannot be used recursively and cannot be used from
+ * interrupt service routines.
+ *
+ * @param uxCeilingPriority The priority at which the mutex holder runs.  Must
+ * be above tskIDLE_PRIORITY, below configMAX_PRIORITIES, and no lower than the
+ * priority of any task that takes the mutex.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If there was not enough heap to allocate the mutex data
+ * structures then NULL is returned.
+ *
+ * Example usage:
+ <pre>
+ SemaphoreHandle_t xUartMutex;
+
+ void vSetup( void )
+ {
+    // The highest priority task that writes to the UART runs at priority 3.
+    xUartMutex = xSemaphoreCreateMutexWithCeiling( 3 );
+ }
+ </pre>
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+	#define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority ) xQueueCreateMutexWithCeiling( ( uxCeilingPriority ) )
+#endif
+
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority, StaticSemaphore_t *pxMutexBuffer )</pre>
+ *
+ * As xSemaphoreCreateMutexWithCeiling(), but the memory that holds the mutex
+ * is provided by the application writer - see xSemaphoreCreateMutexStatic().
+ *
+ * @param uxCeilingPriority The priority at which the mutex holder runs.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the mutex's data structure.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If pxMutexBuffer was NULL then NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateMutexWithCeilingStatic xSemaphoreCreateMutexWithCeilingStatic
+ * \ingroup Semaphores
+ */
+#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+	#define xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxMutexBuffer ) xQueueCreateMutexWithCeilingStatic( ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
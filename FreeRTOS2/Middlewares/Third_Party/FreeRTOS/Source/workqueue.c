@@ -0,0 +1,384 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "workqueue.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not configured
+to include the work queue.  This #if is closed at the very bottom of this
+file. */
+#if ( configUSE_WORK_QUEUE == 1 )
+
+#ifndef configWORK_QUEUE_TASK_NAME
+	#define configWORK_QUEUE_TASK_NAME "Work Q"
+#endif
+
+#define workqueueINDEX_MASK		( ( uint32_t ) configWORK_QUEUE_LENGTH - 1UL )
+
+/* Latencies are measured with the run time stats clock, if there is one. */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define workqueueGET_TIME( ulTime ) portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime )
+	#else
+		#define workqueueGET_TIME( ulTime ) ( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+	#endif
+#else
+	#define workqueueGET_TIME( ulTime ) ( ulTime ) = 0UL
+#endif
+
+/* A slot in the ring.  ulSequence is set to one more than the position the
+slot was written at once the function and parameter are in place, so the work
+queue task can tell a slot that has been published from one that has only been
+reserved. */
+typedef struct WorkQueueItem
+{
+	WorkFunction_t pxFunction;
+	void *pvParameter;
+	uint32_t ulPostTime;
+	volatile uint32_t ulSequence;
+} WorkQueueItem_t;
+
+/* The ring itself.  Posters reserve the position at ulWorkQueueWriteIndex with
+a compare-and-swap, so interrupts that nest while posting each get their own
+slot.  Only the work queue task advances ulWorkQueueReadIndex.  Both indexes run
+freely and are masked into the ring, so unsigned subtraction gives the number
+of slots in use across a wrap. */
+PRIVILEGED_DATA static WorkQueueItem_t xWorkQueueRing[ configWORK_QUEUE_LENGTH ];
+PRIVILEGED_DATA static volatile uint32_t ulWorkQueueWriteIndex = 0UL;
+PRIVILEGED_DATA static volatile uint32_t ulWorkQueueReadIndex = 0UL;
+
+PRIVILEGED_DATA static TaskHandle_t xWorkQueueTaskHandle = NULL;
+
+/* Statistics.  ulPosted is derived from the write index. */
+PRIVILEGED_DATA static WorkQueueStats_t xWorkQueueStats = { 0 };
+PRIVILEGED_DATA static uint32_t ulWorkQueuePostedBase = 0UL;
+PRIVILEGED_DATA static volatile uint32_t ulWorkQueueOverflows = 0UL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The work queue task.  Runs every published function each time it is
+ * notified.
+ */
+static portTASK_FUNCTION_PROTO( prvWorkQueueTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Reserve a slot and publish pxFunction into it.  Safe to call from any
+ * context, including interrupts that nest within each other.
+ */
+static BaseType_t prvWorkQueueInsert( WorkFunction_t pxFunction, void *pvParameter ) PRIVILEGED_FUNCTION;
+
+/*
+ * Run every function that has been published, in order.
+ */
+static void prvWorkQueueDrain( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueCreateTask( void )
+{
+BaseType_t xReturn = pdFAIL;
+
+	/* This function is called when the scheduler is started if
+	configUSE_WORK_QUEUE is set to 1.  The ring is statically allocated, so
+	functions posted before the scheduler starts are run as soon as the task
+	does. */
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		PRIVILEGED_DATA static StaticTask_t xWorkQueueTaskTCB;
+		PRIVILEGED_DATA static StackType_t xWorkQueueTaskStack[ configWORK_QUEUE_TASK_STACK_DEPTH ];
+
+		xWorkQueueTaskHandle = xTaskCreateStatic(	prvWorkQueueTask,
+													configWORK_QUEUE_TASK_NAME,
+													configWORK_QUEUE_TASK_STACK_DEPTH,
+													NULL,
+													( ( UBaseType_t ) configWORK_QUEUE_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+													xWorkQueueTaskStack,
+													&xWorkQueueTaskTCB );
+
+		if( xWorkQueueTaskHandle != NULL )
+		{
+			xReturn = pdPASS;
+		}
+	}
+	#else
+	{
+		xReturn = xTaskCreate(	prvWorkQueueTask,
+								configWORK_QUEUE_TASK_NAME,
+								configWORK_QUEUE_TASK_STACK_DEPTH,
+								NULL,
+								( ( UBaseType_t ) configWORK_QUEUE_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+								&xWorkQueueTaskHandle );
+	}
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+	configASSERT( xReturn );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueuePostFromISR( WorkFunction_t pxFunction, void *pvParameter, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xReturn;
+
+	configASSERT( pxFunction );
+
+	xReturn = prvWorkQueueInsert( pxFunction, pvParameter );
+
+	/* Before the scheduler starts there is no task to notify, but the task
+	drains the ring when it first runs. */
+	if( ( xReturn != pdFAIL ) && ( xWorkQueueTaskHandle != NULL ) )
+	{
+		vTaskNotifyGiveFromISR( xWorkQueueTaskHandle, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueuePost( WorkFunction_t pxFunction, void *pvParameter )
+{
+BaseType_t xReturn;
+
+	configASSERT( pxFunction );
+
+	/* The work queue task stops at the first reserved slot that has not been
+	published, so a task preempted between the two would hold up every function
+	posted after it - including those posted from interrupts - until it next
+	ran.  Interrupts cannot be preempted by tasks, so only the task level post
+	needs the critical section. */
+	taskENTER_CRITICAL();
+	{
+		xReturn = prvWorkQueueInsert( pxFunction, pvParameter );
+	}
+	taskEXIT_CRITICAL();
+
+	if( ( xReturn != pdFAIL ) && ( xWorkQueueTaskHandle != NULL ) )
+	{
+		( void ) xTaskNotifyGive( xWorkQueueTaskHandle );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vWorkQueueGetStats( WorkQueueStats_t *pxStats )
+{
+	configASSERT( pxStats );
+
+	/* The work queue task updates the statistics, so stop it running part way
+	through the copy. */
+	taskENTER_CRITICAL();
+	{
+		*pxStats = xWorkQueueStats;
+		pxStats->ulPosted = ulWorkQueueWriteIndex - ulWorkQueuePostedBase;
+		pxStats->ulOverflows = ulWorkQueueOverflows;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vWorkQueueResetStats( void )
+{
+	taskENTER_CRITICAL();
+	{
+		xWorkQueueStats.ulExecuted = 0UL;
+		xWorkQueueStats.ulMaxBatch = 0UL;
+		xWorkQueueStats.ulLastLatency = 0UL;
+		xWorkQueueStats.ulMaxLatency = 0UL;
+		xWorkQueueStats.ullTotalLatency = 0ULL;
+		ulWorkQueuePostedBase = ulWorkQueueWriteIndex;
+		ulWorkQueueOverflows = 0UL;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xWorkQueueGetTaskHandle( void )
+{
+	return xWorkQueueTaskHandle;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWorkQueueInsert( WorkFunction_t pxFunction, void *pvParameter )
+{
+WorkQueueItem_t *pxItem;
+uint32_t ulPosition, ulOverflows;
+BaseType_t xReturn = pdPASS;
+
+	/* Reserve a position.  The read index only ever advances, so a stale read
+	of it can only make the ring look more full than it is. */
+	for( ;; )
+	{
+		ulPosition = ulWorkQueueWriteIndex;
+
+		if( ( ulPosition - ulWorkQueueReadIndex ) >= ( uint32_t ) configWORK_QUEUE_LENGTH )
+		{
+			xReturn = pdFAIL;
+			break;
+		}
+
+		if( portCOMPARE_AND_SWAP_U32( &ulWorkQueueWriteIndex, ulPosition, ulPosition + 1UL ) != pdFALSE )
+		{
+			break;
+		}
+	}
+
+	if( xReturn != pdFAIL )
+	{
+		pxItem = &( xWorkQueueRing[ ulPosition & workqueueINDEX_MASK ] );
+		pxItem->pxFunction = pxFunction;
+		pxItem->pvParameter = pvParameter;
+		workqueueGET_TIME( pxItem->ulPostTime );
+
+		/* Publish the slot only once its contents are complete. */
+		portMEMORY_BARRIER();
+		pxItem->ulSequence = ulPosition + 1UL;
+	}
+	else
+	{
+		do
+		{
+			ulOverflows = ulWorkQueueOverflows;
+		} while( portCOMPARE_AND_SWAP_U32( &ulWorkQueueOverflows, ulOverflows, ulOverflows + 1UL ) == pdFALSE );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkQueueDrain( void )
+{
+WorkQueueItem_t *pxItem;
+WorkFunction_t pxFunction;
+void *pvParameter;
+uint32_t ulPosition, ulBatch = 0UL;
+
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		uint32_t ulNow, ulLatency;
+	#endif
+
+	for( ;; )
+	{
+		ulPosition = ulWorkQueueReadIndex;
+		pxItem = &( xWorkQueueRing[ ulPosition & workqueueINDEX_MASK ] );
+
+		/* Stop at the first slot that has not been published.  A later slot
+		may already be published by a nested interrupt, but functions are run
+		in the order their slots were reserved. */
+		if( pxItem->ulSequence != ( ulPosition + 1UL ) )
+		{
+			break;
+		}
+
+		pxFunction = pxItem->pxFunction;
+		pvParameter = pxItem->pvParameter;
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			workqueueGET_TIME( ulNow );
+			ulLatency = ulNow - pxItem->ulPostTime;
+
+			xWorkQueueStats.ulLastLatency = ulLatency;
+			xWorkQueueStats.ullTotalLatency += ( uint64_t ) ulLatency;
+
+			if( ulLatency > xWorkQueueStats.ulMaxLatency )
+			{
+				xWorkQueueStats.ulMaxLatency = ulLatency;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configGENERATE_RUN_TIME_STATS */
+
+		/* The slot has been copied out, so hand it back before running the
+		function. */
+		portMEMORY_BARRIER();
+		ulWorkQueueReadIndex = ulPosition + 1UL;
+
+		pxFunction( pvParameter );
+		ulBatch++;
+	}
+
+	xWorkQueueStats.ulExecuted += ulBatch;
+
+	if( ulBatch > xWorkQueueStats.ulMaxBatch )
+	{
+		xWorkQueueStats.ulMaxBatch = ulBatch;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvWorkQueueTask, pvParameters )
+{
+	/* Just to avoid compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Run everything posted so far, then wait for more.  Posts made while
+		draining leave the notification count non-zero, so none are missed. */
+		prvWorkQueueDrain();
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include the work queue.  This #if is closed at the very bottom of this
+file. */
+#endif /* configUSE_WORK_QUEUE == 1 */
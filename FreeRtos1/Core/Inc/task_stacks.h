@@ -0,0 +1,21 @@
+/* Generated by tools/stack_analyzer.py from the -fstack-usage output and the
+ * call graph of the linked image.  Do not edit: the file is rewritten by every
+ * build whose worst case stack usage changed.
+ *
+ * Each size is the deepest call chain of the task, plus 204 bytes for the
+ * port to save the task context and a 32 byte margin, in words.
+ */
+
+#ifndef TASK_STACKS_H
+#define TASK_STACKS_H
+
+/* StartDefaultTask: 216 bytes, StartDefaultTask -> send_defaulttask -> HAL_UART_Transmit -> UART_WaitOnFlagUntilTimeout -> UART_EndRxTransfer */
+#define TASK_STACK_WORDS_StartDefaultTask 114
+
+/* StartTask02: 200 bytes, StartTask02 -> send_Task03 -> HAL_UART_Transmit -> UART_WaitOnFlagUntilTimeout -> UART_EndRxTransfer */
+#define TASK_STACK_WORDS_StartTask02 110
+
+/* Task3_init: 200 bytes, Task3_init -> send_Task03 -> HAL_UART_Transmit -> UART_WaitOnFlagUntilTimeout -> UART_EndRxTransfer */
+#define TASK_STACK_WORDS_Task3_init 110
+
+#endif /* TASK_STACKS_H */
@@ -22,6 +22,8 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "task_stacks.h"
+#include "clock_profile.h"
 
 /* USER CODE END Includes */
 
@@ -143,7 +145,7 @@ int main(void)
   /* USER CODE BEGIN RTOS_THREADS */
   /* add threads, ... */
   // define thread
-	osThreadDef(Task3,Task3_init, osPriorityNormal, 0, 128);
+	osThreadDef(Task3,Task3_init, osPriorityNormal, 0, TASK_STACK_WORDS_Task3_init);
 	//create thread
 	Task3Handle = osThreadCreate(osThread(Task3), NULL);
   /* USER CODE END RTOS_THREADS */
@@ -288,6 +290,34 @@ void Task3_init (void const * argument)
          osDelay (1000);  //
      }
  }
+
+/**
+  * @brief  Let the byte being sent on the UART finish before the bus clock
+  *         changes under it.
+  * @param  eProfile: Profile about to be switched to.
+  * @retval None
+  */
+void vClockProfileChangingHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartWaitIdle(&huart2);
+}
+
+/**
+  * @brief  Recompute the UART baud rate divider for the bus clock of the new
+  *         clock profile.  A task may be part way through
+  *         HAL_UART_Transmit(), so only BRR is rewritten.
+  * @param  eProfile: Profile now running.
+  * @retval None
+  */
+void vClockProfileChangedHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartRetune(&huart2);
+}
+
 /* USER CODE END 4 */
 
 /* USER CODE BEGIN Header_StartDefaultTask */
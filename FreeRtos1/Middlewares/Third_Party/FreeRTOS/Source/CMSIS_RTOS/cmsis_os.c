@@ -394,6 +394,38 @@ osTimerId osTimerCreate (const osTimerDef_t *timer_def, os_timer_type type, void
 #endif
 }
 
+#if (configUSE_TIMERS == 1)
+/* Convert the period of a timer to ticks, and the fraction of a tick left
+   over.  The fraction is sent with the period by xTimerChangePeriodExact(),
+   so the timer service task changes both together. */
+static TickType_t osTimerPeriod (uint32_t millisec, uint32_t *fraction)
+{
+#if (configUSE_TIMER_PHASE_LOCK == 1)
+  /* Keep the part of the period that is not a whole number of ticks as a
+     fraction of a tick, rounded up so the timer never expires early, so
+     periodic timers do not drift. */
+  uint64_t rate = (uint64_t)millisec * configTICK_RATE_HZ;
+  TickType_t ticks = (TickType_t)(rate / 1000U);
+
+  *fraction = (uint32_t)((((rate % 1000U) << 32) + 999U) / 1000U);
+
+  if (ticks == 0) {
+    ticks = 1;
+    *fraction = 0;
+  }
+#else
+  TickType_t ticks = millisec / portTICK_PERIOD_MS;
+
+  *fraction = 0;
+
+  if (ticks == 0)
+    ticks = 1;
+#endif
+
+  return ticks;
+}
+#endif
+
 /**
 * @brief  Start or restart a timer.
 * @param  timer_id      timer ID obtained by \ref osTimerCreate.
@@ -405,30 +437,63 @@ osStatus osTimerStart (osTimerId timer_id, uint32_t millisec)
 {
   osStatus result = osOK;
 #if (configUSE_TIMERS == 1)  
+
+  TickType_t ticks;
+  uint32_t fraction;
+
+  if (inHandlerMode()) {
+    return osTimerStartFromISR(timer_id, millisec);
+  }
+
+  ticks = osTimerPeriod(millisec, &fraction);
+#if (configUSE_TIMER_PHASE_LOCK == 1)
+  if (xTimerChangePeriodExact(timer_id, ticks, fraction, 0) != pdPASS)
+#else
+  (void) fraction;
+  if (xTimerChangePeriod(timer_id, ticks, 0) != pdPASS)
+#endif
+    result = osErrorOS;
+
+#else 
+  (void) timer_id;
+  (void) millisec;
+
+  result = osErrorOS;
+#endif
+  return result;
+}
+
+/**
+* @brief  Start or restart a timer from an interrupt service routine.
+* @param  timer_id      timer ID obtained by \ref osTimerCreate.
+* @param  millisec      time delay value of the timer.
+* @retval  status code that indicates the execution status of the function
+* @note   Like \ref osTimerStart without the check for the calling context.
+*/
+osStatus osTimerStartFromISR (osTimerId timer_id, uint32_t millisec)
+{
+  osStatus result = osOK;
+#if (configUSE_TIMERS == 1)
   portBASE_TYPE taskWoken = pdFALSE;
-  TickType_t ticks = millisec / portTICK_PERIOD_MS;
+  TickType_t ticks;
+  uint32_t fraction;
 
-  if (ticks == 0)
-    ticks = 1;
-    
-  if (inHandlerMode()) 
-  {
-    if (xTimerChangePeriodFromISR(timer_id, ticks, &taskWoken) != pdPASS)
-    {
-      result = osErrorOS;
-    }
-    else
-    {
-      portEND_SWITCHING_ISR(taskWoken);     
-    }
+  ticks = osTimerPeriod(millisec, &fraction);
+#if (configUSE_TIMER_PHASE_LOCK == 1)
+  if (xTimerChangePeriodExactFromISR(timer_id, ticks, fraction, &taskWoken) != pdPASS) {
+#else
+  (void) fraction;
+  if (xTimerChangePeriodFromISR(timer_id, ticks, &taskWoken) != pdPASS) {
+#endif
+    result = osErrorOS;
   }
-  else 
-  {
-    if (xTimerChangePeriod(timer_id, ticks, 0) != pdPASS)
-      result = osErrorOS;
+  else {
+    portEND_SWITCHING_ISR(taskWoken);
   }
+#else
+  (void) timer_id;
+  (void) millisec;
 
-#else 
   result = osErrorOS;
 #endif
   return result;
@@ -444,25 +509,46 @@ osStatus osTimerStop (osTimerId timer_id)
 {
   osStatus result = osOK;
 #if (configUSE_TIMERS == 1)  
-  portBASE_TYPE taskWoken = pdFALSE;
 
   if (inHandlerMode()) {
-    if (xTimerStopFromISR(timer_id, &taskWoken) != pdPASS) {
-      return osErrorOS;
-    }
-    portEND_SWITCHING_ISR(taskWoken);
+    return osTimerStopFromISR(timer_id);
   }
-  else {
-    if (xTimerStop(timer_id, 0) != pdPASS) {
-      result = osErrorOS;
-    }
+
+  if (xTimerStop(timer_id, 0) != pdPASS) {
+    result = osErrorOS;
   }
 #else 
+  (void) timer_id;
+
   result = osErrorOS;
 #endif 
   return result;
 }
 
+/**
+* @brief  Stop a timer from an interrupt service routine.
+* @param  timer_id      timer ID obtained by \ref osTimerCreate
+* @retval  status code that indicates the execution status of the function.
+* @note   Like \ref osTimerStop without the check for the calling context.
+*/
+osStatus osTimerStopFromISR (osTimerId timer_id)
+{
+#if (configUSE_TIMERS == 1)
+  portBASE_TYPE taskWoken = pdFALSE;
+
+  if (xTimerStopFromISR(timer_id, &taskWoken) != pdPASS) {
+    return osErrorOS;
+  }
+  portEND_SWITCHING_ISR(taskWoken);
+
+  return osOK;
+#else
+  (void) timer_id;
+
+  return osErrorOS;
+#endif
+}
+
 /**
 * @brief  Delete a timer.
 * @param  timer_id      timer ID obtained by \ref osTimerCreate
@@ -502,17 +588,14 @@ osStatus result = osOK;
 int32_t osSignalSet (osThreadId thread_id, int32_t signal)
 {
 #if( configUSE_TASK_NOTIFICATIONS == 1 )	
-  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
   uint32_t ulPreviousNotificationValue = 0;
   
   if (inHandlerMode())
   {
-    if(xTaskGenericNotifyFromISR( thread_id , (uint32_t)signal, eSetBits, &ulPreviousNotificationValue, &xHigherPriorityTaskWoken ) != pdPASS )
-      return 0x80000000;
-    
-    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+    return osSignalSetFromISR(thread_id, signal);
   }  
-  else if(xTaskGenericNotify( thread_id , (uint32_t)signal, eSetBits, &ulPreviousNotificationValue) != pdPASS )
+  
+  if(xTaskGenericNotify( thread_id , tskDEFAULT_INDEX_TO_NOTIFY, (uint32_t)signal, eSetBits, &ulPreviousNotificationValue) != pdPASS )
     return 0x80000000;
   
   return ulPreviousNotificationValue;
@@ -524,6 +607,33 @@ int32_t osSignalSet (osThreadId thread_id, int32_t signal)
 #endif
 }
 
+/**
+* @brief  Set the specified Signal Flags of an active thread from an interrupt service routine.
+* @param  thread_id     thread ID obtained by \ref osThreadCreate or \ref osThreadGetId.
+* @param  signals       specifies the signal flags of the thread that should be set.
+* @retval previous signal flags of the specified thread or 0x80000000 in case of incorrect parameters.
+* @note   Like \ref osSignalSet without the check for the calling context.
+*/
+int32_t osSignalSetFromISR (osThreadId thread_id, int32_t signal)
+{
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  uint32_t ulPreviousNotificationValue = 0;
+
+  if(xTaskGenericNotifyFromISR( thread_id , tskDEFAULT_INDEX_TO_NOTIFY, (uint32_t)signal, eSetBits, &ulPreviousNotificationValue, &xHigherPriorityTaskWoken ) != pdPASS )
+    return 0x80000000;
+
+  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+
+  return ulPreviousNotificationValue;
+#else
+  (void) thread_id;
+  (void) signal;
+
+  return 0x80000000; /* Task Notification not supported */
+#endif
+}
+
 /**
 * @brief  Clear the specified Signal Flags of an active thread.
 * @param  thread_id  thread ID obtained by \ref osThreadCreate or \ref osThreadGetId.
@@ -632,75 +742,514 @@ osStatus osMutexWait (osMutexId mutex_id, uint32_t millisec)
   if (mutex_id == NULL) {
     return osErrorParameter;
   }
-  
-  ticks = 0;
-  if (millisec == osWaitForever) {
-    ticks = portMAX_DELAY;
+  
+  ticks = 0;
+  if (millisec == osWaitForever) {
+    ticks = portMAX_DELAY;
+  }
+  else if (millisec != 0) {
+    ticks = millisec / portTICK_PERIOD_MS;
+    if (ticks == 0) {
+      ticks = 1;
+    }
+  }
+  
+  if (inHandlerMode()) {
+    if (xSemaphoreTakeFromISR(mutex_id, &taskWoken) != pdTRUE) {
+      return osErrorOS;
+    }
+	portEND_SWITCHING_ISR(taskWoken);
+  } 
+  else if (xSemaphoreTake(mutex_id, ticks) != pdTRUE) {
+    return osErrorOS;
+  }
+  
+  return osOK;
+}
+
+/**
+* @brief Release a Mutex that was obtained by \ref osMutexWait
+* @param mutex_id      mutex ID obtained by \ref osMutexCreate.
+* @retval  status code that indicates the execution status of the function.
+* @note   MUST REMAIN UNCHANGED: \b osMutexRelease shall be consistent in every CMSIS-RTOS.
+*/
+osStatus osMutexRelease (osMutexId mutex_id)
+{
+  osStatus result = osOK;
+  portBASE_TYPE taskWoken = pdFALSE;
+  
+  if (inHandlerMode()) {
+    if (xSemaphoreGiveFromISR(mutex_id, &taskWoken) != pdTRUE) {
+      return osErrorOS;
+    }
+    portEND_SWITCHING_ISR(taskWoken);
+  }
+  else if (xSemaphoreGive(mutex_id) != pdTRUE) 
+  {
+    result = osErrorOS;
+  }
+  return result;
+}
+
+/**
+* @brief Delete a Mutex
+* @param mutex_id  mutex ID obtained by \ref osMutexCreate.
+* @retval  status code that indicates the execution status of the function.
+* @note   MUST REMAIN UNCHANGED: \b osMutexDelete shall be consistent in every CMSIS-RTOS.
+*/
+osStatus osMutexDelete (osMutexId mutex_id)
+{
+  if (inHandlerMode()) {
+    return osErrorISR;
+  }
+
+  vQueueDelete(mutex_id);
+
+  return osOK;
+}
+
+/*****************  Waiting threads (fast semaphores, mail queues)  ************/
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+
+/* Notification bit used to hand a token or a mail block to a waiting thread.
+   Signal flags are limited to the low osFeature_Signals bits, so the two do
+   not clash. */
+#define osWaiterWakeFlag   0x80000000UL
+
+/* With more than one notification per task the hand over uses a notification
+   of its own, so waiting leaves the signal flags, which use the default
+   notification, untouched. */
+#if (configTASK_NOTIFICATION_ARRAY_ENTRIES > 1)
+#define osWaiterNotifyIndex  1
+#else
+#define osWaiterNotifyIndex  tskDEFAULT_INDEX_TO_NOTIFY
+#endif
+
+/* A thread waiting for a semaphore token or a mail block.  Lives on the
+   waiting thread's stack, and is only linked into or out of a list inside a
+   critical section. */
+typedef struct os_waiter {
+  struct os_waiter *next;
+  TaskHandle_t thread;
+  UBaseType_t priority;
+  void *item;                         ///< mail block handed over; NULL for a token
+  volatile uint32_t released;
+} os_waiter_t;
+
+/* Queue the calling thread on list, highest priority first.  Called inside a
+   critical section. */
+static void osWaiterEnqueue (os_waiter_t **list, os_waiter_t *waiter)
+{
+  os_waiter_t **link;
+
+  waiter->thread = xTaskGetCurrentTaskHandle();
+#if (INCLUDE_uxTaskPriorityGet == 1)
+  waiter->priority = uxTaskPriorityGet(NULL);
+#else
+  waiter->priority = 0;
+#endif
+  waiter->item = NULL;
+  waiter->released = 0;
+
+  for (link = list; (*link != NULL) && ((*link)->priority >= waiter->priority); link = &(*link)->next) {
+  }
+  waiter->next = *link;
+  *link = waiter;
+}
+
+/* Withdraw a waiter whose timeout expired.  Called inside a critical
+   section. */
+static void osWaiterRemove (os_waiter_t **list, os_waiter_t *waiter)
+{
+  os_waiter_t **link;
+
+  for (link = list; *link != waiter; link = &(*link)->next) {
+  }
+  *link = waiter->next;
+}
+
+/* Hand item to the highest priority waiter on list, and return the thread to
+   notify with osWaiterWakeFlag before leaving the critical section this is
+   called in.  The list must not be empty. */
+static TaskHandle_t osWaiterRelease (os_waiter_t **list, void *item)
+{
+  os_waiter_t *waiter = *list;
+
+  configASSERT(waiter != NULL);
+
+  *list = waiter->next;
+  waiter->item = item;
+  waiter->released = 1;
+
+  return waiter->thread;
+}
+
+/* Block until the waiter is released or the timeout expires, and return the
+   notification bits consumed.  The caller then reads released inside a
+   critical section, withdraws the waiter if it is still 0, and passes the
+   bits to osWaiterFinish. */
+static uint32_t osWaiterSleep (os_waiter_t *waiter, TickType_t ticks)
+{
+  TimeOut_t timeOut;
+  uint32_t value = 0;
+  uint32_t signals = 0;
+
+  vTaskSetTimeOutState(&timeOut);
+  while (waiter->released == 0) {
+    if (xTaskNotifyWaitIndexed(osWaiterNotifyIndex, 0, osWaiterWakeFlag, &value, ticks) == pdTRUE) {
+      signals |= value;
+    }
+    if ((waiter->released != 0) || (xTaskCheckForTimeOut(&timeOut, &ticks) != pdFALSE)) {
+      break;
+    }
+  }
+
+  return signals;
+}
+
+static void osWaiterFinish (const os_waiter_t *waiter, uint32_t signals)
+{
+  uint32_t value = 0;
+
+  if ((waiter->released != 0) && ((signals & osWaiterWakeFlag) == 0U)) {
+    /* Released after the timeout expired, so the wake notification is still
+       pending.  It was posted in the critical section that set released, so
+       does not need waiting for. */
+    if (xTaskNotifyWaitIndexed(osWaiterNotifyIndex, 0, osWaiterWakeFlag, &value, 0) == pdTRUE) {
+      signals |= value;
+    }
+  }
+
+  /* Keep signal flags that arrived while waiting visible to a later
+     osSignalWait, as consuming the notification cleared its pending state.
+     Only needed when both share the default notification, otherwise value
+     never holds signal flags. */
+  if ((signals & ~osWaiterWakeFlag) != 0U) {
+    xTaskNotify(xTaskGetCurrentTaskHandle(), 0, eSetBits);
+  }
+}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+/********************  Semaphore Management Functions **************************/
+
+#if (defined (osFeature_Semaphore)  &&  (osFeature_Semaphore != 0))
+
+#if (configUSE_CMSIS_FAST_SEMAPHORES == 1)
+
+/* count holds the number of available tokens or, when negative, minus the
+   number of waiting threads.  It is only modified with exclusive load/store,
+   or inside a critical section, so the uncontended paths need neither a
+   critical section nor the waiter list. */
+struct os_semaphore_cb {
+  volatile int32_t count;
+  int32_t max;
+  os_waiter_t *waiters;               ///< highest priority first
+  uint8_t isStatic;
+};
+
+/* Take a token if one is available, without blocking. */
+static int osSemaphoreTryTake (osSemaphoreId sem)
+{
+  int32_t count;
+
+  do {
+    count = (int32_t)__LDREXW((volatile uint32_t *)&sem->count);
+    if (count <= 0) {
+      __CLREX();
+      return 0;
+    }
+  } while (__STREXW((uint32_t)(count - 1), (volatile uint32_t *)&sem->count) != 0U);
+
+  return 1;
+}
+
+/* Return a token if nobody is waiting for it.  Returns -1 if there are
+   waiters, in which case the token must be handed over on the slow path. */
+static int osSemaphoreTryGive (osSemaphoreId sem)
+{
+  int32_t count;
+
+  do {
+    count = (int32_t)__LDREXW((volatile uint32_t *)&sem->count);
+    if (count < 0) {
+      __CLREX();
+      return -1;
+    }
+    if (count >= sem->max) {
+      __CLREX();
+      return 0;
+    }
+  } while (__STREXW((uint32_t)(count + 1), (volatile uint32_t *)&sem->count) != 0U);
+
+  return 1;
+}
+
+/* Hand a token straight to the highest priority waiter.  Called inside a
+   critical section with count negative, so the list cannot be empty. */
+static TaskHandle_t osSemaphoreReleaseWaiter (osSemaphoreId sem)
+{
+  sem->count++;
+
+  return osWaiterRelease(&sem->waiters, NULL);
+}
+
+/* Slow path of osSemaphoreWait: queue the calling thread and block until a
+   token is handed to it or the timeout expires. */
+static int osSemaphoreBlock (osSemaphoreId sem, TickType_t ticks)
+{
+  os_waiter_t waiter;
+  uint32_t signals;
+  int taken;
+
+  taskENTER_CRITICAL();
+  if (sem->count > 0) {
+    /* A token was returned since the fast path looked. */
+    sem->count--;
+    taskEXIT_CRITICAL();
+    return 1;
+  }
+  sem->count--;
+  osWaiterEnqueue(&sem->waiters, &waiter);
+  taskEXIT_CRITICAL();
+
+  signals = osWaiterSleep(&waiter, ticks);
+
+  taskENTER_CRITICAL();
+  taken = (int)waiter.released;
+  if (taken == 0) {
+    /* Timed out.  Withdraw from the list, which also withdraws the waiter
+       from the count. */
+    osWaiterRemove(&sem->waiters, &waiter);
+    sem->count++;
+  }
+  taskEXIT_CRITICAL();
+
+  osWaiterFinish(&waiter, signals);
+
+  return taken;
+}
+
+/**
+* @brief Create and Initialize a Semaphore object used for managing resources
+* @param semaphore_def semaphore definition referenced with \ref osSemaphore.
+* @param count         number of available resources.
+* @retval  semaphore ID for reference by other functions or NULL in case of error.
+* @note   MUST REMAIN UNCHANGED: \b osSemaphoreCreate shall be consistent in every CMSIS-RTOS.
+*/
+osSemaphoreId osSemaphoreCreate (const osSemaphoreDef_t *semaphore_def, int32_t count)
+{
+  osSemaphoreId sem = NULL;
+  uint8_t isStatic = 0;
+
+  if (count <= 0) {
+    return NULL;
+  }
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+  /* The static control block is sized for a queue based semaphore, which is
+     larger than this one. */
+  configASSERT(sizeof(struct os_semaphore_cb) <= sizeof(osStaticSemaphoreDef_t));
+  if (semaphore_def->controlblock != NULL) {
+    sem = (osSemaphoreId)semaphore_def->controlblock;
+    isStatic = 1;
+  }
+#endif
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+  if (sem == NULL) {
+    sem = pvPortMalloc(sizeof(struct os_semaphore_cb));
+  }
+#endif
+
+  if (sem != NULL) {
+    sem->count = count;
+    sem->max = count;
+    sem->waiters = NULL;
+    sem->isStatic = isStatic;
+  }
+
+  return sem;
+}
+
+/**
+* @brief Wait until a Semaphore token becomes available
+* @param  semaphore_id  semaphore object referenced with \ref osSemaphore.
+* @param  millisec      timeout value or 0 in case of no time-out.
+* @retval  number of available tokens, or -1 in case of incorrect parameters.
+* @note   MUST REMAIN UNCHANGED: \b osSemaphoreWait shall be consistent in every CMSIS-RTOS.
+*/
+int32_t osSemaphoreWait (osSemaphoreId semaphore_id, uint32_t millisec)
+{
+  TickType_t ticks;
+
+  if (semaphore_id == NULL) {
+    return osErrorParameter;
+  }
+
+  if (osSemaphoreTryTake(semaphore_id)) {
+    return osOK;
+  }
+
+  if (inHandlerMode()) {
+    return osErrorOS;
+  }
+
+  ticks = 0;
+  if (millisec == osWaitForever) {
+    ticks = portMAX_DELAY;
+  }
+  else if (millisec != 0) {
+    ticks = millisec / portTICK_PERIOD_MS;
+    if (ticks == 0) {
+      ticks = 1;
+    }
+  }
+
+  if (ticks == 0) {
+    return osErrorOS;
+  }
+
+  if (!osSemaphoreBlock(semaphore_id, ticks)) {
+    return osErrorOS;
+  }
+
+  return osOK;
+}
+
+/**
+* @brief Take a Semaphore token, if one is available, from an interrupt service routine
+* @param  semaphore_id  semaphore object referenced with \ref osSemaphore.
+* @retval  status code that indicates the execution status of the function.
+* @note   Like \ref osSemaphoreWait with no time-out, without the check for the calling context.
+*/
+int32_t osSemaphoreWaitFromISR (osSemaphoreId semaphore_id)
+{
+  if (semaphore_id == NULL) {
+    return osErrorParameter;
+  }
+
+  if (!osSemaphoreTryTake(semaphore_id)) {
+    return osErrorOS;
+  }
+
+  return osOK;
+}
+
+/**
+* @brief Release a Semaphore token
+* @param  semaphore_id  semaphore object referenced with \ref osSemaphore.
+* @retval  status code that indicates the execution status of the function.
+* @note   MUST REMAIN UNCHANGED: \b osSemaphoreRelease shall be consistent in every CMSIS-RTOS.
+*/
+osStatus osSemaphoreRelease (osSemaphoreId semaphore_id)
+{
+  osStatus result = osOK;
+  int given;
+
+  if (inHandlerMode()) {
+    return osSemaphoreReleaseFromISR(semaphore_id);
+  }
+
+  if (semaphore_id == NULL) {
+    return osErrorParameter;
   }
-  else if (millisec != 0) {
-    ticks = millisec / portTICK_PERIOD_MS;
-    if (ticks == 0) {
-      ticks = 1;
-    }
+
+  given = osSemaphoreTryGive(semaphore_id);
+  if (given > 0) {
+    return osOK;
   }
-  
-  if (inHandlerMode()) {
-    if (xSemaphoreTakeFromISR(mutex_id, &taskWoken) != pdTRUE) {
-      return osErrorOS;
-    }
-	portEND_SWITCHING_ISR(taskWoken);
-  } 
-  else if (xSemaphoreTake(mutex_id, ticks) != pdTRUE) {
+  if (given == 0) {
     return osErrorOS;
   }
-  
-  return osOK;
+
+  /* There are waiters.  Hand the token to one of them. */
+  taskENTER_CRITICAL();
+  if (semaphore_id->count < 0) {
+    xTaskNotifyIndexed(osSemaphoreReleaseWaiter(semaphore_id), osWaiterNotifyIndex, osWaiterWakeFlag, eSetBits);
+  }
+  else if (semaphore_id->count < semaphore_id->max) {
+    semaphore_id->count++;
+  }
+  else {
+    result = osErrorOS;
+  }
+  taskEXIT_CRITICAL();
+
+  return result;
 }
 
 /**
-* @brief Release a Mutex that was obtained by \ref osMutexWait
-* @param mutex_id      mutex ID obtained by \ref osMutexCreate.
+* @brief Release a Semaphore token from an interrupt service routine
+* @param  semaphore_id  semaphore object referenced with \ref osSemaphore.
 * @retval  status code that indicates the execution status of the function.
-* @note   MUST REMAIN UNCHANGED: \b osMutexRelease shall be consistent in every CMSIS-RTOS.
+* @note   Like \ref osSemaphoreRelease without the check for the calling context.
 */
-osStatus osMutexRelease (osMutexId mutex_id)
+osStatus osSemaphoreReleaseFromISR (osSemaphoreId semaphore_id)
 {
   osStatus result = osOK;
   portBASE_TYPE taskWoken = pdFALSE;
-  
-  if (inHandlerMode()) {
-    if (xSemaphoreGiveFromISR(mutex_id, &taskWoken) != pdTRUE) {
-      return osErrorOS;
-    }
-    portEND_SWITCHING_ISR(taskWoken);
+  UBaseType_t uxSavedInterruptStatus;
+  int given;
+
+  if (semaphore_id == NULL) {
+    return osErrorParameter;
   }
-  else if (xSemaphoreGive(mutex_id) != pdTRUE) 
-  {
+
+  given = osSemaphoreTryGive(semaphore_id);
+  if (given > 0) {
+    return osOK;
+  }
+  if (given == 0) {
+    return osErrorOS;
+  }
+
+  /* There are waiters.  Hand the token to one of them. */
+  uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+  if (semaphore_id->count < 0) {
+    xTaskNotifyIndexedFromISR(osSemaphoreReleaseWaiter(semaphore_id), osWaiterNotifyIndex, osWaiterWakeFlag, eSetBits, &taskWoken);
+  }
+  else if (semaphore_id->count < semaphore_id->max) {
+    semaphore_id->count++;
+  }
+  else {
     result = osErrorOS;
   }
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+  portEND_SWITCHING_ISR(taskWoken);
+
   return result;
 }
 
 /**
-* @brief Delete a Mutex
-* @param mutex_id  mutex ID obtained by \ref osMutexCreate.
+* @brief Delete a Semaphore
+* @param  semaphore_id  semaphore object referenced with \ref osSemaphore.
 * @retval  status code that indicates the execution status of the function.
-* @note   MUST REMAIN UNCHANGED: \b osMutexDelete shall be consistent in every CMSIS-RTOS.
+* @note   MUST REMAIN UNCHANGED: \b osSemaphoreDelete shall be consistent in every CMSIS-RTOS.
 */
-osStatus osMutexDelete (osMutexId mutex_id)
+osStatus osSemaphoreDelete (osSemaphoreId semaphore_id)
 {
   if (inHandlerMode()) {
     return osErrorISR;
   }
 
-  vQueueDelete(mutex_id);
+  if (semaphore_id == NULL) {
+    return osErrorParameter;
+  }
+
+  /* As with queue based semaphores, no thread may be waiting. */
+  configASSERT(semaphore_id->waiters == NULL);
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+  if (semaphore_id->isStatic == 0) {
+    vPortFree(semaphore_id);
+  }
+#endif
 
   return osOK;
 }
 
-/********************  Semaphore Management Functions **************************/
-
-#if (defined (osFeature_Semaphore)  &&  (osFeature_Semaphore != 0))
+#else /* configUSE_CMSIS_FAST_SEMAPHORES */
 
 /**
 * @brief Create and Initialize a Semaphore object used for managing resources
@@ -779,8 +1328,10 @@ osSemaphoreId osSemaphoreCreate (const osSemaphoreDef_t *semaphore_def, int32_t
 int32_t osSemaphoreWait (osSemaphoreId semaphore_id, uint32_t millisec)
 {
   TickType_t ticks;
-  portBASE_TYPE taskWoken = pdFALSE;  
   
+  if (inHandlerMode()) {
+    return osSemaphoreWaitFromISR(semaphore_id);
+  }
   
   if (semaphore_id == NULL) {
     return osErrorParameter;
@@ -797,19 +1348,35 @@ int32_t osSemaphoreWait (osSemaphoreId semaphore_id, uint32_t millisec)
     }
   }
   
-  if (inHandlerMode()) {
-    if (xSemaphoreTakeFromISR(semaphore_id, &taskWoken) != pdTRUE) {
-      return osErrorOS;
-    }
-	portEND_SWITCHING_ISR(taskWoken);
-  }  
-  else if (xSemaphoreTake(semaphore_id, ticks) != pdTRUE) {
+  if (xSemaphoreTake(semaphore_id, ticks) != pdTRUE) {
     return osErrorOS;
   }
   
   return osOK;
 }
 
+/**
+* @brief Take a Semaphore token, if one is available, from an interrupt service routine
+* @param  semaphore_id  semaphore object referenced with \ref osSemaphore.
+* @retval  status code that indicates the execution status of the function.
+* @note   Like \ref osSemaphoreWait with no time-out, without the check for the calling context.
+*/
+int32_t osSemaphoreWaitFromISR (osSemaphoreId semaphore_id)
+{
+  portBASE_TYPE taskWoken = pdFALSE;
+
+  if (semaphore_id == NULL) {
+    return osErrorParameter;
+  }
+
+  if (xSemaphoreTakeFromISR(semaphore_id, &taskWoken) != pdTRUE) {
+    return osErrorOS;
+  }
+  portEND_SWITCHING_ISR(taskWoken);
+
+  return osOK;
+}
+
 /**
 * @brief Release a Semaphore token
 * @param  semaphore_id  semaphore object referenced with \ref osSemaphore.
@@ -819,24 +1386,36 @@ int32_t osSemaphoreWait (osSemaphoreId semaphore_id, uint32_t millisec)
 osStatus osSemaphoreRelease (osSemaphoreId semaphore_id)
 {
   osStatus result = osOK;
-  portBASE_TYPE taskWoken = pdFALSE;
-  
   
   if (inHandlerMode()) {
-    if (xSemaphoreGiveFromISR(semaphore_id, &taskWoken) != pdTRUE) {
-      return osErrorOS;
-    }
-    portEND_SWITCHING_ISR(taskWoken);
+    return osSemaphoreReleaseFromISR(semaphore_id);
   }
-  else {
-    if (xSemaphoreGive(semaphore_id) != pdTRUE) {
-      result = osErrorOS;
-    }
+  
+  if (xSemaphoreGive(semaphore_id) != pdTRUE) {
+    result = osErrorOS;
   }
   
   return result;
 }
 
+/**
+* @brief Release a Semaphore token from an interrupt service routine
+* @param  semaphore_id  semaphore object referenced with \ref osSemaphore.
+* @retval  status code that indicates the execution status of the function.
+* @note   Like \ref osSemaphoreRelease without the check for the calling context.
+*/
+osStatus osSemaphoreReleaseFromISR (osSemaphoreId semaphore_id)
+{
+  portBASE_TYPE taskWoken = pdFALSE;
+
+  if (xSemaphoreGiveFromISR(semaphore_id, &taskWoken) != pdTRUE) {
+    return osErrorOS;
+  }
+  portEND_SWITCHING_ISR(taskWoken);
+
+  return osOK;
+}
+
 /**
 * @brief Delete a Semaphore
 * @param  semaphore_id  semaphore object referenced with \ref osSemaphore.
@@ -854,6 +1433,8 @@ osStatus osSemaphoreDelete (osSemaphoreId semaphore_id)
   return osOK; 
 }
 
+#endif /* configUSE_CMSIS_FAST_SEMAPHORES */
+
 #endif    /* Use Semaphores */
 
 /*******************   Memory Pool Management Functions  ***********************/
@@ -927,26 +1508,13 @@ osPoolId osPoolCreate (const osPoolDef_t *pool_def)
 #endif
 }
 
-/**
-* @brief Allocate a memory block from a memory pool
-* @param pool_id       memory pool ID obtain referenced with \ref osPoolCreate.
-* @retval  address of the allocated memory block or NULL in case of no memory available.
-* @note   MUST REMAIN UNCHANGED: \b osPoolAlloc shall be consistent in every CMSIS-RTOS.
-*/
-void *osPoolAlloc (osPoolId pool_id)
+/* Find and mark a free block.  Called with interrupts masked. */
+static void *osPoolTake (osPoolId pool_id)
 {
-  int dummy = 0;
   void *p = NULL;
   uint32_t i;
   uint32_t index;
   
-  if (inHandlerMode()) {
-    dummy = portSET_INTERRUPT_MASK_FROM_ISR();
-  }
-  else {
-    vPortEnterCritical();
-  }
-  
   for (i = 0; i < pool_id->pool_sz; i++) {
     index = (pool_id->currentIndex + i) % pool_id->pool_sz;
     
@@ -958,13 +1526,45 @@ void *osPoolAlloc (osPoolId pool_id)
     }
   }
   
+  return p;
+}
+
+/**
+* @brief Allocate a memory block from a memory pool
+* @param pool_id       memory pool ID obtain referenced with \ref osPoolCreate.
+* @retval  address of the allocated memory block or NULL in case of no memory available.
+* @note   MUST REMAIN UNCHANGED: \b osPoolAlloc shall be consistent in every CMSIS-RTOS.
+*/
+void *osPoolAlloc (osPoolId pool_id)
+{
+  void *p;
+  
   if (inHandlerMode()) {
-    portCLEAR_INTERRUPT_MASK_FROM_ISR(dummy);
-  }
-  else {
-    vPortExitCritical();
+    return osPoolAllocFromISR(pool_id);
   }
   
+  vPortEnterCritical();
+  p = osPoolTake(pool_id);
+  vPortExitCritical();
+  
+  return p;
+}
+
+/**
+* @brief Allocate a memory block from a memory pool from an interrupt service routine
+* @param pool_id       memory pool ID obtain referenced with \ref osPoolCreate.
+* @retval  address of the allocated memory block or NULL in case of no memory available.
+* @note   Like \ref osPoolAlloc without the check for the calling context.
+*/
+void *osPoolAllocFromISR (osPoolId pool_id)
+{
+  UBaseType_t uxSavedInterruptStatus;
+  void *p;
+
+  uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+  p = osPoolTake(pool_id);
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
   return p;
 }
 
@@ -1066,29 +1666,43 @@ osMessageQId osMessageCreate (const osMessageQDef_t *queue_def, osThreadId threa
 */
 osStatus osMessagePut (osMessageQId queue_id, uint32_t info, uint32_t millisec)
 {
-  portBASE_TYPE taskWoken = pdFALSE;
   TickType_t ticks;
   
+  if (inHandlerMode()) {
+    return osMessagePutFromISR(queue_id, info);
+  }
+  
   ticks = millisec / portTICK_PERIOD_MS;
   if (ticks == 0) {
     ticks = 1;
   }
   
-  if (inHandlerMode()) {
-    if (xQueueSendFromISR(queue_id, &info, &taskWoken) != pdTRUE) {
-      return osErrorOS;
-    }
-    portEND_SWITCHING_ISR(taskWoken);
-  }
-  else {
-    if (xQueueSend(queue_id, &info, ticks) != pdTRUE) {
-      return osErrorOS;
-    }
+  if (xQueueSend(queue_id, &info, ticks) != pdTRUE) {
+    return osErrorOS;
   }
   
   return osOK;
 }
 
+/**
+* @brief Put a Message to a Queue from an interrupt service routine.
+* @param  queue_id  message queue ID obtained with \ref osMessageCreate.
+* @param  info      message information.
+* @retval status code that indicates the execution status of the function.
+* @note   Like \ref osMessagePut without the check for the calling context.
+*/
+osStatus osMessagePutFromISR (osMessageQId queue_id, uint32_t info)
+{
+  portBASE_TYPE taskWoken = pdFALSE;
+
+  if (xQueueSendFromISR(queue_id, &info, &taskWoken) != pdTRUE) {
+    return osErrorOS;
+  }
+  portEND_SWITCHING_ISR(taskWoken);
+
+  return osOK;
+}
+
 /**
 * @brief Get a Message or Wait for a Message from a Queue.
 * @param  queue_id  message queue ID obtained with \ref osMessageCreate.
@@ -1098,10 +1712,13 @@ osStatus osMessagePut (osMessageQId queue_id, uint32_t info, uint32_t millisec)
 */
 osEvent osMessageGet (osMessageQId queue_id, uint32_t millisec)
 {
-  portBASE_TYPE taskWoken;
   TickType_t ticks;
   osEvent event;
   
+  if (inHandlerMode()) {
+    return osMessageGetFromISR(queue_id);
+  }
+  
   event.def.message_id = queue_id;
   event.value.v = 0;
   
@@ -1110,8 +1727,6 @@ osEvent osMessageGet (osMessageQId queue_id, uint32_t millisec)
     return event;
   }
   
-  taskWoken = pdFALSE;
-  
   ticks = 0;
   if (millisec == osWaitForever) {
     ticks = portMAX_DELAY;
@@ -1122,41 +1737,152 @@ osEvent osMessageGet (osMessageQId queue_id, uint32_t millisec)
       ticks = 1;
     }
   }
-  
-  if (inHandlerMode()) {
-    if (xQueueReceiveFromISR(queue_id, &event.value.v, &taskWoken) == pdTRUE) {
-      /* We have mail */
-      event.status = osEventMessage;
-    }
-    else {
-      event.status = osOK;
-    }
-    portEND_SWITCHING_ISR(taskWoken);
-  }
-  else {
-    if (xQueueReceive(queue_id, &event.value.v, ticks) == pdTRUE) {
-      /* We have mail */
-      event.status = osEventMessage;
-    }
-    else {
-      event.status = (ticks == 0) ? osOK : osEventTimeout;
-    }
+  
+  if (xQueueReceive(queue_id, &event.value.v, ticks) == pdTRUE) {
+    /* We have mail */
+    event.status = osEventMessage;
+  }
+  else {
+    event.status = (ticks == 0) ? osOK : osEventTimeout;
+  }
+  
+  return event;
+}
+
+/**
+* @brief Get a Message from a Queue, if one is available, from an interrupt service routine.
+* @param  queue_id  message queue ID obtained with \ref osMessageCreate.
+* @retval event information that includes status code.
+* @note   Like \ref osMessageGet with no time-out, without the check for the calling context.
+*/
+osEvent osMessageGetFromISR (osMessageQId queue_id)
+{
+  portBASE_TYPE taskWoken = pdFALSE;
+  osEvent event;
+
+  event.def.message_id = queue_id;
+  event.value.v = 0;
+
+  if (queue_id == NULL) {
+    event.status = osErrorParameter;
+    return event;
+  }
+
+  if (xQueueReceiveFromISR(queue_id, &event.value.v, &taskWoken) == pdTRUE) {
+    /* We have mail */
+    event.status = osEventMessage;
+  }
+  else {
+    event.status = osOK;
+  }
+  portEND_SWITCHING_ISR(taskWoken);
+
+  return event;
+}
+
+#endif     /* Use Message Queues */
+
+/********************   Mail Queue Management Functions  ***********************/
+#if (defined (osFeature_MailQ)  &&  (osFeature_MailQ != 0))  /* Use Mail Queues */
+
+
+/* A mail queue is one allocation: the control block followed by its blocks.
+   Every block starts with a header linking it into the free list or, once
+   put, into the FIFO of posted mail, so each operation is O(1) under a single
+   short critical section.  The header also records which of the two lists
+   the block is on, or that a thread holds it, so that freeing or putting a
+   block the caller does not hold is refused rather than linking it twice.  Threads waiting for a free block or for mail are
+   queued on the control block and handed a block directly, as fast
+   semaphores hand over tokens.  Without configUSE_TASK_NOTIFICATIONS
+   osMailAlloc and osMailGet do not wait. */
+
+typedef struct os_mail_block {
+  struct os_mail_block *next;
+  uint32_t state;                     ///< osMailBlockFree, osMailBlockHeld or osMailBlockQueued
+} os_mail_block_t;
+
+#define osMailBlockFree     0U        ///< on the free list
+#define osMailBlockHeld     1U        ///< returned by osMailAlloc or osMailGet
+#define osMailBlockQueued   2U        ///< put, and waiting for osMailGet
+
+/* Header size, keeping the mail after it as aligned as heap memory. */
+#define osMailHeaderSize \
+  ((sizeof(os_mail_block_t) + portBYTE_ALIGNMENT_MASK) & ~((size_t)portBYTE_ALIGNMENT_MASK))
+
+#define osMailToBlock(mail)   ((os_mail_block_t *)((uint8_t *)(mail) - osMailHeaderSize))
+#define osBlockToMail(block)  ((void *)((uint8_t *)(block) + osMailHeaderSize))
+
+typedef struct os_mailQ_cb {
+  const osMailQDef_t *queue_def;
+  os_mail_block_t *free;              ///< blocks available to osMailAlloc
+  os_mail_block_t *head;              ///< oldest mail put, next for osMailGet
+  os_mail_block_t *tail;              ///< newest mail put
+  uint8_t *blocks;                    ///< first block
+  uint32_t block_sz;                  ///< header plus mail, rounded to alignment
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  os_waiter_t *allocWaiters;          ///< threads in osMailAlloc, highest priority first
+  os_waiter_t *getWaiters;            ///< threads in osMailGet, highest priority first
+#endif
+} os_mailQ_cb_t;
+
+/* Convert a CMSIS timeout in milliseconds to ticks */
+static TickType_t osMailTicks (uint32_t millisec)
+{
+  TickType_t ticks = 0;
+
+  if (millisec == osWaitForever) {
+    ticks = portMAX_DELAY;
+  }
+  else if (millisec != 0) {
+    ticks = millisec / portTICK_PERIOD_MS;
+    if (ticks == 0) {
+      ticks = 1;
+    }
+  }
+
+  return ticks;
+}
+
+/* Whether mail is the start of one of the blocks of queue_id.  Whether the
+   caller holds it is checked from its state, in the critical section that
+   changes the state. */
+static int osMailIsBlock (osMailQId queue_id, void *mail)
+{
+  uint8_t *block = (uint8_t *)mail - osMailHeaderSize;
+  uint32_t offset;
+
+  if (((uint8_t *)mail < queue_id->blocks + osMailHeaderSize)) {
+    return 0;
   }
-  
-  return event;
+
+  offset = (uint32_t)(block - queue_id->blocks);
+
+  return ((offset % queue_id->block_sz) == 0U) &&
+         ((offset / queue_id->block_sz) < queue_id->queue_def->queue_sz);
 }
 
-#endif     /* Use Message Queues */
+/* Block until a free block or a mail is handed over through list, on which
+   the caller queued waiter inside the critical section that found none. */
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+static void *osMailWait (os_waiter_t **list, os_waiter_t *waiter, TickType_t ticks)
+{
+  uint32_t signals;
+  void *mail;
 
-/********************   Mail Queue Management Functions  ***********************/
-#if (defined (osFeature_MailQ)  &&  (osFeature_MailQ != 0))  /* Use Mail Queues */
+  signals = osWaiterSleep(waiter, ticks);
 
+  taskENTER_CRITICAL();
+  if (waiter->released == 0) {
+    osWaiterRemove(list, waiter);
+  }
+  mail = waiter->item;
+  taskEXIT_CRITICAL();
 
-typedef struct os_mailQ_cb {
-  const osMailQDef_t *queue_def;
-  QueueHandle_t handle;
-  osPoolId pool;
-} os_mailQ_cb_t;
+  osWaiterFinish(waiter, signals);
+
+  return mail;
+}
+#endif
 
 /**
 * @brief Create and Initialize mail queue
@@ -1168,42 +1894,110 @@ typedef struct os_mailQ_cb {
 osMailQId osMailCreate (const osMailQDef_t *queue_def, osThreadId thread_id)
 {
 #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
-  (void) thread_id;
-  
-  osPoolDef_t pool_def = {queue_def->queue_sz, queue_def->item_sz, NULL};
-  
-  /* Create a mail queue control block */
+  os_mailQ_cb_t *mail;
+  os_mail_block_t *block;
+  uint32_t cb_sz;
+  uint32_t block_sz;
+  uint32_t i;
 
-  *(queue_def->cb) = pvPortMalloc(sizeof(struct os_mailQ_cb));
+  (void) thread_id;
 
-  if (*(queue_def->cb) == NULL) {
+  if ((queue_def->queue_sz == 0) || (queue_def->item_sz == 0)) {
     return NULL;
   }
-  (*(queue_def->cb))->queue_def = queue_def;
-  
-  /* Create a queue in FreeRTOS */
-  (*(queue_def->cb))->handle = xQueueCreate(queue_def->queue_sz, sizeof(void *));
 
+  cb_sz = (sizeof(os_mailQ_cb_t) + portBYTE_ALIGNMENT_MASK) & ~((uint32_t)portBYTE_ALIGNMENT_MASK);
+  block_sz = (osMailHeaderSize + queue_def->item_sz + portBYTE_ALIGNMENT_MASK) & ~((uint32_t)portBYTE_ALIGNMENT_MASK);
+
+  /* Create the control block and the blocks together */
+  mail = pvPortMalloc(cb_sz + (queue_def->queue_sz * block_sz));
 
-  if ((*(queue_def->cb))->handle == NULL) {
-    vPortFree(*(queue_def->cb));
+  if (mail == NULL) {
     return NULL;
   }
-  
-  /* Create a mail pool */
-  (*(queue_def->cb))->pool = osPoolCreate(&pool_def);
-  if ((*(queue_def->cb))->pool == NULL) {
-    //TODO: Delete queue. How to do it in FreeRTOS?
-    vPortFree(*(queue_def->cb));
-    return NULL;
+
+  mail->queue_def = queue_def;
+  mail->blocks = (uint8_t *)mail + cb_sz;
+  mail->block_sz = block_sz;
+  mail->head = NULL;
+  mail->tail = NULL;
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  mail->allocWaiters = NULL;
+  mail->getWaiters = NULL;
+#endif
+
+  /* Chain every block onto the free list, first block first */
+  mail->free = NULL;
+  for (i = queue_def->queue_sz; i > 0; i--) {
+    block = (os_mail_block_t *)(mail->blocks + ((i - 1) * block_sz));
+    block->state = osMailBlockFree;
+    block->next = mail->free;
+    mail->free = block;
   }
-  
-  return *(queue_def->cb);
+
+  *(queue_def->cb) = mail;
+
+  return mail;
 #else
+  (void) queue_def;
+  (void) thread_id;
+
   return NULL;
 #endif
 }
 
+/* Append a block to the queued mail.  Called with interrupts masked. */
+static void osMailPush (osMailQId queue_id, os_mail_block_t *block)
+{
+  block->state = osMailBlockQueued;
+  block->next = NULL;
+  if (queue_id->tail != NULL) {
+    queue_id->tail->next = block;
+  }
+  else {
+    queue_id->head = block;
+  }
+  queue_id->tail = block;
+}
+
+/* Remove the oldest block from the queued mail, if any.  Called with
+   interrupts masked. */
+static os_mail_block_t *osMailPop (osMailQId queue_id)
+{
+  os_mail_block_t *block = queue_id->head;
+
+  if (block != NULL) {
+    queue_id->head = block->next;
+    if (queue_id->head == NULL) {
+      queue_id->tail = NULL;
+    }
+    block->state = osMailBlockHeld;
+  }
+
+  return block;
+}
+
+/* Take a block from the free list, if any.  Called with interrupts masked. */
+static os_mail_block_t *osMailTakeFree (osMailQId queue_id)
+{
+  os_mail_block_t *block = queue_id->free;
+
+  if (block != NULL) {
+    queue_id->free = block->next;
+    block->state = osMailBlockHeld;
+  }
+
+  return block;
+}
+
+/* Return a block to the free list.  Called with interrupts masked. */
+static void osMailGiveFree (osMailQId queue_id, os_mail_block_t *block)
+{
+  block->state = osMailBlockFree;
+  block->next = queue_id->free;
+  queue_id->free = block;
+}
+
 /**
 * @brief Allocate a memory block from a mail
 * @param  queue_id      mail queue ID obtained with \ref osMailCreate.
@@ -1213,17 +2007,69 @@ osMailQId osMailCreate (const osMailQDef_t *queue_def, osThreadId thread_id)
 */
 void *osMailAlloc (osMailQId queue_id, uint32_t millisec)
 {
+  os_mail_block_t *block;
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  TickType_t ticks;
+  os_waiter_t waiter;
+#else
   (void) millisec;
-  void *p;
-  
-  
+#endif
+
+  if (inHandlerMode()) {
+    return osMailAllocFromISR(queue_id);
+  }
+
   if (queue_id == NULL) {
     return NULL;
   }
-  
-  p = osPoolAlloc(queue_id->pool);
-  
-  return p;
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  ticks = osMailTicks(millisec);
+#endif
+
+  taskENTER_CRITICAL();
+  block = osMailTakeFree(queue_id);
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  if ((block == NULL) && (ticks != 0)) {
+    osWaiterEnqueue(&queue_id->allocWaiters, &waiter);
+  }
+#endif
+  taskEXIT_CRITICAL();
+
+  if (block != NULL) {
+    return osBlockToMail(block);
+  }
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  if (ticks != 0) {
+    /* osMailFree hands the block over as mail, not as a block. */
+    return osMailWait(&queue_id->allocWaiters, &waiter, ticks);
+  }
+#endif
+
+  return NULL;
+}
+
+/**
+* @brief Allocate a memory block from a mail from an interrupt service routine
+* @param  queue_id      mail queue ID obtained with \ref osMailCreate.
+* @retval pointer to memory block that can be filled with mail or NULL in case error.
+* @note   Like \ref osMailAlloc with no time-out, without the check for the calling context.
+*/
+void *osMailAllocFromISR (osMailQId queue_id)
+{
+  os_mail_block_t *block;
+  UBaseType_t uxSavedInterruptStatus;
+
+  if (queue_id == NULL) {
+    return NULL;
+  }
+
+  uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+  block = osMailTakeFree(queue_id);
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+  return (block != NULL) ? osBlockToMail(block) : NULL;
 }
 
 /**
@@ -1251,33 +2097,74 @@ void *osMailCAlloc (osMailQId queue_id, uint32_t millisec)
 * @brief Put a mail to a queue
 * @param  queue_id      mail queue ID obtained with \ref osMailCreate.
 * @param  mail          memory block previously allocated with \ref osMailAlloc or \ref osMailCAlloc.
-* @retval status code that indicates the execution status of the function.
+* @retval status code that indicates the execution status of the function,
+*         osErrorParameter if mail has already been put or freed.
 * @note   MUST REMAIN UNCHANGED: \b osMailPut shall be consistent in every CMSIS-RTOS.
 */
 osStatus osMailPut (osMailQId queue_id, void *mail)
 {
-  portBASE_TYPE taskWoken;
-  
-  
-  if (queue_id == NULL) {
+  osStatus status = osOK;
+
+  if (inHandlerMode()) {
+    return osMailPutFromISR(queue_id, mail);
+  }
+
+  if ((queue_id == NULL) || (mail == NULL) || !osMailIsBlock(queue_id, mail)) {
     return osErrorParameter;
   }
-  
-  taskWoken = pdFALSE;
-  
-  if (inHandlerMode()) {
-    if (xQueueSendFromISR(queue_id->handle, &mail, &taskWoken) != pdTRUE) {
-      return osErrorOS;
-    }
-    portEND_SWITCHING_ISR(taskWoken);
+
+  taskENTER_CRITICAL();
+  if (osMailToBlock(mail)->state != osMailBlockHeld) {
+    /* Already put, or freed. */
+    status = osErrorParameter;
+  }
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  else if (queue_id->getWaiters != NULL) {
+    /* Nothing is queued while a thread waits, so it can have this one. */
+    xTaskNotifyIndexed(osWaiterRelease(&queue_id->getWaiters, mail), osWaiterNotifyIndex, osWaiterWakeFlag, eSetBits);
   }
+#endif
   else {
-    if (xQueueSend(queue_id->handle, &mail, 0) != pdTRUE) { 
-      return osErrorOS;
-    }
+    osMailPush(queue_id, osMailToBlock(mail));
   }
-  
-  return osOK;
+  taskEXIT_CRITICAL();
+
+  return status;
+}
+
+/**
+* @brief Put a mail to a queue from an interrupt service routine
+* @param  queue_id      mail queue ID obtained with \ref osMailCreate.
+* @param  mail          memory block previously allocated with \ref osMailAlloc or \ref osMailCAlloc.
+* @retval status code that indicates the execution status of the function.
+* @note   Like \ref osMailPut without the check for the calling context.
+*/
+osStatus osMailPutFromISR (osMailQId queue_id, void *mail)
+{
+  osStatus status = osOK;
+  portBASE_TYPE taskWoken = pdFALSE;
+  UBaseType_t uxSavedInterruptStatus;
+
+  if ((queue_id == NULL) || (mail == NULL) || !osMailIsBlock(queue_id, mail)) {
+    return osErrorParameter;
+  }
+
+  uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+  if (osMailToBlock(mail)->state != osMailBlockHeld) {
+    status = osErrorParameter;
+  }
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  else if (queue_id->getWaiters != NULL) {
+    xTaskNotifyIndexedFromISR(osWaiterRelease(&queue_id->getWaiters, mail), osWaiterNotifyIndex, osWaiterWakeFlag, eSetBits, &taskWoken);
+  }
+#endif
+  else {
+    osMailPush(queue_id, osMailToBlock(mail));
+  }
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+  portEND_SWITCHING_ISR(taskWoken);
+
+  return status;
 }
 
 /**
@@ -1289,50 +2176,89 @@ osStatus osMailPut (osMailQId queue_id, void *mail)
 */
 osEvent osMailGet (osMailQId queue_id, uint32_t millisec)
 {
-  portBASE_TYPE taskWoken;
+  os_mail_block_t *block;
   TickType_t ticks;
   osEvent event;
-  
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  os_waiter_t waiter;
+#endif
+
+  if (inHandlerMode()) {
+    return osMailGetFromISR(queue_id);
+  }
+
   event.def.mail_id = queue_id;
-  
+  event.value.p = NULL;
+
   if (queue_id == NULL) {
     event.status = osErrorParameter;
     return event;
   }
-  
-  taskWoken = pdFALSE;
-  
-  ticks = 0;
-  if (millisec == osWaitForever) {
-    ticks = portMAX_DELAY;
+
+  ticks = osMailTicks(millisec);
+
+  taskENTER_CRITICAL();
+  block = osMailPop(queue_id);
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  if ((block == NULL) && (ticks != 0)) {
+    osWaiterEnqueue(&queue_id->getWaiters, &waiter);
   }
-  else if (millisec != 0) {
-    ticks = millisec / portTICK_PERIOD_MS;
-    if (ticks == 0) {
-      ticks = 1;
-    }
+#endif
+  taskEXIT_CRITICAL();
+
+  if (block != NULL) {
+    event.value.p = osBlockToMail(block);
   }
-  
-  if (inHandlerMode()) {
-    if (xQueueReceiveFromISR(queue_id->handle, &event.value.p, &taskWoken) == pdTRUE) {
-      /* We have mail */
-      event.status = osEventMail;
-    }
-    else {
-      event.status = osOK;
-    }
-    portEND_SWITCHING_ISR(taskWoken);
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  else if (ticks != 0) {
+    event.value.p = osMailWait(&queue_id->getWaiters, &waiter, ticks);
+  }
+#endif
+
+  if (event.value.p != NULL) {
+    /* We have mail */
+    event.status = osEventMail;
   }
   else {
-    if (xQueueReceive(queue_id->handle, &event.value.p, ticks) == pdTRUE) {
-      /* We have mail */
-      event.status = osEventMail;
-    }
-    else {
-      event.status = (ticks == 0) ? osOK : osEventTimeout;
-    }
+    event.status = (ticks == 0) ? osOK : osEventTimeout;
   }
-  
+
+  return event;
+}
+
+/**
+* @brief Get a mail from a queue, if one is available, from an interrupt service routine
+* @param  queue_id   mail queue ID obtained with \ref osMailCreate.
+* @retval event that contains mail information or error code.
+* @note   Like \ref osMailGet with no time-out, without the check for the calling context.
+*/
+osEvent osMailGetFromISR (osMailQId queue_id)
+{
+  os_mail_block_t *block;
+  UBaseType_t uxSavedInterruptStatus;
+  osEvent event;
+
+  event.def.mail_id = queue_id;
+  event.value.p = NULL;
+
+  if (queue_id == NULL) {
+    event.status = osErrorParameter;
+    return event;
+  }
+
+  uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+  block = osMailPop(queue_id);
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+  if (block != NULL) {
+    /* We have mail */
+    event.value.p = osBlockToMail(block);
+    event.status = osEventMail;
+  }
+  else {
+    event.status = osOK;
+  }
+
   return event;
 }
 
@@ -1340,16 +2266,80 @@ osEvent osMailGet (osMailQId queue_id, uint32_t millisec)
 * @brief Free a memory block from a mail
 * @param  queue_id mail queue ID obtained with \ref osMailCreate.
 * @param  mail     pointer to the memory block that was obtained with \ref osMailGet.
-* @retval status code that indicates the execution status of the function.
+* @retval status code that indicates the execution status of the function,
+*         osErrorParameter if mail has already been freed, or put and not got.
 * @note   MUST REMAIN UNCHANGED: \b osMailFree shall be consistent in every CMSIS-RTOS.
 */
 osStatus osMailFree (osMailQId queue_id, void *mail)
 {
-  if (queue_id == NULL) {
+  os_mail_block_t *block;
+  osStatus status = osOK;
+
+  if (inHandlerMode()) {
+    return osMailFreeFromISR(queue_id, mail);
+  }
+
+  if ((queue_id == NULL) || (mail == NULL) || !osMailIsBlock(queue_id, mail)) {
     return osErrorParameter;
   }
-  
-  return osPoolFree(queue_id->pool, mail);
+
+  block = osMailToBlock(mail);
+
+  taskENTER_CRITICAL();
+  if (block->state != osMailBlockHeld) {
+    /* Already freed, or put and not yet got. */
+    status = osErrorParameter;
+  }
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  else if (queue_id->allocWaiters != NULL) {
+    /* The free list is empty while a thread waits, so it can have this one. */
+    xTaskNotifyIndexed(osWaiterRelease(&queue_id->allocWaiters, mail), osWaiterNotifyIndex, osWaiterWakeFlag, eSetBits);
+  }
+#endif
+  else {
+    osMailGiveFree(queue_id, block);
+  }
+  taskEXIT_CRITICAL();
+
+  return status;
+}
+
+/**
+* @brief Free a memory block from a mail from an interrupt service routine
+* @param  queue_id mail queue ID obtained with \ref osMailCreate.
+* @param  mail     pointer to the memory block that was obtained with \ref osMailGet.
+* @retval status code that indicates the execution status of the function.
+* @note   Like \ref osMailFree without the check for the calling context.
+*/
+osStatus osMailFreeFromISR (osMailQId queue_id, void *mail)
+{
+  os_mail_block_t *block;
+  osStatus status = osOK;
+  portBASE_TYPE taskWoken = pdFALSE;
+  UBaseType_t uxSavedInterruptStatus;
+
+  if ((queue_id == NULL) || (mail == NULL) || !osMailIsBlock(queue_id, mail)) {
+    return osErrorParameter;
+  }
+
+  block = osMailToBlock(mail);
+
+  uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+  if (block->state != osMailBlockHeld) {
+    status = osErrorParameter;
+  }
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+  else if (queue_id->allocWaiters != NULL) {
+    xTaskNotifyIndexedFromISR(osWaiterRelease(&queue_id->allocWaiters, mail), osWaiterNotifyIndex, osWaiterWakeFlag, eSetBits, &taskWoken);
+  }
+#endif
+  else {
+    osMailGiveFree(queue_id, block);
+  }
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+  portEND_SWITCHING_ISR(taskWoken);
+
+  return status;
 }
 #endif  /* Use Mail Queues */
 
@@ -1723,5 +2713,11 @@ osStatus osRecursiveMutexWait (osMutexId mutex_id, uint32_t millisec)
 */
 uint32_t osSemaphoreGetCount(osSemaphoreId semaphore_id)
 {
+#if (configUSE_CMSIS_FAST_SEMAPHORES == 1)
+  int32_t count = semaphore_id->count;
+
+  return (count > 0) ? (uint32_t)count : 0U;
+#else
   return uxSemaphoreGetCount(semaphore_id);
+#endif
 }
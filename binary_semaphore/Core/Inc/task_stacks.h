@@ -0,0 +1,21 @@
+/* Generated by tools/stack_analyzer.py from the -fstack-usage output and the
+ * call graph of the linked image.  Do not edit: the file is rewritten by every
+ * build whose worst case stack usage changed.
+ *
+ * Each size is the deepest call chain of the task, plus 204 bytes for the
+ * port to save the task context and a 32 byte margin, in words.
+ */
+
+#ifndef TASK_STACKS_H
+#define TASK_STACKS_H
+
+/* Startnormal: 192 bytes, Startnormal -> HAL_UART_Transmit -> UART_WaitOnFlagUntilTimeout -> UART_EndRxTransfer */
+#define TASK_STACK_WORDS_Startnormal 108
+
+/* Starthightask: 208 bytes, Starthightask -> osSemaphoreRelease -> xQueueGenericSend -> prvCopyDataToQueue -> xTaskPriorityDisinherit -> uxListRemove */
+#define TASK_STACK_WORDS_Starthightask 112
+
+/* Startlowtask: 208 bytes, Startlowtask -> osSemaphoreRelease -> xQueueGenericSend -> prvCopyDataToQueue -> xTaskPriorityDisinherit -> uxListRemove */
+#define TASK_STACK_WORDS_Startlowtask 112
+
+#endif /* TASK_STACKS_H */
@@ -22,6 +22,8 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "task_stacks.h"
+#include "clock_profile.h"
 
 /* USER CODE END Includes */
 
@@ -268,6 +270,33 @@ static void MX_GPIO_Init(void)
 
 /* USER CODE BEGIN 4 */
 
+/**
+  * @brief  Let the byte being sent on the UART finish before the bus clock
+  *         changes under it.
+  * @param  eProfile: Profile about to be switched to.
+  * @retval None
+  */
+void vClockProfileChangingHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartWaitIdle(&huart1);
+}
+
+/**
+  * @brief  Recompute the UART baud rate divider for the bus clock of the new
+  *         clock profile.  A task may be part way through
+  *         HAL_UART_Transmit(), so only BRR is rewritten.
+  * @param  eProfile: Profile now running.
+  * @retval None
+  */
+void vClockProfileChangedHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartRetune(&huart1);
+}
+
 /* USER CODE END 4 */
 
 /* USER CODE BEGIN Header_Startnormal */
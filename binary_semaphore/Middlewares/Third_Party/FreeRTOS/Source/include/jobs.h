@@ -0,0 +1,349 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Jobs are stackless, run to completion activities that all execute inside a
+ * single task, the job executor.  A job is a function written in the
+ * protothread style: it starts with jobBEGIN(), ends with jobEND(), and each
+ * of the job macros that can wait (jobDELAY(), jobWAIT_NOTIFY(),
+ * jobQUEUE_RECEIVE()...) records where the function got to and returns to
+ * the executor.  The next time the job runs it continues from that point.  A
+ * job therefore costs only its Job_t, and many jobs share the executor's
+ * stack.
+ *
+ * Jobs run in order of their priority (0 to configMAX_JOB_PRIORITIES - 1)
+ * relative to each other, and jobs of equal priority take turns.  A job is
+ * never preempted by another job, so a job must wait or yield regularly.  The
+ * executor task as a whole is scheduled by the kernel like any other task, at
+ * configJOB_EXECUTOR_TASK_PRIORITY.
+ *
+ * Because a job returns each time it waits:
+ *   + local variables do not keep their values across a job macro that can
+ *     wait - keep such state in a structure passed as the job's parameter,
+ *     or in static variables;
+ *   + the job macros can only be used in the job function itself, not in
+ *     functions it calls, and not inside a switch statement of its own.
+ *
+ * configUSE_JOB_EXECUTOR must be set to 1 in FreeRTOSConfig.h for jobs to be
+ * available.  The executor task is created when the scheduler is started.
+ */
+
+#ifndef JOBS_H
+#define JOBS_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include jobs.h"
+#endif
+
+/*lint -save -e537 This headers are only multiply included if the application code
+happens to also be including task.h. */
+#include "task.h"
+/*lint -restore */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct xJOB;
+
+/*
+ * Defines the prototype to which job functions must conform.
+ */
+typedef void (*JobFunction_t)( struct xJOB *pxJob, void *pvParameter );
+
+/* The job control block.  Allocated by the application, normally statically,
+and initialised with vJobInit().  The members are only accessed through the
+API and the job macros - the structure is in the header because the macros
+need it. */
+typedef struct xJOB
+{
+	ListItem_t xJobListItem;			/*< Places the job in a ready, delayed or polling list of the executor. */
+	JobFunction_t pxJobFunction;
+	void *pvParameter;
+	struct xJOB *pxNextPending;			/*< Links jobs started or notified from outside the executor. */
+	TickType_t xWakeTime;				/*< When a delay or wait ends. */
+	volatile uint32_t ulNotifiedValue;	/*< Bits notified but not yet received. */
+	uint32_t ulReceivedValue;			/*< Bits received by the last jobWAIT_NOTIFY(). */
+	uint16_t usResumePoint;				/*< Where the job function continues from, 0 to start from the beginning. */
+	uint8_t ucPriority;
+	volatile uint8_t ucState;
+	volatile uint8_t ucPending;			/*< pdTRUE while on the pending list. */
+	volatile uint8_t ucNotified;		/*< pdTRUE if ulNotifiedValue holds a notification. */
+	uint8_t ucWaitForever;				/*< pdTRUE if the current wait has no timeout. */
+	uint8_t ucResult;					/*< The result of the last wait. */
+} Job_t;
+
+/* Values of ucState.  Only the executor and the job itself change the state
+of a job that has been started. */
+#define jobSTATE_IDLE				( ( uint8_t ) 0U )	/* Not started, or finished. */
+#define jobSTATE_STARTING			( ( uint8_t ) 1U )	/* Started but not yet seen by the executor. */
+#define jobSTATE_READY				( ( uint8_t ) 2U )
+#define jobSTATE_DELAYED			( ( uint8_t ) 3U )
+#define jobSTATE_WAITING_NOTIFY		( ( uint8_t ) 4U )
+#define jobSTATE_POLLING			( ( uint8_t ) 5U )
+
+/*
+ * Functions beyond this part are called from the job macros and are not
+ * intended to be called directly.
+ */
+void vJobDelay( Job_t *pxJob, TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
+void vJobDelayUntil( Job_t *pxJob, TickType_t *pxPreviousWakeTime, TickType_t xTimeIncrement ) PRIVILEGED_FUNCTION;
+void vJobWaitNotify( Job_t *pxJob, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+void vJobBeginPoll( Job_t *pxJob, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xJobPollContinue( Job_t *pxJob ) PRIVILEGED_FUNCTION;
+
+/* Saves the point the job function has reached, returns to the executor, and
+is where the function continues from the next time the job runs. */
+#define jobWAIT_POINT( pxJob )	( pxJob )->usResumePoint = ( uint16_t ) __LINE__; return; case __LINE__:
+
+/**
+ * jobs. h
+ * <pre>jobBEGIN( Job_t *pxJob );</pre>
+ *
+ * Must be the first statement of every job function.
+ */
+#define jobBEGIN( pxJob )		switch( ( pxJob )->usResumePoint ) { case 0:
+
+/**
+ * jobs. h
+ * <pre>jobEND( Job_t *pxJob );</pre>
+ *
+ * Must be the last statement of every job function.  A job that reaches
+ * jobEND() has finished, and can be started again with xJobStart().
+ */
+#define jobEND( pxJob )			default: break; } ( pxJob )->usResumePoint = 0U; ( pxJob )->ucState = jobSTATE_IDLE
+
+/**
+ * jobs. h
+ * <pre>jobYIELD( Job_t *pxJob );</pre>
+ *
+ * Lets the other ready jobs of the same priority run before continuing.
+ */
+#define jobYIELD( pxJob )		jobWAIT_POINT( pxJob )
+
+/**
+ * jobs. h
+ * <pre>jobDELAY( Job_t *pxJob, TickType_t xTicksToDelay );</pre>
+ *
+ * Delays the job for xTicksToDelay ticks, relative to when it is called.  A
+ * delay of 0 is the same as jobYIELD().
+ */
+#define jobDELAY( pxJob, xTicksToDelay )													\
+	vJobDelay( ( pxJob ), ( xTicksToDelay ) );												\
+	jobWAIT_POINT( pxJob )
+
+/**
+ * jobs. h
+ * <pre>jobDELAY_UNTIL( Job_t *pxJob, TickType_t *pxPreviousWakeTime, TickType_t xTimeIncrement );</pre>
+ *
+ * Delays the job until *pxPreviousWakeTime + xTimeIncrement, then updates
+ * *pxPreviousWakeTime, in the same way as vTaskDelayUntil().  Used to run a
+ * job at a fixed frequency.  *pxPreviousWakeTime must not be a local
+ * variable.
+ */
+#define jobDELAY_UNTIL( pxJob, pxPreviousWakeTime, xTimeIncrement )							\
+	vJobDelayUntil( ( pxJob ), ( pxPreviousWakeTime ), ( xTimeIncrement ) );				\
+	jobWAIT_POINT( pxJob )
+
+/**
+ * jobs. h
+ * <pre>jobWAIT_NOTIFY( Job_t *pxJob, TickType_t xTicksToWait, uint32_t *pulNotificationValue, BaseType_t *pxResult );</pre>
+ *
+ * Waits for xJobNotify() or xJobNotifyFromISR() to be called for the job, or
+ * for xTicksToWait ticks to pass.  Notifications sent while the job was not
+ * waiting are not lost - the bits of all of them are combined and received
+ * by the next wait.
+ *
+ * @param pulNotificationValue Set to the bits received, or to 0 on a timeout.
+ *
+ * @param pxResult Set to pdPASS if a notification was received, or pdFAIL if
+ * the wait timed out.
+ */
+#define jobWAIT_NOTIFY( pxJob, xTicksToWait, pulNotificationValue, pxResult )				\
+	vJobWaitNotify( ( pxJob ), ( xTicksToWait ) );											\
+	jobWAIT_POINT( pxJob )																	\
+	*( pulNotificationValue ) = ( pxJob )->ulReceivedValue;									\
+	*( pxResult ) = ( BaseType_t ) ( pxJob )->ucResult
+
+/**
+ * jobs. h
+ * <pre>jobWAIT_UNTIL( Job_t *pxJob, xCondition, TickType_t xTicksToWait, BaseType_t *pxResult );</pre>
+ *
+ * Waits until the expression xCondition is true, or for xTicksToWait ticks to
+ * pass.  xCondition is evaluated straight away, then again at least once a
+ * tick, even while lower priority jobs are ready, and each time the executor
+ * has run all the ready jobs and is woken - by a delay ending or any job being
+ * notified.  Notifying the job that waits after making the condition true
+ * therefore gets it re-evaluated straight away if no other job is ready.
+ *
+ * @param pxResult Set to pdPASS if xCondition became true, or pdFAIL if the
+ * wait timed out.
+ */
+#define jobWAIT_UNTIL( pxJob, xCondition, xTicksToWait, pxResult )							\
+	vJobBeginPoll( ( pxJob ), ( xTicksToWait ) );											\
+	( pxJob )->usResumePoint = ( uint16_t ) __LINE__; case __LINE__:						\
+	if( ( xCondition ) )																	\
+	{																						\
+		*( pxResult ) = pdPASS;																\
+	}																						\
+	else if( xJobPollContinue( pxJob ) != pdFALSE )											\
+	{																						\
+		return;																				\
+	}																						\
+	else																					\
+	{																						\
+		*( pxResult ) = pdFAIL;																\
+	}
+
+/**
+ * jobs. h
+ * <pre>jobQUEUE_SEND( Job_t *pxJob, QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait, BaseType_t *pxResult );</pre>
+ * <pre>jobQUEUE_RECEIVE( Job_t *pxJob, QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait, BaseType_t *pxResult );</pre>
+ * <pre>jobSEMAPHORE_TAKE( Job_t *pxJob, SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait, BaseType_t *pxResult );</pre>
+ *
+ * The job equivalents of xQueueSend(), xQueueReceive() and xSemaphoreTake(),
+ * built on jobWAIT_UNTIL().  The executor task never blocks on the queue
+ * itself, so other jobs keep running while the job waits.  Giving a semaphore
+ * never blocks, so xSemaphoreGive() can be called from a job directly.
+ */
+#define jobQUEUE_SEND( pxJob, xQueue, pvItemToQueue, xTicksToWait, pxResult )				\
+	jobWAIT_UNTIL( ( pxJob ), ( xQueueSend( ( xQueue ), ( pvItemToQueue ), 0 ) == pdPASS ), ( xTicksToWait ), ( pxResult ) )
+
+#define jobQUEUE_RECEIVE( pxJob, xQueue, pvBuffer, xTicksToWait, pxResult )					\
+	jobWAIT_UNTIL( ( pxJob ), ( xQueueReceive( ( xQueue ), ( pvBuffer ), 0 ) == pdPASS ), ( xTicksToWait ), ( pxResult ) )
+
+#define jobSEMAPHORE_TAKE( pxJob, xSemaphore, xTicksToWait, pxResult )						\
+	jobWAIT_UNTIL( ( pxJob ), ( xSemaphoreTake( ( xSemaphore ), 0 ) == pdPASS ), ( xTicksToWait ), ( pxResult ) )
+
+/**
+ * jobs. h
+ * <pre>void vJobInit( Job_t *pxJob, JobFunction_t pxJobFunction, void *pvParameter, UBaseType_t uxPriority );</pre>
+ *
+ * Initialises a job control block.  Must be called before the job is started,
+ * and not while it is running.
+ *
+ * @param pxJob The job control block, which must stay in scope while the job
+ * runs.
+ *
+ * @param pxJobFunction The function that implements the job.
+ *
+ * @param pvParameter Passed to pxJobFunction each time it runs.  Normally a
+ * structure holding the state the job keeps between waits.
+ *
+ * @param uxPriority The priority of the job relative to the other jobs, less
+ * than configMAX_JOB_PRIORITIES.
+ *
+ * Example usage:
+   <pre>
+ typedef struct
+ {
+     Job_t xJob;
+     TickType_t xLastWake;
+     uint32_t ulCount;
+ } BlinkJob_t;
+
+ static BlinkJob_t xBlink;
+
+ static void prvBlinkJob( Job_t *pxJob, void *pvParameter )
+ {
+ BlinkJob_t *pxBlink = ( BlinkJob_t * ) pvParameter;
+
+     jobBEGIN( pxJob );
+
+     pxBlink->xLastWake = xTaskGetTickCount();
+
+     for( ;; )
+     {
+         vToggleLED();
+         pxBlink->ulCount++;
+
+         jobDELAY_UNTIL( pxJob, &( pxBlink->xLastWake ), pdMS_TO_TICKS( 500 ) );
+     }
+
+     jobEND( pxJob );
+ }
+
+ void vStartBlinkJob( void )
+ {
+     vJobInit( &( xBlink.xJob ), prvBlinkJob, &xBlink, 1 );
+     xJobStart( &( xBlink.xJob ) );
+ }
+   </pre>
+ * \defgroup vJobInit vJobInit
+ * \ingroup Jobs
+ */
+void vJobInit( Job_t *pxJob, JobFunction_t pxJobFunction, void *pvParameter, UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+/**
+ * jobs. h
+ * <pre>BaseType_t xJobStart( Job_t *pxJob );</pre>
+ *
+ * Makes a job that has not been started, or has finished, ready to run from
+ * the beginning of its function.  Can be called from any task, from a job,
+ * and before the scheduler is started.
+ *
+ * @return pdPASS if the job was started, or pdFAIL if it was already running.
+ */
+BaseType_t xJobStart( Job_t *pxJob ) PRIVILEGED_FUNCTION;
+
+/**
+ * jobs. h
+ * <pre>BaseType_t xJobNotify( Job_t *pxJob, uint32_t ulBits );</pre>
+ * <pre>BaseType_t xJobNotifyFromISR( Job_t *pxJob, uint32_t ulBits, BaseType_t *pxHigherPriorityTaskWoken );</pre>
+ *
+ * Sets ulBits in the job's notification value and, if the job is in
+ * jobWAIT_NOTIFY(), makes it ready to run.  Also wakes the executor so jobs in
+ * jobWAIT_UNTIL() evaluate their conditions again.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if waking the executor task
+ * unblocked a task of a higher priority than the interrupted task.  If so a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS.
+ */
+BaseType_t xJobNotify( Job_t *pxJob, uint32_t ulBits ) PRIVILEGED_FUNCTION;
+BaseType_t xJobNotifyFromISR( Job_t *pxJob, uint32_t ulBits, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * jobs. h
+ * <pre>TaskHandle_t xJobExecutorGetTaskHandle( void );</pre>
+ *
+ * Returns the handle of the job executor task, or NULL if the scheduler has
+ * not been started.
+ */
+TaskHandle_t xJobExecutorGetTaskHandle( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the kernel only.
+ */
+BaseType_t xJobExecutorCreateTask( void ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* JOBS_H */
@@ -38,6 +38,8 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
+#include "workqueue.h"
+#include "jobs.h"
 #include "stack_macros.h"
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
@@ -112,6 +114,53 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/* The ready list at configEDF_PRIORITY is held in absolute deadline order,
+	so the task to run from that list is always the one at its head.  Tasks at
+	any other priority share the processor round robin as normal. */
+	#define taskSELECT_FROM_READY_LIST( uxPriority )													\
+	{																									\
+		if( ( uxPriority ) == ( UBaseType_t ) configEDF_PRIORITY )										\
+		{																								\
+			pxCurrentTCB = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ ( uxPriority ) ] ) );	\
+		}																								\
+		else																							\
+		{																								\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) );		\
+		}																								\
+	}
+
+	/* Deadlines are compared as a signed distance so the ordering remains
+	correct when the tick count wraps, provided no two deadlines are more than
+	half the tick range apart. */
+	#define taskEDF_DEADLINE_IS_EARLIER( xA, xB ) ( ( TickType_t ) ( ( xA ) - ( xB ) ) > ( portMAX_DELAY >> 1 ) )
+
+	/* Does the task pxTCB have a deadline before that of pxOther?  A task at
+	configEDF_PRIORITY that has not registered a period has no deadline, and is
+	therefore considered later than any task that has. */
+	#define taskEDF_RUNS_BEFORE( pxTCB, pxOther )																\
+		( ( ( pxTCB )->xEDFPeriod != ( TickType_t ) 0 ) &&														\
+		  ( ( ( pxOther )->xEDFPeriod == ( TickType_t ) 0 ) ||													\
+			taskEDF_DEADLINE_IS_EARLIER( ( pxTCB )->xEDFAbsoluteDeadline, ( pxOther )->xEDFAbsoluteDeadline ) ) )
+
+	/* A task that becomes ready preempts the running task if it has a higher
+	priority or, when both are in the EDF band, an earlier deadline. */
+	#define taskTCB_PREEMPTS_CURRENT( pxTCB )																	\
+		( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||												\
+		  ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&									\
+			( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&								\
+			taskEDF_RUNS_BEFORE( ( pxTCB ), pxCurrentTCB ) ) )
+
+#else /* configUSE_EDF_SCHEDULING */
+
+	#define taskSELECT_FROM_READY_LIST( uxPriority ) listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+	#define taskTCB_PREEMPTS_CURRENT( pxTCB ) ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -141,9 +190,9 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 			--uxTopPriority;																			\
 		}																								\
 																										\
-		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
+		/* taskSELECT_FROM_READY_LIST indexes through the list, so the tasks of							\
 		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );													\
 		uxTopReadyPriority = uxTopPriority;																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -173,7 +222,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 		/* Find the highest priority list that contains ready tasks. */								\
 		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );												\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -213,13 +262,33 @@ count overflows. */
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, unless the list is the
+ * EDF band, in which case it is inserted in deadline order.
  */
-#define prvAddTaskToReadyList( pxTCB )																\
-	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
-	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
+		if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY )								\
+		{																								\
+			prvEDFInsertIntoReadyList( pxTCB );															\
+		}																								\
+		else																							\
+		{																								\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		}																								\
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+#else /* configUSE_EDF_SCHEDULING */
+
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
+		vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
 /*
@@ -293,6 +362,13 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
+	#if( configUSE_TASK_CPU_ACCOUNTING == 1 )
+		uint64_t		ullCpuTime;			/*< The time the task has spent in the Running state, extended to 64 bits so it does not wrap. */
+		uint32_t		ulLastSliceTime;	/*< The length of the task's most recent uninterrupted period in the Running state. */
+		uint32_t		ulMaxSliceTime;		/*< The longest uninterrupted period the task has spent in the Running state. */
+		uint32_t		ulPreemptions;		/*< The number of times the task was switched out while still able to run. */
+	#endif
+
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		/* Allocate a Newlib reent structure that is specific to this task.
 		Note Newlib support has been included by popular demand, but is not
@@ -308,8 +384,8 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments in FreeRTOS.h with the definition of
@@ -326,37 +402,75 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		int iTaskErrno;
 	#endif
 
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xEDFPeriod;				/*< The period of the task's jobs, or 0 if the task is not scheduled by deadline. */
+		TickType_t		xEDFRelativeDeadline;	/*< The deadline of each job relative to its release time. */
+		TickType_t		xEDFReleaseTime;		/*< The tick count at which the current job was released. */
+		TickType_t		xEDFAbsoluteDeadline;	/*< The tick count by which the current job must complete.  Orders the EDF ready list. */
+		UBaseType_t		uxEDFDeadlineMisses;	/*< The number of jobs that completed after their deadline. */
+	#endif
+
+	#if( configUSE_TASK_FPU_FLAG == 1 )
+		uint8_t			ucUsesFPU;				/*< Set to pdTRUE by vTaskUseFPU().  The FPU is only accessible while a task that has this set is running. */
+	#endif
+
+	#if( configUSE_TASK_CPU_BUDGET == 1 )
+		ListItem_t		xBudgetListItem;		/*< Used to reference the task from the list of tasks that have a CPU budget. */
+		uint32_t		ulBudget;				/*< The run time the task can use in each period, or 0 if the task has no budget. */
+		uint32_t		ulBudgetRemaining;		/*< The run time the task can still use in the current period. */
+		TickType_t		xBudgetPeriod;			/*< The budget replenishment period in ticks. */
+		TickType_t		xBudgetReplenishTime;	/*< The tick count at which the budget is next refilled. */
+		UBaseType_t		uxBudgetPriority;		/*< The priority to restore when a demoted task's budget is refilled. */
+		UBaseType_t		uxBudgetExhaustions;	/*< The number of periods in which the budget ran out. */
+		uint8_t			ucBudgetAction;			/*< The eBudgetAction applied when the budget runs out. */
+		uint8_t			ucBudgetThrottled;		/*< Set to pdTRUE while the task is demoted or suspended by its budget. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
 below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+/* The scheduler's own data, placed by configKERNEL_DATA_ATTRIBUTE. */
+#if( portUSING_MPU_WRAPPERS == 1 )
+	#define tskKERNEL_DATA	PRIVILEGED_DATA
+#else
+	#define tskKERNEL_DATA	configKERNEL_DATA_ATTRIBUTE
+#endif
+
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
-PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+tskKERNEL_DATA TCB_t * volatile pxCurrentTCB = NULL;
 
 /* Lists for ready and blocked tasks. --------------------
 xDelayedTaskList1 and xDelayedTaskList2 could be move to function scople but
 doing so breaks some kernel aware debuggers and debuggers that rely on removing
 the static qualifier. */
-PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
+tskKERNEL_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
+tskKERNEL_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
+tskKERNEL_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+tskKERNEL_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
+tskKERNEL_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+tskKERNEL_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
 
-	PRIVILEGED_DATA static List_t xTasksWaitingTermination;				/*< Tasks that have been deleted - but their memory not yet freed. */
-	PRIVILEGED_DATA static volatile UBaseType_t uxDeletedTasksWaitingCleanUp = ( UBaseType_t ) 0U;
+	tskKERNEL_DATA static List_t xTasksWaitingTermination;				/*< Tasks that have been deleted - but their memory not yet freed. */
+	tskKERNEL_DATA static volatile UBaseType_t uxDeletedTasksWaitingCleanUp = ( UBaseType_t ) 0U;
 
 #endif
 
 #if ( INCLUDE_vTaskSuspend == 1 )
 
-	PRIVILEGED_DATA static List_t xSuspendedTaskList;					/*< Tasks that are currently suspended. */
+	tskKERNEL_DATA static List_t xSuspendedTaskList;					/*< Tasks that are currently suspended. */
+
+#endif
+
+#if( configUSE_TASK_CPU_BUDGET == 1 )
+
+	tskKERNEL_DATA static List_t xBudgetedTaskList;					/*< Tasks that have a CPU budget. */
+	tskKERNEL_DATA static volatile TickType_t xNextBudgetReplenishTime = ( TickType_t ) 0U;	/*< The tick count at which the next task budget is refilled. */
 
 #endif
 
@@ -367,16 +481,21 @@ the errno of the currently running task. */
 #endif
 
 /* Other file private variables. --------------------------------*/
-PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks 	= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
-PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
-PRIVILEGED_DATA static volatile TickType_t xPendedTicks 			= ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
-PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
-PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+tskKERNEL_DATA static volatile UBaseType_t uxCurrentNumberOfTasks 	= ( UBaseType_t ) 0U;
+tskKERNEL_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) configINITIAL_TICK_COUNT;
+#ifdef portREADY_PRIORITIES_TYPE
+	/* A multi-word bit map of the ready priorities, managed by the port. */
+	tskKERNEL_DATA static volatile portREADY_PRIORITIES_TYPE uxTopReadyPriority = { 0 };
+#else
+	tskKERNEL_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
+#endif
+tskKERNEL_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
+tskKERNEL_DATA static volatile TickType_t xPendedTicks 			= ( TickType_t ) 0U;
+tskKERNEL_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
+tskKERNEL_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
+tskKERNEL_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
+tskKERNEL_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
+tskKERNEL_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
 
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
@@ -386,7 +505,7 @@ moves the task's event list item into the xPendingReadyList, ready for the
 kernel to move the task from the pending ready list into the real ready list
 when the scheduler is unsuspended.  The pending ready list itself can only be
 accessed from a critical section. */
-PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t ) pdFALSE;
+tskKERNEL_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t ) pdFALSE;
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
@@ -397,6 +516,67 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+
+	PRIVILEGED_DATA static uint64_t ullTotalCpuTime = 0ULL;		/*< The run time accumulated by all tasks, extended to 64 bits. */
+	PRIVILEGED_DATA static uint32_t ulSliceStartTime = 0UL;		/*< The run time counter value when the running task was switched in. */
+
+#endif
+
+/* Charge run time to the running task's CPU budget, and test whether a task
+has used its budget but has not yet been demoted or suspended because of it. */
+#if ( configUSE_TASK_CPU_BUDGET == 1 )
+
+	#define taskCHARGE_CPU_BUDGET( ulElapsed )												\
+	{																						\
+		if( pxCurrentTCB->ulBudgetRemaining > ( ulElapsed ) )								\
+		{																					\
+			pxCurrentTCB->ulBudgetRemaining -= ( ulElapsed );								\
+		}																					\
+		else																				\
+		{																					\
+			pxCurrentTCB->ulBudgetRemaining = 0UL;											\
+		}																					\
+	}
+
+	#define taskCPU_BUDGET_EXHAUSTED( pxTCB )												\
+		( ( ( pxTCB )->ulBudget != 0UL ) &&													\
+		  ( ( pxTCB )->ulBudgetRemaining == 0UL ) &&										\
+		  ( ( pxTCB )->ucBudgetThrottled == ( uint8_t ) pdFALSE ) )
+
+#else
+
+	#define taskCHARGE_CPU_BUDGET( ulElapsed )
+
+#endif /* configUSE_TASK_CPU_BUDGET */
+
+/* Add the run time counter ticks that have elapsed since ulTaskSwitchedInTime
+to the running task.  Unsigned subtraction gives the correct interval across a
+counter wrap, so counters that wrap frequently, such as the DWT cycle counter,
+can be used directly. */
+#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+
+	#define taskACCUMULATE_RUN_TIME( ulNow )												\
+	{																						\
+	const uint32_t ulElapsed = ( ulNow ) - ulTaskSwitchedInTime;							\
+																							\
+		pxCurrentTCB->ulRunTimeCounter += ulElapsed;										\
+		pxCurrentTCB->ullCpuTime += ( uint64_t ) ulElapsed;									\
+		ullTotalCpuTime += ( uint64_t ) ulElapsed;											\
+		taskCHARGE_CPU_BUDGET( ulElapsed );													\
+		ulTaskSwitchedInTime = ( ulNow );													\
+	}
+
+#else
+
+	#define taskACCUMULATE_RUN_TIME( ulNow )												\
+	{																						\
+		pxCurrentTCB->ulRunTimeCounter += ( ( ulNow ) - ulTaskSwitchedInTime );			\
+		ulTaskSwitchedInTime = ( ulNow );													\
+	}
+
+#endif /* configUSE_TASK_CPU_ACCOUNTING */
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -414,6 +594,12 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if( configUSE_TASK_DELETE_HOOK == 1 )
+
+	extern void vApplicationTaskDeleteHook( TaskHandle_t xTask ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 	extern void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize ); /*lint !e526 Symbol not defined as it is an application callback. */
@@ -563,6 +749,51 @@ static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Insert pxTCB into the configEDF_PRIORITY ready list ahead of every task that
+ * has a later absolute deadline.  Tasks with equal deadlines are run in the
+ * order in which they became ready.
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvEDFInsertIntoReadyList( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Fills a TaskCpuStats_t structure for each task referenced from pxList.
+ */
+#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+
+	static UBaseType_t prvListCpuStatsWithinSingleList( TaskCpuStats_t *pxCpuStatsArray, List_t *pxList ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Demote or suspend a ready task that has used all of its CPU budget, and
+ * restore a task whose budget has been refilled.  Both must be called with
+ * interrupts masked and the scheduler not suspended, as they move tasks
+ * between the ready lists.
+ */
+#if ( configUSE_TASK_CPU_BUDGET == 1 )
+
+	static void prvCpuBudgetThrottle( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+	static void prvCpuBudgetRestore( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+	static void prvCpuBudgetSetPriority( TCB_t *pxTCB, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Refill every budget that is due at xTickNow and set xNextBudgetReplenishTime
+ * to the earliest budget still to be refilled.  Returns pdTRUE if a task that
+ * was held back by its budget should now preempt the running task.
+ */
+#if ( configUSE_TASK_CPU_BUDGET == 1 )
+
+	static BaseType_t prvReplenishCpuBudgets( const TickType_t xTickNow ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -693,7 +924,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends
 			on the implementation of the port malloc function and whether or
 			not static allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = ( TCB_t * ) pvPortMallocTaskMemory( sizeof( TCB_t ) );
 
 			if( pxNewTCB != NULL )
 			{
@@ -748,19 +979,19 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends on
 			the implementation of the port malloc function and whether or not static
 			allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = ( TCB_t * ) pvPortMallocTaskMemory( sizeof( TCB_t ) );
 
 			if( pxNewTCB != NULL )
 			{
 				/* Allocate space for the stack used by the task being created.
 				The base of the stack memory stored in the TCB so the task can
 				be deleted later if required. */
-				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocTaskMemory( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 				if( pxNewTCB->pxStack == NULL )
 				{
 					/* Could not allocate the stack.  Delete the allocated TCB. */
-					vPortFree( pxNewTCB );
+					vPortFreeTaskMemory( pxNewTCB );
 					pxNewTCB = NULL;
 				}
 			}
@@ -770,12 +1001,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 		StackType_t *pxStack;
 
 			/* Allocate space for the stack used by the task being created. */
-			pxStack = pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+			pxStack = pvPortMallocTaskMemory( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
 
 			if( pxStack != NULL )
 			{
 				/* Allocate space for the TCB. */
-				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+				pxNewTCB = ( TCB_t * ) pvPortMallocTaskMemory( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
 				if( pxNewTCB != NULL )
 				{
@@ -786,7 +1017,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 				{
 					/* The stack cannot be used as the TCB was not created.  Free
 					it again. */
-					vPortFree( pxStack );
+					vPortFreeTaskMemory( pxStack );
 				}
 			}
 			else
@@ -967,6 +1198,15 @@ UBaseType_t x;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+	{
+		pxNewTCB->ullCpuTime = 0ULL;
+		pxNewTCB->ulLastSliceTime = 0UL;
+		pxNewTCB->ulMaxSliceTime = 0UL;
+		pxNewTCB->ulPreemptions = 0UL;
+	}
+	#endif /* configUSE_TASK_CPU_ACCOUNTING */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -989,8 +1229,11 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+		{
+			pxNewTCB->ulNotifiedValue[ x ] = 0;
+			pxNewTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+		}
 	}
 	#endif
 
@@ -1009,6 +1252,37 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		pxNewTCB->xEDFPeriod = ( TickType_t ) 0;
+		pxNewTCB->xEDFRelativeDeadline = ( TickType_t ) 0;
+		pxNewTCB->xEDFReleaseTime = ( TickType_t ) 0;
+		pxNewTCB->xEDFAbsoluteDeadline = ( TickType_t ) 0;
+		pxNewTCB->uxEDFDeadlineMisses = ( UBaseType_t ) 0;
+	}
+	#endif
+
+	#if( configUSE_TASK_FPU_FLAG == 1 )
+	{
+		pxNewTCB->ucUsesFPU = pdFALSE;
+	}
+	#endif
+
+	#if( configUSE_TASK_CPU_BUDGET == 1 )
+	{
+		vListInitialiseItem( &( pxNewTCB->xBudgetListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxNewTCB->xBudgetListItem ), pxNewTCB );
+		pxNewTCB->ulBudget = 0UL;
+		pxNewTCB->ulBudgetRemaining = 0UL;
+		pxNewTCB->xBudgetPeriod = ( TickType_t ) 0;
+		pxNewTCB->xBudgetReplenishTime = ( TickType_t ) 0;
+		pxNewTCB->uxBudgetPriority = uxPriority;
+		pxNewTCB->uxBudgetExhaustions = ( UBaseType_t ) 0;
+		pxNewTCB->ucBudgetAction = ( uint8_t ) eBudgetDemote;
+		pxNewTCB->ucBudgetThrottled = pdFALSE;
+	}
+	#endif
+
 	/* Initialize the TCB stack to look as if the task was already running,
 	but had been interrupted by the scheduler.  The return address is set
 	to the start of the task function. Once the stack has been initialised
@@ -1141,7 +1415,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	{
 		/* If the created task is of a higher priority than the current task
 		then it should run now. */
-		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		if( taskTCB_PREEMPTS_CURRENT( pxNewTCB ) )
 		{
 			taskYIELD_IF_USING_PREEMPTION();
 		}
@@ -1169,6 +1443,15 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			being deleted. */
 			pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
+			#if ( configUSE_TASK_DELETE_HOOK == 1 )
+			{
+				/* Called while the task's stack is still valid, so anything
+				the application has linked from it can be unlinked.  Must not
+				call an API function that could block or yield. */
+				vApplicationTaskDeleteHook( ( TaskHandle_t ) pxTCB );
+			}
+			#endif
+
 			/* Remove task from the ready/delayed list. */
 			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 			{
@@ -1189,6 +1472,19 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if ( configUSE_TASK_CPU_BUDGET == 1 )
+			{
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_TASK_CPU_BUDGET */
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -1336,6 +1632,211 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskEDFSetParameters( TaskHandle_t xTask, const TickType_t xPeriod, const TickType_t xRelativeDeadline )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( ( xPeriod == ( TickType_t ) 0 ) || ( xRelativeDeadline > ( TickType_t ) 0 ) );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* The first job is released now. */
+			pxTCB->xEDFPeriod = xPeriod;
+			pxTCB->xEDFRelativeDeadline = xRelativeDeadline;
+			pxTCB->xEDFReleaseTime = xTickCount;
+			pxTCB->xEDFAbsoluteDeadline = xTickCount + xRelativeDeadline;
+			pxTCB->uxEDFDeadlineMisses = ( UBaseType_t ) 0;
+
+			/* If the task is already in the EDF ready list then its position in
+			that list must be updated to reflect its new deadline. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_PRIORITY ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+			{
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvEDFInsertIntoReadyList( pxTCB );
+
+				/* The running task may no longer have the earliest deadline. */
+				if( pxTCB != pxCurrentTCB )
+				{
+					if( taskTCB_PREEMPTS_CURRENT( pxTCB ) )
+					{
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskEDFWaitForNextPeriod( void )
+	{
+	BaseType_t xAlreadyYielded;
+
+		configASSERT( pxCurrentTCB->xEDFPeriod > ( TickType_t ) 0 );
+		configASSERT( uxSchedulerSuspended == 0 );
+
+		vTaskSuspendAll();
+		{
+			/* Minor optimisation.  The tick count cannot change in this
+			block. */
+			const TickType_t xConstTickCount = xTickCount;
+
+			/* The current job has completed.  Was it late? */
+			if( taskEDF_DEADLINE_IS_EARLIER( pxCurrentTCB->xEDFAbsoluteDeadline, xConstTickCount ) )
+			{
+				( pxCurrentTCB->uxEDFDeadlineMisses )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Release times advance by exactly one period so the schedule does
+			not drift, and the new deadline is relative to the new release. */
+			pxCurrentTCB->xEDFReleaseTime += pxCurrentTCB->xEDFPeriod;
+			pxCurrentTCB->xEDFAbsoluteDeadline = pxCurrentTCB->xEDFReleaseTime + pxCurrentTCB->xEDFRelativeDeadline;
+
+			if( taskEDF_DEADLINE_IS_EARLIER( xConstTickCount, pxCurrentTCB->xEDFReleaseTime ) )
+			{
+				/* Block until the next job is released.  The task is placed
+				back into the EDF ready list, by its new deadline, when it
+				unblocks. */
+				traceTASK_DELAY_UNTIL( pxCurrentTCB->xEDFReleaseTime );
+				prvAddCurrentTaskToDelayedList( pxCurrentTCB->xEDFReleaseTime - xConstTickCount, pdFALSE );
+			}
+			else
+			{
+				/* The task has overrun and its next job is already released.  It
+				remains ready, but must be moved to the position its new deadline
+				dictates.  Interrupts cannot access the ready lists while the
+				scheduler is suspended. */
+				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_PRIORITY ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE )
+				{
+					( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+					prvEDFInsertIntoReadyList( pxCurrentTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		xAlreadyYielded = xTaskResumeAll();
+
+		/* Force a reschedule if xTaskResumeAll has not already done so, we may
+		have put ourselves to sleep or no longer have the earliest deadline. */
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	UBaseType_t uxTaskEDFGetDeadlineMisses( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxEDFDeadlineMisses;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_FPU_FLAG == 1 )
+
+	void vTaskUseFPU( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->ucUsesFPU = pdTRUE;
+
+			/* Any other task picks up the change the next time it is switched
+			in, but the calling task may want to use the FPU straight away. */
+			if( pxTCB == pxCurrentTCB )
+			{
+				portSET_TASK_FPU_ACCESS( pdTRUE );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_FPU_FLAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvEDFInsertIntoReadyList( TCB_t *pxTCB )
+	{
+	List_t * const pxList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+	ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+	ListItem_t *pxIterator;
+
+		/* Find the last task that must run before pxTCB.  The list is short -
+		it only holds the ready tasks at a single priority. */
+		for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext != ( ListItem_t * ) &( pxList->xListEnd ); pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		{
+			if( taskEDF_RUNS_BEFORE( pxTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator->pxNext ) ) )
+			{
+				break;
+			}
+		}
+
+		/* Link in after pxIterator, exactly as vListInsert() would. */
+		pxNewListItem->pxNext = pxIterator->pxNext;
+		pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+		pxNewListItem->pxPrevious = pxIterator;
+		pxIterator->pxNext = pxNewListItem;
+		pxNewListItem->pxContainer = pxList;
+
+		( pxList->uxNumberOfItems )++;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelay == 1 )
 
 	void vTaskDelay( const TickType_t xTicksToDelay )
@@ -1423,17 +1924,22 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					{
 						#if( configUSE_TASK_NOTIFICATIONS == 1 )
 						{
+						UBaseType_t x;
+
 							/* The task does not appear on the event list item of
 							and of the RTOS objects, but could still be in the
 							blocked state if it is waiting on its notification
-							rather than waiting on an object. */
-							if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
-							{
-								eReturn = eBlocked;
-							}
-							else
+							rather than waiting on an object.  A task can only
+							wait on one notification at a time. */
+							eReturn = eSuspended;
+
+							for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 							{
-								eReturn = eSuspended;
+								if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+								{
+									eReturn = eBlocked;
+									break;
+								}
 							}
 						}
 						#else
@@ -1738,11 +2244,16 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			UBaseType_t x;
+
+				for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but
+						is now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
@@ -2028,6 +2539,32 @@ BaseType_t xReturn;
 	}
 	#endif /* configUSE_TIMERS */
 
+	#if ( configUSE_WORK_QUEUE == 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+			xReturn = xWorkQueueCreateTask();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_WORK_QUEUE */
+
+	#if ( configUSE_JOB_EXECUTOR == 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+			xReturn = xJobExecutorCreateTask();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_JOB_EXECUTOR */
+
 	if( xReturn == pdPASS )
 	{
 		/* freertos_tasks_c_additions_init() should only be called if the user
@@ -2068,6 +2605,14 @@ BaseType_t xReturn;
 		FreeRTOSConfig.h file. */
 		portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+		/* Only allow the first task to access the FPU if it is marked as
+		using it. */
+		#if ( configUSE_TASK_FPU_FLAG == 1 )
+		{
+			portSET_TASK_FPU_ACCESS( pxCurrentTCB->ucUsesFPU );
+		}
+		#endif
+
 		traceTASK_SWITCHED_IN();
 
 		/* Setting up the timer tick is hardware specific and thus in the
@@ -2146,6 +2691,11 @@ void vTaskSuspendAll( void )
 				uxHigherPriorityReadyTasks = pdTRUE;
 			}
 		}
+		#elif defined( portREADY_PRIORITIES_TYPE )
+		{
+			/* The port holds the ready priorities in a multi-word bit map. */
+			uxHigherPriorityReadyTasks = portREADY_PRIORITY_ABOVE_IDLE( uxTopReadyPriority );
+		}
 		#else
 		{
 			const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
@@ -2678,7 +3228,7 @@ BaseType_t xYieldRequired = pdFALSE;
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskTCB_PREEMPTS_CURRENT( pxTCB ) )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2704,6 +3254,86 @@ BaseType_t xYieldRequired = pdFALSE;
 #endif /* INCLUDE_xTaskAbortDelay */
 /*----------------------------------------------------------*/
 
+#if ( INCLUDE_xTaskAbortDelay == 1 )
+
+	BaseType_t xTaskAbortDelayFromISR( TaskHandle_t xTask, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	TCB_t * const pxTCB = xTask;
+	BaseType_t xReturn = pdFAIL;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( pxTCB );
+
+		/* See the comments in xTaskResumeFromISR() regarding interrupt
+		priorities. */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			/* The delayed lists, and the event lists of objects that are not
+			locked, can only be accessed from an interrupt if the scheduler is
+			not suspended.  If it is then the caller must try again later. */
+			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+			{
+				/* Only a task that is blocked with a timeout is referenced from
+				a delayed list.  Tasks blocked indefinitely are not aborted. */
+				if( ( listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) ) == pxDelayedTaskList ) ||
+					( listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) ) == pxOverflowDelayedTaskList ) )
+				{
+					xReturn = pdPASS;
+
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+
+						/* This lets the task know it was forcibly removed from
+						the blocked state so it should not re-evaluate its block
+						time and then block again. */
+						pxTCB->ucDelayAborted = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					prvAddTaskToReadyList( pxTCB );
+
+					if( taskTCB_PREEMPTS_CURRENT( pxTCB ) )
+					{
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+
+						/* Mark that a yield is pending in case the user is not
+						using the "xHigherPriorityTaskWoken" parameter. */
+						xYieldPending = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* INCLUDE_xTaskAbortDelay */
+/*----------------------------------------------------------*/
+
 BaseType_t xTaskIncrementTick( void )
 {
 TCB_t * pxTCB;
@@ -2714,6 +3344,20 @@ BaseType_t xSwitchRequired = pdFALSE;
 	Increments the tick then checks to see if the new tick value will cause any
 	tasks to be unblocked. */
 	traceTASK_INCREMENT_TICK( xTickCount );
+
+	#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+	{
+		/* Credit the running task with its time so far on every tick, so the
+		64-bit totals remain correct even if a single task runs for longer
+		than the run time counter takes to wrap. */
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+		#else
+			ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
+		taskACCUMULATE_RUN_TIME( ulTotalRunTime );
+	}
+	#endif /* configUSE_TASK_CPU_ACCOUNTING */
 	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 	{
 		/* Minor optimisation.  The tick count cannot change in this
@@ -2815,12 +3459,51 @@ BaseType_t xSwitchRequired = pdFALSE;
 			}
 		}
 
+		#if ( configUSE_TASK_CPU_BUDGET == 1 )
+		{
+			/* Refill any budgets that are due.  The run time used by the
+			running task was charged on entry to this function, so if it has
+			now used all of its budget switch away from it -
+			vTaskSwitchContext() demotes or suspends it. */
+			if( xConstTickCount == xNextBudgetReplenishTime )
+			{
+				if( prvReplenishCpuBudgets( xConstTickCount ) != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( taskCPU_BUDGET_EXHAUSTED( pxCurrentTCB ) )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_CPU_BUDGET */
+
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
 		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			#if ( configUSE_EDF_SCHEDULING == 1 )
+				/* Tasks in the EDF band run in deadline order, not in turn. */
+				if( ( pxCurrentTCB->uxPriority != ( UBaseType_t ) configEDF_PRIORITY ) &&
+					( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) )
+			#else
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			#endif
 			{
 				xSwitchRequired = pdTRUE;
 			}
@@ -2988,6 +3671,10 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 void vTaskSwitchContext( void )
 {
+#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+TCB_t *pxOutgoingTCB;
+#endif
+
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -3009,23 +3696,19 @@ void vTaskSwitchContext( void )
 
 			/* Add the amount of time the task has been running to the
 			accumulated time so far.  The time the task started running was
-			stored in ulTaskSwitchedInTime.  Note that there is no overflow
-			protection here so count values are only valid until the timer
-			overflows.  The guard against negative values is to protect
-			against suspect run time stat counter implementations - which
-			are provided by the application, not the kernel. */
-			if( ulTotalRunTime > ulTaskSwitchedInTime )
-			{
-				pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
-			ulTaskSwitchedInTime = ulTotalRunTime;
+			stored in ulTaskSwitchedInTime.  The 32-bit per task counter
+			itself is only valid until it overflows - configure
+			configUSE_TASK_CPU_ACCOUNTING for 64-bit totals. */
+			taskACCUMULATE_RUN_TIME( ulTotalRunTime );
 		}
 		#endif /* configGENERATE_RUN_TIME_STATS */
 
+		#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+		{
+			pxOutgoingTCB = pxCurrentTCB;
+		}
+		#endif
+
 		/* Check for stack overflow, if configured. */
 		taskCHECK_FOR_STACK_OVERFLOW();
 
@@ -3039,8 +3722,69 @@ void vTaskSwitchContext( void )
 		/* Select a new task to run using either the generic C or port
 		optimised asm code. */
 		taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+		#if ( configUSE_TASK_CPU_BUDGET == 1 )
+		{
+			/* A task that has used all of its budget is never switched in at
+			its normal priority.  Each pass holds back one task, and the idle
+			task has no budget, so the loop terminates. */
+			while( taskCPU_BUDGET_EXHAUSTED( pxCurrentTCB ) )
+			{
+				prvCpuBudgetThrottle( pxCurrentTCB );
+				taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			}
+		}
+		#endif /* configUSE_TASK_CPU_BUDGET */
+
 		traceTASK_SWITCHED_IN();
 
+		#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+		{
+			/* A slice ends only when a different task is selected. */
+			if( pxCurrentTCB != pxOutgoingTCB )
+			{
+			const uint32_t ulSliceTime = ulTotalRunTime - ulSliceStartTime;
+
+				pxOutgoingTCB->ulLastSliceTime = ulSliceTime;
+
+				if( ulSliceTime > pxOutgoingTCB->ulMaxSliceTime )
+				{
+					pxOutgoingTCB->ulMaxSliceTime = ulSliceTime;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* A task that is switched out while still referenced from a
+				ready list did not block, so was preempted (or yielded). */
+				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxOutgoingTCB->uxPriority ] ), &( pxOutgoingTCB->xStateListItem ) ) != pdFALSE )
+				{
+					( pxOutgoingTCB->ulPreemptions )++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				ulSliceStartTime = ulTotalRunTime;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_CPU_ACCOUNTING */
+
+		/* The outgoing task's floating point registers have already been
+		saved, so access to the FPU can now be granted to, or withdrawn from,
+		the incoming task. */
+		#if ( configUSE_TASK_FPU_FLAG == 1 )
+		{
+			portSET_TASK_FPU_ACCESS( pxCurrentTCB->ucUsesFPU );
+		}
+		#endif
+
 		/* After the new task is switched in, update the global errno. */
 		#if( configUSE_POSIX_ERRNO == 1 )
 		{
@@ -3183,7 +3927,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskTCB_PREEMPTS_CURRENT( pxUnblockedTCB ) )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3240,7 +3984,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskTCB_PREEMPTS_CURRENT( pxUnblockedTCB ) )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3251,6 +3995,63 @@ TCB_t *pxUnblockedTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+
+	BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+	{
+	TCB_t *pxUnblockedTCB;
+	BaseType_t xReturn;
+
+		/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+		called from a critical section within an ISR.  The event list is only
+		accessed from critical sections, so exclusive access to it is
+		guaranteed here. */
+
+		/* Store the new item value in the event list. */
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		configASSERT( pxUnblockedTCB );
+		( void ) uxListRemove( pxEventListItem );
+
+		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		{
+			( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+			prvAddTaskToReadyList( pxUnblockedTCB );
+
+			#if( configUSE_TICKLESS_IDLE != 0 )
+			{
+				/* See the comment in xTaskRemoveFromEventList(). */
+				prvResetNextTaskUnblockTime();
+			}
+			#endif
+		}
+		else
+		{
+			/* The delayed and ready lists cannot be accessed, so hold this task
+			pending until the scheduler is resumed. */
+			vListInsertEnd( &( xPendingReadyList ), pxEventListItem );
+		}
+
+		if( taskTCB_PREEMPTS_CURRENT( pxUnblockedTCB ) )
+		{
+			/* Mark that a yield is pending in case the user is not using the
+			"xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS
+			function. */
+			xReturn = pdTRUE;
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_WAKE */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3629,6 +4430,12 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
+	#if ( configUSE_TASK_CPU_BUDGET == 1 )
+	{
+		vListInitialise( &xBudgetedTaskList );
+	}
+	#endif /* configUSE_TASK_CPU_BUDGET */
+
 	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
 	using list2. */
 	pxDelayedTaskList = &xDelayedTaskList1;
@@ -3905,8 +4712,8 @@ static void prvCheckTasksWaitingTermination( void )
 		{
 			/* The task can only have been allocated dynamically - free both
 			the stack and TCB. */
-			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
+			vPortFreeTaskMemory( pxTCB->pxStack );
+			vPortFreeTaskMemory( pxTCB );
 		}
 		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
 		{
@@ -3917,14 +4724,14 @@ static void prvCheckTasksWaitingTermination( void )
 			{
 				/* Both the stack and TCB were allocated dynamically, so both
 				must be freed. */
-				vPortFree( pxTCB->pxStack );
-				vPortFree( pxTCB );
+				vPortFreeTaskMemory( pxTCB->pxStack );
+				vPortFreeTaskMemory( pxTCB );
 			}
 			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
 			{
 				/* Only the stack was statically allocated, so the TCB is the
 				only memory that must be freed. */
-				vPortFree( pxTCB );
+				vPortFreeTaskMemory( pxTCB );
 			}
 			else
 			{
@@ -4099,6 +4906,55 @@ TCB_t *pxTCB;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+	void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+	{
+		/* Called from a critical section.  The mutex was just obtained, so
+		xTaskPriorityDisinherit() will restore the base priority once the task
+		has given back every mutex it holds. */
+		configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+		/* The protocol only works if no task that uses the mutex has a
+		priority above the ceiling. */
+		configASSERT( pxCurrentTCB->uxBasePriority <= uxCeilingPriority );
+
+		if( pxCurrentTCB->uxPriority < uxCeilingPriority )
+		{
+			if( ( listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+			{
+				listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The running task is in its ready list, so must be moved into
+			the list for its new priority.  Raising the priority of the
+			running task never requires a context switch. */
+			if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			traceTASK_PRIORITY_INHERIT( pxCurrentTCB, uxCeilingPriority );
+			pxCurrentTCB->uxPriority = uxCeilingPriority;
+			prvAddTaskToReadyList( pxCurrentTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
 	BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
@@ -4630,19 +5486,52 @@ TickType_t uxReturn;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+	BaseType_t xTaskDecrementMutexHeldCount( void )
+	{
+	BaseType_t xReturn;
+
+		/* Only the running task modifies its own uxMutexesHeld, so while it
+		runs at its base priority the count can be dropped without a critical
+		section.  A raised priority has to go through the full disinheritance
+		logic. */
+		if( pxCurrentTCB->uxPriority == pxCurrentTCB->uxBasePriority )
+		{
+			configASSERT( pxCurrentTCB->uxMutexesHeld );
+			( pxCurrentTCB->uxMutexesHeld )--;
+			xReturn = pdFALSE;
+		}
+		else
+		{
+			taskENTER_CRITICAL();
+			{
+				xReturn = xTaskPriorityDisinherit( pxCurrentTCB );
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4670,17 +5559,17 @@ TickType_t uxReturn;
 		taskENTER_CRITICAL();
 		{
 			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4688,7 +5577,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4700,22 +5589,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4748,14 +5639,14 @@ TickType_t uxReturn;
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 			}
 
 			/* If ucNotifyValue is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4764,11 +5655,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4780,12 +5671,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		configASSERT( xTaskToNotify );
 		pxTCB = xTaskToNotify;
 
@@ -4793,31 +5686,31 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4835,7 +5728,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 
 					break;
 			}
@@ -4868,7 +5761,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskTCB_PREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4894,13 +5787,15 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	BaseType_t xReturn = pdPASS;
 	UBaseType_t uxSavedInterruptStatus;
 
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		configASSERT( xTaskToNotify );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
@@ -4927,30 +5822,30 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4968,7 +5863,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 					break;
 			}
 
@@ -4993,7 +5888,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskTCB_PREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5023,12 +5918,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		configASSERT( xTaskToNotify );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
@@ -5053,12 +5950,12 @@ TickType_t uxReturn;
 
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
@@ -5081,7 +5978,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskTCB_PREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5109,20 +6006,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
@@ -5140,11 +6039,13 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear )
+	uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear )
 	{
 	TCB_t *pxTCB;
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
@@ -5153,8 +6054,8 @@ TickType_t uxReturn;
 		{
 			/* Return the notification as it was before the bits were cleared,
 			then clear the bit mask. */
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
-			pxTCB->ulNotifiedValue &= ~ulBitsToClear;
+			ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
+			pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
 		}
 		taskEXIT_CRITICAL();
 
@@ -5174,6 +6075,471 @@ TickType_t uxReturn;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+
+	void vTaskGetTaskCpuStats( TaskHandle_t xTask, TaskCpuStats_t *pxCpuStats )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( pxCpuStats );
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		/* The 64-bit total of the running task is updated from the tick
+		interrupt, so must be read with interrupts masked. */
+		taskENTER_CRITICAL();
+		{
+			pxCpuStats->xHandle = ( TaskHandle_t ) pxTCB;
+			pxCpuStats->ullTotalTime = pxTCB->ullCpuTime;
+			pxCpuStats->ulLastSliceTime = pxTCB->ulLastSliceTime;
+			pxCpuStats->ulMaxSliceTime = pxTCB->ulMaxSliceTime;
+			pxCpuStats->ulPreemptions = pxTCB->ulPreemptions;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_CPU_ACCOUNTING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+
+	UBaseType_t uxTaskGetCpuStats( TaskCpuStats_t * const pxCpuStatsArray, const UBaseType_t uxArraySize, uint64_t * const pullTotalTime )
+	{
+	UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+
+		vTaskSuspendAll();
+		{
+			/* Is there a space in the array for each task in the system? */
+			if( uxArraySize >= uxCurrentNumberOfTasks )
+			{
+				do
+				{
+					uxQueue--;
+					uxTask += prvListCpuStatsWithinSingleList( &( pxCpuStatsArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ) );
+
+				} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+				uxTask += prvListCpuStatsWithinSingleList( &( pxCpuStatsArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList );
+				uxTask += prvListCpuStatsWithinSingleList( &( pxCpuStatsArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList );
+
+				#if( INCLUDE_vTaskDelete == 1 )
+				{
+					uxTask += prvListCpuStatsWithinSingleList( &( pxCpuStatsArray[ uxTask ] ), &xTasksWaitingTermination );
+				}
+				#endif
+
+				#if ( INCLUDE_vTaskSuspend == 1 )
+				{
+					uxTask += prvListCpuStatsWithinSingleList( &( pxCpuStatsArray[ uxTask ] ), &xSuspendedTaskList );
+				}
+				#endif
+
+				if( pullTotalTime != NULL )
+				{
+					taskENTER_CRITICAL();
+					{
+						*pullTotalTime = ullTotalCpuTime;
+					}
+					taskEXIT_CRITICAL();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return uxTask;
+	}
+
+#endif /* configUSE_TASK_CPU_ACCOUNTING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+
+	static UBaseType_t prvListCpuStatsWithinSingleList( TaskCpuStats_t *pxCpuStatsArray, List_t *pxList )
+	{
+	configLIST_VOLATILE TCB_t *pxNextTCB, *pxFirstTCB;
+	UBaseType_t uxTask = 0;
+
+		if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+			do
+			{
+				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				vTaskGetTaskCpuStats( ( TaskHandle_t ) pxNextTCB, &( pxCpuStatsArray[ uxTask ] ) );
+				uxTask++;
+			} while( pxNextTCB != pxFirstTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxTask;
+	}
+
+#endif /* configUSE_TASK_CPU_ACCOUNTING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_CPU_BUDGET == 1 )
+
+	void vTaskSetCpuBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xPeriod, eBudgetAction eAction )
+	{
+	TCB_t *pxTCB;
+	TickType_t xTicksToNextReplenish;
+	BaseType_t xYieldRequired = pdFALSE;
+
+		configASSERT( ( ulBudget == 0UL ) || ( xPeriod > ( TickType_t ) 0 ) );
+
+		#if ( INCLUDE_vTaskSuspend != 1 )
+		{
+			configASSERT( eAction != eBudgetSuspend );
+		}
+		#endif
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then the budget of the calling task is
+			being set. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* A task held back by its old budget can run again straight away. */
+			if( pxTCB->ucBudgetThrottled != pdFALSE )
+			{
+				prvCpuBudgetRestore( pxTCB );
+
+				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				{
+					xYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->ulBudget = ulBudget;
+			pxTCB->ulBudgetRemaining = ulBudget;
+			pxTCB->xBudgetPeriod = xPeriod;
+			pxTCB->ucBudgetAction = ( uint8_t ) eAction;
+			pxTCB->uxBudgetExhaustions = ( UBaseType_t ) 0;
+
+			if( ulBudget != 0UL )
+			{
+				pxTCB->xBudgetReplenishTime = xTickCount + xPeriod;
+
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) == NULL )
+				{
+					vListInsertEnd( &xBudgetedTaskList, &( pxTCB->xBudgetListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Bring the next replenishment forward if this budget is the
+				first to be refilled. */
+				xTicksToNextReplenish = xNextBudgetReplenishTime - xTickCount;
+
+				if( ( listCURRENT_LIST_LENGTH( &xBudgetedTaskList ) == ( UBaseType_t ) 1 ) ||
+					( xTicksToNextReplenish == ( TickType_t ) 0 ) ||
+					( xPeriod < xTicksToNextReplenish ) )
+				{
+					xNextBudgetReplenishTime = pxTCB->xBudgetReplenishTime;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xYieldRequired != pdFALSE )
+		{
+			taskYIELD_IF_USING_PREEMPTION();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TASK_CPU_BUDGET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_CPU_BUDGET == 1 )
+
+	uint32_t ulTaskGetCpuBudgetRemaining( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	uint32_t ulReturn;
+
+		/* The remaining budget of the running task is charged from the tick
+		interrupt. */
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			ulReturn = pxTCB->ulBudgetRemaining;
+		}
+		taskEXIT_CRITICAL();
+
+		return ulReturn;
+	}
+
+#endif /* configUSE_TASK_CPU_BUDGET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_CPU_BUDGET == 1 )
+
+	UBaseType_t uxTaskGetCpuBudgetExhaustions( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		return pxTCB->uxBudgetExhaustions;
+	}
+
+#endif /* configUSE_TASK_CPU_BUDGET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_CPU_BUDGET == 1 )
+
+	static void prvCpuBudgetThrottle( TCB_t *pxTCB )
+	{
+		traceTASK_CPU_BUDGET_EXHAUSTED( pxTCB );
+
+		( pxTCB->uxBudgetExhaustions )++;
+		pxTCB->ucBudgetThrottled = pdTRUE;
+
+		if( pxTCB->ucBudgetAction == ( uint8_t ) eBudgetDemote )
+		{
+			/* Remember the priority the task was given, rather than any
+			priority it has inherited, so it can be restored. */
+			#if ( configUSE_MUTEXES == 1 )
+			{
+				pxTCB->uxBudgetPriority = pxTCB->uxBasePriority;
+			}
+			#else
+			{
+				pxTCB->uxBudgetPriority = pxTCB->uxPriority;
+			}
+			#endif
+
+			prvCpuBudgetSetPriority( pxTCB, ( UBaseType_t ) configCPU_BUDGET_DEMOTED_PRIORITY );
+		}
+		else
+		{
+			#if ( INCLUDE_vTaskSuspend == 1 )
+			{
+				/* The task is known to be ready, as it was about to be
+				selected to run. */
+				if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+				{
+					taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+			}
+			#endif /* INCLUDE_vTaskSuspend */
+		}
+	}
+
+#endif /* configUSE_TASK_CPU_BUDGET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_CPU_BUDGET == 1 )
+
+	static void prvCpuBudgetRestore( TCB_t *pxTCB )
+	{
+		traceTASK_CPU_BUDGET_REPLENISHED( pxTCB );
+
+		pxTCB->ucBudgetThrottled = pdFALSE;
+
+		if( pxTCB->ucBudgetAction == ( uint8_t ) eBudgetDemote )
+		{
+			prvCpuBudgetSetPriority( pxTCB, pxTCB->uxBudgetPriority );
+		}
+		else
+		{
+			#if ( INCLUDE_vTaskSuspend == 1 )
+			{
+				/* Only resume the task if it was not resumed or deleted while
+				it was held back. */
+				if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					prvAddTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* INCLUDE_vTaskSuspend */
+		}
+	}
+
+#endif /* configUSE_TASK_CPU_BUDGET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_CPU_BUDGET == 1 )
+
+	static void prvCpuBudgetSetPriority( TCB_t *pxTCB, UBaseType_t uxNewPriority )
+	{
+	const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+		traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
+
+		/* As vTaskPrioritySet(), but called with interrupts already masked
+		and without yielding. */
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			/* Only change the priority being used if the task is not
+			currently using an inherited priority. */
+			if( pxTCB->uxBasePriority == pxTCB->uxPriority )
+			{
+				pxTCB->uxPriority = uxNewPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->uxBasePriority = uxNewPriority;
+		}
+		#else
+		{
+			pxTCB->uxPriority = uxNewPriority;
+		}
+		#endif
+
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( pxTCB->uxPriority != uxPriorityUsedOnEntry ) &&
+			( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+		{
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvAddTaskToReadyList( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TASK_CPU_BUDGET */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_CPU_BUDGET == 1 )
+
+	static BaseType_t prvReplenishCpuBudgets( const TickType_t xTickNow )
+	{
+	ListItem_t const *pxListEnd = listGET_END_MARKER( &xBudgetedTaskList );
+	ListItem_t *pxListItem;
+	TCB_t *pxTCB;
+	TickType_t xTicksToReplenish, xTicksToNextReplenish = portMAX_DELAY;
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		/* Only called when at least one budget is due, so the cost of walking
+		the list is not paid on every tick. */
+		for( pxListItem = listGET_HEAD_ENTRY( &xBudgetedTaskList ); pxListItem != pxListEnd; pxListItem = listGET_NEXT( pxListItem ) )
+		{
+			pxTCB = listGET_LIST_ITEM_OWNER( pxListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+			if( pxTCB->xBudgetReplenishTime == xTickNow )
+			{
+				pxTCB->ulBudgetRemaining = pxTCB->ulBudget;
+				pxTCB->xBudgetReplenishTime += pxTCB->xBudgetPeriod;
+
+				if( pxTCB->ucBudgetThrottled != pdFALSE )
+				{
+					prvCpuBudgetRestore( pxTCB );
+
+					#if ( configUSE_PREEMPTION == 1 )
+					{
+						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_PREEMPTION */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Every replenish time is within one period of now, so unsigned
+			subtraction orders them correctly across a tick count wrap. */
+			xTicksToReplenish = pxTCB->xBudgetReplenishTime - xTickNow;
+
+			if( xTicksToReplenish < xTicksToNextReplenish )
+			{
+				xTicksToNextReplenish = xTicksToReplenish;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		xNextBudgetReplenishTime = xTickNow + xTicksToNextReplenish;
+
+		return xSwitchRequired;
+	}
+
+#endif /* configUSE_TASK_CPU_BUDGET */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
 {
 TickType_t xTimeToWake;
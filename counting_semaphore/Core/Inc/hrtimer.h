@@ -0,0 +1,87 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    hrtimer.h
+  * @brief   Microsecond delays and timeouts for FreeRTOS tasks, driven by a
+  *          free-running 32-bit hardware timer.
+  ******************************************************************************
+  * @attention
+  *
+  * The tick only resolves delays to 1/configTICK_RATE_HZ.  When
+  * configUSE_HRTIMER is set to 1 in FreeRTOSConfig.h, TIM5 is run as a
+  * free-running 1 MHz counter and its capture/compare channel 1 interrupt
+  * ends a task's wait at the requested microsecond, using
+  * xTaskAbortDelayFromISR().  The tick timeout passed to the kernel is only a
+  * backstop a couple of ticks beyond the deadline.
+  *
+  * INCLUDE_xTaskAbortDelay and configUSE_TASK_DELETE_HOOK must be set to 1,
+  * vApplicationTaskDeleteHook() must call vHRTimerTaskDeleted(), and TIM5
+  * must not be used by the application.  freertos.c starts TIM5 with
+  * vHRTimerInit() when the scheduler starts.  The TIM5 interrupt runs at
+  * configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HRTIMER_H
+#define __HRTIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#ifndef configUSE_HRTIMER
+  #define configUSE_HRTIMER 0
+#endif
+
+#if (configUSE_HRTIMER == 1)
+
+#if (INCLUDE_xTaskAbortDelay != 1)
+  #error configUSE_HRTIMER requires INCLUDE_xTaskAbortDelay to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#if (configUSE_TASK_DELETE_HOOK != 1)
+  #error configUSE_HRTIMER requires configUSE_TASK_DELETE_HOOK to be set to 1 in FreeRTOSConfig.h
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Passed as a timeout to block without a time limit. */
+#define HRTIMER_WAIT_FOREVER      0xFFFFFFFFUL
+
+/* Delays shorter than this are busy-waited on the counter, as blocking and
+   being woken by the compare interrupt costs about as much. */
+#ifndef HRTIMER_BUSY_WAIT_US
+  #define HRTIMER_BUSY_WAIT_US    20UL
+#endif
+
+/* Longest finite delay or timeout.  Deadlines are compared with signed
+   arithmetic, so they must lie within half the counter range. */
+#define HRTIMER_MAX_TIMEOUT_US    0x7FFFFFFFUL
+
+/* Exported functions prototypes ---------------------------------------------*/
+void vHRTimerInit(void);
+void vHRTimerClockChanged(void);
+uint32_t ulHRTimerGetTimeUs(void);
+void vHRTimerTaskDeleted(TaskHandle_t xTask);
+
+void vTaskDelayUs(uint32_t ulDelayUs);
+BaseType_t xQueueReceiveUs(QueueHandle_t xQueue, void * const pvBuffer, uint32_t ulTimeoutUs);
+BaseType_t xQueueSendUs(QueueHandle_t xQueue, const void * const pvItemToQueue, uint32_t ulTimeoutUs);
+BaseType_t xSemaphoreTakeUs(SemaphoreHandle_t xSemaphore, uint32_t ulTimeoutUs);
+
+#endif /* configUSE_HRTIMER */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HRTIMER_H */
@@ -0,0 +1,24 @@
+/* Generated by tools/stack_analyzer.py from the -fstack-usage output and the
+ * call graph of the linked image.  Do not edit: the file is rewritten by every
+ * build whose worst case stack usage changed.
+ *
+ * Each size is the deepest call chain of the task, plus 204 bytes for the
+ * port to save the task context and a 32 byte margin, in words.
+ */
+
+#ifndef TASK_STACKS_H
+#define TASK_STACKS_H
+
+/* HPT_TASK: 392 bytes, HPT_TASK -> itoa -> __itoa -> __utoa */
+#define TASK_STACK_WORDS_HPT_TASK 158
+
+/* MPT_TASK: 384 bytes, MPT_TASK -> itoa -> __itoa -> __utoa */
+#define TASK_STACK_WORDS_MPT_TASK 156
+
+/* LPT_TASK: 384 bytes, LPT_TASK -> itoa -> __itoa -> __utoa */
+#define TASK_STACK_WORDS_LPT_TASK 156
+
+/* VLPT_TASK: 384 bytes, VLPT_TASK -> itoa -> __itoa -> __utoa */
+#define TASK_STACK_WORDS_VLPT_TASK 156
+
+#endif /* TASK_STACKS_H */
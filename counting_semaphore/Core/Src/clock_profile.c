@@ -0,0 +1,357 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    clock_profile.c
+  * @brief   Run-time switching between the system clock profiles.
+  ******************************************************************************
+  * @attention
+  *
+  * The PLL cannot be reprogrammed, and the voltage scale does not change,
+  * while the PLL drives SYSCLK, so every switch goes through the HSI:
+  *
+  *  1. SYSCLK to the HSI, keeping the current flash wait states, which are
+  *     enough for 16 MHz.
+  *  2. Over-drive off, as it is only allowed in scale 1.
+  *  3. PLL reprogrammed, and the voltage scale set, which needs the PLL to
+  *     relock.  Over-drive back on if the profile uses it.
+  *  4. SYSCLK to the profile's source.  HAL_RCC_ClockConfig() raises the
+  *     flash wait states before a faster clock and lowers them after a
+  *     slower one, updates SystemCoreClock and restarts the HAL time base.
+  *
+  * The tick is recalibrated after each change of SYSCLK, so the tick in
+  * progress keeps its length however long the PLL takes to lock.  Other tasks
+  * are held off by suspending the scheduler, but interrupts stay enabled, as
+  * the HAL times its waits with the HAL tick.
+  *
+  * A task can be holding off in the middle of a peripheral transfer when the
+  * scheduler is suspended, so the hooks must leave peripheral handles alone:
+  * vClockProfileChangingHook() lets a transfer in progress drain, and
+  * vClockProfileChangedHook() rewrites only the registers timed from a bus
+  * clock, such as a UART's BRR with vClockProfileUartRetune().
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "clock_profile.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hrtimer.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint32_t ulSysclkHz;
+  uint32_t ulPLLN;            /* 0 when SYSCLK is the HSI and the PLL is off */
+  uint32_t ulPLLQ;
+  uint32_t ulVoltageScale;
+  uint32_t ulOverDrive;       /* 1 to run over-drive */
+  uint32_t ulFlashLatency;
+  uint32_t ulAPB1Divider;
+  uint32_t ulAPB2Divider;
+} ClockProfileConfig_t;
+
+/* Private define ------------------------------------------------------------*/
+/* The 8 MHz HSE divided down to the 2 MHz the PLL input wants.  SYSCLK is then
+   PLLN MHz with PLLP at 2. */
+#define CLOCK_PROFILE_PLLM        4U
+
+/* Longest vClockProfileUartWaitIdle() waits for the byte being sent, in HAL
+   ticks.  A byte takes 1.04 ms at 9600 baud. */
+#define CLOCK_PROFILE_UART_IDLE_TIMEOUT   3U
+
+/* Private variables ---------------------------------------------------------*/
+/* Bus clocks are kept within 45 MHz for APB1 and 90 MHz for APB2, and the
+   wait states are those for a 2.7 V to 3.6 V supply. */
+static const ClockProfileConfig_t xProfiles[CLOCK_PROFILE_COUNT] =
+{
+  /* CLOCK_PROFILE_180MHZ */
+  { 180000000UL, 180U, 3U, PWR_REGULATOR_VOLTAGE_SCALE1, 1U, FLASH_LATENCY_5, RCC_HCLK_DIV4, RCC_HCLK_DIV2 },
+  /* CLOCK_PROFILE_168MHZ */
+  { 168000000UL, 168U, 7U, PWR_REGULATOR_VOLTAGE_SCALE1, 0U, FLASH_LATENCY_5, RCC_HCLK_DIV4, RCC_HCLK_DIV2 },
+  /* CLOCK_PROFILE_72MHZ */
+  {  72000000UL,  72U, 3U, PWR_REGULATOR_VOLTAGE_SCALE3, 0U, FLASH_LATENCY_2, RCC_HCLK_DIV2, RCC_HCLK_DIV1 },
+  /* CLOCK_PROFILE_16MHZ */
+  {  16000000UL,   0U, 0U, PWR_REGULATOR_VOLTAGE_SCALE3, 0U, FLASH_LATENCY_0, RCC_HCLK_DIV1, RCC_HCLK_DIV1 }
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static HAL_StatusTypeDef prvSwitchToHSI(void);
+static HAL_StatusTypeDef prvConfigurePLL(const ClockProfileConfig_t *pxProfile);
+static void prvClockChanged(void);
+
+/**
+  * @brief  Switch the system to a clock profile.
+  * @note   Call from a task, or before the scheduler is started.  Must not be
+  *         called from an interrupt.  If a step fails the system is left
+  *         running from the HSI at 16 MHz, with the tick still correct.
+  * @param  eProfile: Profile to switch to.
+  * @retval HAL_OK, or the status of the HAL call that failed.
+  */
+HAL_StatusTypeDef xClockProfileSet(ClockProfile_t eProfile)
+{
+  const ClockProfileConfig_t *pxProfile;
+  RCC_ClkInitTypeDef xClkInit = {0};
+  HAL_StatusTypeDef xStatus;
+  BaseType_t xSchedulerRunning;
+
+  configASSERT(eProfile < CLOCK_PROFILE_COUNT);
+  pxProfile = &xProfiles[eProfile];
+
+  xSchedulerRunning = (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) ? pdTRUE : pdFALSE;
+  if (xSchedulerRunning != pdFALSE)
+  {
+    vTaskSuspendAll();
+  }
+
+  vClockProfileChangingHook(eProfile);
+
+  xStatus = prvSwitchToHSI();
+
+  if ((xStatus == HAL_OK) && (__HAL_PWR_GET_FLAG(PWR_FLAG_ODRDY) != RESET))
+  {
+    xStatus = HAL_PWREx_DisableOverDrive();
+  }
+
+  if (xStatus == HAL_OK)
+  {
+    xStatus = prvConfigurePLL(pxProfile);
+  }
+
+  if (xStatus == HAL_OK)
+  {
+    xClkInit.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
+                       | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    xClkInit.SYSCLKSource = (pxProfile->ulPLLN != 0U) ? RCC_SYSCLKSOURCE_PLLCLK : RCC_SYSCLKSOURCE_HSI;
+    xClkInit.AHBCLKDivider = RCC_SYSCLK_DIV1;
+    xClkInit.APB1CLKDivider = pxProfile->ulAPB1Divider;
+    xClkInit.APB2CLKDivider = pxProfile->ulAPB2Divider;
+
+    xStatus = HAL_RCC_ClockConfig(&xClkInit, pxProfile->ulFlashLatency);
+    prvClockChanged();
+  }
+
+  if (xStatus == HAL_OK)
+  {
+    vClockProfileChangedHook(eProfile);
+  }
+
+  if (xSchedulerRunning != pdFALSE)
+  {
+    (void)xTaskResumeAll();
+  }
+
+  return xStatus;
+}
+
+/**
+  * @brief  Find the profile the system is running.
+  * @retval The profile whose SYSCLK matches SystemCoreClock, or
+  *         CLOCK_PROFILE_NONE.
+  */
+ClockProfile_t eClockProfileGet(void)
+{
+  uint32_t ulProfile;
+
+  for (ulProfile = 0U; ulProfile < (uint32_t)CLOCK_PROFILE_COUNT; ulProfile++)
+  {
+    if (xProfiles[ulProfile].ulSysclkHz == SystemCoreClock)
+    {
+      break;
+    }
+  }
+
+  return (ClockProfile_t)ulProfile;
+}
+
+/**
+  * @brief  Called by xClockProfileSet() before the clocks are touched, with
+  *         the scheduler suspended, so must not block.  Let any peripheral
+  *         transfer in progress finish here, for example with
+  *         vClockProfileUartWaitIdle(), as it would be corrupted by the
+  *         change of bus clock.
+  * @note   This function should not be modified, when the callback is
+  *         needed, vClockProfileChangingHook() could be implemented in the
+  *         user file.
+  * @param  eProfile: Profile about to be switched to.
+  * @retval None
+  */
+__weak void vClockProfileChangingHook(ClockProfile_t eProfile)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(eProfile);
+}
+
+/**
+  * @brief  Called by xClockProfileSet() after a successful switch, with the
+  *         scheduler still suspended, so must not block.  Bring the timing of
+  *         any peripheral that depends on a bus clock in line here.
+  * @note   A task may have been suspended part way through a transfer on the
+  *         peripheral, with its handle locked and its state busy.  Only
+  *         rewrite the clock derived registers, for example with
+  *         vClockProfileUartRetune(); do not call HAL_xxx_Init() or anything
+  *         else that resets the handle or disables the peripheral.
+  * @note   This function should not be modified, when the callback is
+  *         needed, vClockProfileChangedHook() could be implemented in the
+  *         user file.
+  * @param  eProfile: Profile now running.
+  * @retval None
+  */
+__weak void vClockProfileChangedHook(ClockProfile_t eProfile)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(eProfile);
+}
+
+#ifdef HAL_UART_MODULE_ENABLED
+/**
+  * @brief  Wait for the byte a UART is sending, if any, to leave the shift
+  *         register.  For vClockProfileChangingHook().  With the scheduler
+  *         suspended no task can hand the UART another byte, so once TC is
+  *         set the line stays idle until the switch is over.
+  * @param  huart: UART handle.  Only the instance is used.
+  * @retval None
+  */
+void vClockProfileUartWaitIdle(UART_HandleTypeDef *huart)
+{
+  uint32_t ulStart = HAL_GetTick();
+
+  while ((__HAL_UART_GET_FLAG(huart, UART_FLAG_TC) == RESET)
+         && ((HAL_GetTick() - ulStart) < CLOCK_PROFILE_UART_IDLE_TIMEOUT))
+  {
+  }
+}
+
+/**
+  * @brief  Recompute a UART's baud rate divider for the bus clock now
+  *         running, as HAL_UART_Init() would, writing BRR and nothing else.
+  *         For vClockProfileChangedHook().  The handle's state and lock are
+  *         left alone, so a task that was in HAL_UART_Transmit() carries on
+  *         at the same baud rate.
+  * @param  huart: UART handle, as initialised by HAL_UART_Init().
+  * @retval None
+  */
+void vClockProfileUartRetune(UART_HandleTypeDef *huart)
+{
+  uint32_t ulPclk;
+
+#if defined(USART6)
+  if ((huart->Instance == USART1) || (huart->Instance == USART6))
+#else
+  if (huart->Instance == USART1)
+#endif
+  {
+    ulPclk = HAL_RCC_GetPCLK2Freq();
+  }
+  else
+  {
+    ulPclk = HAL_RCC_GetPCLK1Freq();
+  }
+
+  if (huart->Init.OverSampling == UART_OVERSAMPLING_8)
+  {
+    huart->Instance->BRR = UART_BRR_SAMPLING8(ulPclk, huart->Init.BaudRate);
+  }
+  else
+  {
+    huart->Instance->BRR = UART_BRR_SAMPLING16(ulPclk, huart->Init.BaudRate);
+  }
+}
+#endif /* HAL_UART_MODULE_ENABLED */
+
+/**
+  * @brief  Run SYSCLK from the HSI, with the buses undivided and the flash
+  *         wait states left as they are.
+  * @retval HAL status.
+  */
+static HAL_StatusTypeDef prvSwitchToHSI(void)
+{
+  RCC_OscInitTypeDef xOscInit = {0};
+  RCC_ClkInitTypeDef xClkInit = {0};
+  HAL_StatusTypeDef xStatus;
+
+  xOscInit.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+  xOscInit.HSIState = RCC_HSI_ON;
+  xOscInit.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+  xOscInit.PLL.PLLState = RCC_PLL_NONE;
+  xStatus = HAL_RCC_OscConfig(&xOscInit);
+
+  if (xStatus == HAL_OK)
+  {
+    xClkInit.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
+                       | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    xClkInit.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+    xClkInit.AHBCLKDivider = RCC_SYSCLK_DIV1;
+    xClkInit.APB1CLKDivider = RCC_HCLK_DIV1;
+    xClkInit.APB2CLKDivider = RCC_HCLK_DIV1;
+
+    xStatus = HAL_RCC_ClockConfig(&xClkInit, __HAL_FLASH_GET_LATENCY());
+    prvClockChanged();
+  }
+
+  return xStatus;
+}
+
+/**
+  * @brief  Program the PLL and the regulator for a profile.  SYSCLK must be
+  *         running from the HSI, with over-drive off.
+  * @param  pxProfile: Profile to prepare for.
+  * @retval HAL status.
+  */
+static HAL_StatusTypeDef prvConfigurePLL(const ClockProfileConfig_t *pxProfile)
+{
+  RCC_OscInitTypeDef xOscInit = {0};
+  HAL_StatusTypeDef xStatus;
+
+  xOscInit.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+
+  if (pxProfile->ulPLLN == 0U)
+  {
+    /* With the PLL off the regulator runs in scale 3 whatever VOS holds. */
+    xOscInit.PLL.PLLState = RCC_PLL_OFF;
+    xStatus = HAL_RCC_OscConfig(&xOscInit);
+    __HAL_PWR_VOLTAGESCALING_CONFIG(pxProfile->ulVoltageScale);
+    return xStatus;
+  }
+
+  xOscInit.PLL.PLLState = RCC_PLL_ON;
+  xOscInit.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+  xOscInit.PLL.PLLM = CLOCK_PROFILE_PLLM;
+  xOscInit.PLL.PLLN = pxProfile->ulPLLN;
+  xOscInit.PLL.PLLP = RCC_PLLP_DIV2;
+  xOscInit.PLL.PLLQ = pxProfile->ulPLLQ;
+  xStatus = HAL_RCC_OscConfig(&xOscInit);
+
+  /* Takes effect once the PLL has relocked, which this waits for. */
+  if (xStatus == HAL_OK)
+  {
+    xStatus = HAL_PWREx_ControlVoltageScaling(pxProfile->ulVoltageScale);
+  }
+
+  if ((xStatus == HAL_OK) && (pxProfile->ulOverDrive != 0U))
+  {
+    xStatus = HAL_PWREx_EnableOverDrive();
+  }
+
+  return xStatus;
+}
+
+/**
+  * @brief  Bring everything timed from the core or bus clocks in line with
+  *         a new SystemCoreClock.  The HAL time base has already been
+  *         restarted by HAL_RCC_ClockConfig().
+  * @retval None
+  */
+static void prvClockChanged(void)
+{
+  vPortRecalibrateTimerInterrupt();
+
+#if (configUSE_HRTIMER == 1)
+  vHRTimerClockChanged();
+#endif
+
+#if (configUSE_TRACE_RECORDER == 1)
+  vTraceRecorderClockChanged();
+#endif
+}
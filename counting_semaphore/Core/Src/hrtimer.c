@@ -0,0 +1,507 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    hrtimer.c
+  * @brief   Microsecond delays and timeouts for FreeRTOS tasks, driven by a
+  *          free-running 32-bit hardware timer (TIM5).
+  ******************************************************************************
+  * @attention
+  *
+  * Each waiting task places a waiter on its own stack and links it into a
+  * list sorted by deadline.  Compare channel 1 is always programmed with the
+  * earliest deadline.  When it matches, the interrupt removes the task from
+  * the Blocked state with xTaskAbortDelayFromISR(), so the call the task
+  * blocked in returns exactly as if its timeout had expired.
+  *
+  * A deadline can pass before the task has actually blocked, either because
+  * it was preempted on the way or because the scheduler is suspended part
+  * way into blocking.  The waiter is then marked expired, which stops the
+  * task blocking again if it has not yet worked out its block time, and
+  * stays in the list to be looked at again HRTIMER_RETRY_US later, and then
+  * at doubling intervals up to a tick, until the task has blocked and can be
+  * woken or has stopped waiting.  The deadline itself is kept, so the
+  * retries never make the wait look longer to the task.
+  *
+  * A waiter lives on its task's stack, so vHRTimerTaskDeleted() must be
+  * called from vApplicationTaskDeleteHook() to unlink the waiters of a task
+  * deleted while waiting.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "hrtimer.h"
+#include "stm32f4xx_hal.h"
+
+#if (configUSE_HRTIMER == 1)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct HRTimerWaiter
+{
+  struct HRTimerWaiter *pxNext;
+  TaskHandle_t xTask;
+  uint32_t ulDeadline;
+  uint32_t ulCompare;         /* When the interrupt next looks at the waiter. */
+  uint32_t ulRetryUs;
+  volatile BaseType_t xExpired;
+} HRTimerWaiter_t;
+
+/* Private define ------------------------------------------------------------*/
+#define HRTIMER_TIM               TIM5
+#define HRTIMER_IRQn              TIM5_IRQn
+#define HRTIMER_COUNTER_HZ        1000000UL
+#define HRTIMER_RETRY_US          5UL
+#define HRTIMER_US_PER_TICK       (HRTIMER_COUNTER_HZ / configTICK_RATE_HZ)
+#define HRTIMER_RETRY_MAX_US      HRTIMER_US_PER_TICK
+
+/* Private macro -------------------------------------------------------------*/
+#define hrtimerDEADLINE_REACHED(ulDeadline) \
+  ((int32_t)((ulDeadline) - HRTIMER_TIM->CNT) <= 0)
+
+/* Private variables ---------------------------------------------------------*/
+/* Waiters sorted by ulCompare.  Modified by tasks inside a critical section and
+   by the TIM5 interrupt, which critical sections mask. */
+static HRTimerWaiter_t *pxWaiterList = NULL;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t prvTimerPrescaler(void);
+static void prvInsertWaiter(HRTimerWaiter_t *pxWaiter);
+static void prvProgramCompare(void);
+static BaseType_t prvArmWaiter(HRTimerWaiter_t *pxWaiter, uint32_t ulTimeoutUs);
+static TickType_t prvBackstopTicks(const HRTimerWaiter_t *pxWaiter);
+static BaseType_t prvWaiterPending(const HRTimerWaiter_t *pxWaiter);
+static void prvCancelWaiter(HRTimerWaiter_t *pxWaiter);
+
+/**
+  * @brief  Start TIM5 as a free-running 1 MHz counter and enable its compare
+  *         interrupt.  Called from vApplicationGetIdleTaskMemory() when the
+  *         scheduler starts; call it earlier, after the system clock has been
+  *         configured, to use vTaskDelayUs() before then.  Does nothing if
+  *         the counter is already running.
+  * @retval None
+  */
+void vHRTimerInit(void)
+{
+  __HAL_RCC_TIM5_CLK_ENABLE();
+
+  if ((HRTIMER_TIM->CR1 & TIM_CR1_CEN) != 0UL)
+  {
+    return;
+  }
+
+  HRTIMER_TIM->CR1 = 0UL;
+  HRTIMER_TIM->DIER = 0UL;
+  HRTIMER_TIM->PSC = prvTimerPrescaler();
+  HRTIMER_TIM->ARR = 0xFFFFFFFFUL;
+  HRTIMER_TIM->CCMR1 = 0UL;
+  HRTIMER_TIM->CNT = 0UL;
+
+  /* Load the prescaler now rather than at the first overflow. */
+  HRTIMER_TIM->EGR = TIM_EGR_UG;
+  HRTIMER_TIM->SR = 0UL;
+
+  HAL_NVIC_SetPriority(HRTIMER_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 0U);
+  HAL_NVIC_EnableIRQ(HRTIMER_IRQn);
+
+  HRTIMER_TIM->CR1 = TIM_CR1_CEN;
+}
+
+/**
+  * @brief  Reload the TIM5 prescaler after the APB1 clock has changed, so the
+  *         counter keeps counting microseconds.  The count carries on from
+  *         where it was, so deadlines already armed stay valid.
+  * @note   Call after the new clock configuration is in place.  Does
+  *         nothing if vHRTimerInit() has not been called yet.
+  * @retval None
+  */
+void vHRTimerClockChanged(void)
+{
+  UBaseType_t uxSavedInterruptStatus;
+  uint32_t ulPrescaler, ulCount;
+
+  if ((HRTIMER_TIM->CR1 & TIM_CR1_CEN) == 0UL)
+  {
+    return;
+  }
+
+  ulPrescaler = prvTimerPrescaler();
+
+  uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+  {
+    /* The update event that loads the prescaler also clears the counter, so
+       put the count back straight after it. */
+    ulCount = HRTIMER_TIM->CNT;
+    HRTIMER_TIM->PSC = ulPrescaler;
+    HRTIMER_TIM->EGR = TIM_EGR_UG;
+    HRTIMER_TIM->CNT = ulCount;
+    HRTIMER_TIM->SR = ~TIM_SR_UIF;
+  }
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+  * @brief  Read the free-running microsecond counter.  Wraps every 2^32 us.
+  * @retval Current time in microseconds.
+  */
+uint32_t ulHRTimerGetTimeUs(void)
+{
+  return HRTIMER_TIM->CNT;
+}
+
+/**
+  * @brief  Delay the calling task for at least ulDelayUs microseconds.
+  * @note   Short delays, and delays before the scheduler has started, are
+  *         busy-waited.  Longer ones block the task.
+  * @param  ulDelayUs: Delay in microseconds, at most HRTIMER_MAX_TIMEOUT_US.
+  * @retval None
+  */
+void vTaskDelayUs(uint32_t ulDelayUs)
+{
+  HRTimerWaiter_t xWaiter;
+  uint32_t ulDeadline;
+
+  configASSERT(ulDelayUs <= HRTIMER_MAX_TIMEOUT_US);
+
+  if ((ulDelayUs < HRTIMER_BUSY_WAIT_US) || (prvArmWaiter(&xWaiter, ulDelayUs) == pdFALSE))
+  {
+    /* The counter would never reach the deadline if it were not running. */
+    configASSERT((HRTIMER_TIM->CR1 & TIM_CR1_CEN) != 0UL);
+
+    ulDeadline = HRTIMER_TIM->CNT + ulDelayUs;
+    while (!hrtimerDEADLINE_REACHED(ulDeadline))
+    {
+    }
+    return;
+  }
+
+  do
+  {
+    vTaskDelay(prvBackstopTicks(&xWaiter));
+  } while (prvWaiterPending(&xWaiter) != pdFALSE);
+
+  prvCancelWaiter(&xWaiter);
+}
+
+/**
+  * @brief  xQueueReceive() with a timeout in microseconds.
+  * @param  xQueue: Queue to receive from.
+  * @param  pvBuffer: Buffer the received item is copied into.
+  * @param  ulTimeoutUs: Timeout in microseconds, or HRTIMER_WAIT_FOREVER.
+  * @retval pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+  */
+BaseType_t xQueueReceiveUs(QueueHandle_t xQueue, void * const pvBuffer, uint32_t ulTimeoutUs)
+{
+  HRTimerWaiter_t xWaiter;
+  BaseType_t xReturn;
+
+  if (ulTimeoutUs == HRTIMER_WAIT_FOREVER)
+  {
+    return xQueueReceive(xQueue, pvBuffer, portMAX_DELAY);
+  }
+
+  if (prvArmWaiter(&xWaiter, ulTimeoutUs) == pdFALSE)
+  {
+    return xQueueReceive(xQueue, pvBuffer, 0);
+  }
+
+  do
+  {
+    xReturn = xQueueReceive(xQueue, pvBuffer, prvBackstopTicks(&xWaiter));
+  } while ((xReturn != pdPASS) && (prvWaiterPending(&xWaiter) != pdFALSE));
+
+  prvCancelWaiter(&xWaiter);
+
+  return xReturn;
+}
+
+/**
+  * @brief  xQueueSend() with a timeout in microseconds.
+  * @param  xQueue: Queue to send to.
+  * @param  pvItemToQueue: Item to copy into the queue.
+  * @param  ulTimeoutUs: Timeout in microseconds, or HRTIMER_WAIT_FOREVER.
+  * @retval pdPASS if the item was queued, otherwise errQUEUE_FULL.
+  */
+BaseType_t xQueueSendUs(QueueHandle_t xQueue, const void * const pvItemToQueue, uint32_t ulTimeoutUs)
+{
+  HRTimerWaiter_t xWaiter;
+  BaseType_t xReturn;
+
+  if (ulTimeoutUs == HRTIMER_WAIT_FOREVER)
+  {
+    return xQueueSend(xQueue, pvItemToQueue, portMAX_DELAY);
+  }
+
+  if (prvArmWaiter(&xWaiter, ulTimeoutUs) == pdFALSE)
+  {
+    return xQueueSend(xQueue, pvItemToQueue, 0);
+  }
+
+  do
+  {
+    xReturn = xQueueSend(xQueue, pvItemToQueue, prvBackstopTicks(&xWaiter));
+  } while ((xReturn != pdPASS) && (prvWaiterPending(&xWaiter) != pdFALSE));
+
+  prvCancelWaiter(&xWaiter);
+
+  return xReturn;
+}
+
+/**
+  * @brief  xSemaphoreTake() with a timeout in microseconds.  Also works for
+  *         mutexes, including priority inheritance.
+  * @param  xSemaphore: Semaphore or mutex to take.
+  * @param  ulTimeoutUs: Timeout in microseconds, or HRTIMER_WAIT_FOREVER.
+  * @retval pdPASS if the semaphore was obtained, otherwise pdFAIL.
+  */
+BaseType_t xSemaphoreTakeUs(SemaphoreHandle_t xSemaphore, uint32_t ulTimeoutUs)
+{
+  HRTimerWaiter_t xWaiter;
+  BaseType_t xReturn;
+
+  if (ulTimeoutUs == HRTIMER_WAIT_FOREVER)
+  {
+    return xSemaphoreTake(xSemaphore, portMAX_DELAY);
+  }
+
+  if (prvArmWaiter(&xWaiter, ulTimeoutUs) == pdFALSE)
+  {
+    return xSemaphoreTake(xSemaphore, 0);
+  }
+
+  do
+  {
+    xReturn = xSemaphoreTake(xSemaphore, prvBackstopTicks(&xWaiter));
+  } while ((xReturn != pdPASS) && (prvWaiterPending(&xWaiter) != pdFALSE));
+
+  prvCancelWaiter(&xWaiter);
+
+  return xReturn;
+}
+
+/**
+  * @brief  TIM5 capture/compare interrupt: wake every task whose deadline has
+  *         been reached.
+  * @retval None
+  */
+void TIM5_IRQHandler(void)
+{
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  HRTimerWaiter_t *pxWaiter;
+
+  HRTIMER_TIM->SR = ~(uint32_t)TIM_SR_CC1IF;
+
+  while ((pxWaiterList != NULL) && hrtimerDEADLINE_REACHED(pxWaiterList->ulCompare))
+  {
+    pxWaiter = pxWaiterList;
+    pxWaiterList = pxWaiter->pxNext;
+    pxWaiter->xExpired = pdTRUE;
+
+    if (xTaskAbortDelayFromISR(pxWaiter->xTask, &xHigherPriorityTaskWoken) != pdFAIL)
+    {
+      pxWaiter->pxNext = NULL;
+    }
+    else
+    {
+      /* The task has not blocked yet: it was preempted on its way, or is
+         part way in with the scheduler suspended.  The flag stops it
+         blocking if it has not worked out its block time yet, but it may
+         already have, so look again later, backing off each time so a long
+         wait costs few interrupts.  The waiter is removed when the task
+         stops waiting. */
+      pxWaiter->ulCompare = HRTIMER_TIM->CNT + pxWaiter->ulRetryUs;
+      if (pxWaiter->ulRetryUs < HRTIMER_RETRY_MAX_US)
+      {
+        pxWaiter->ulRetryUs *= 2UL;
+      }
+      prvInsertWaiter(pxWaiter);
+    }
+  }
+
+  prvProgramCompare();
+
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+  * @brief  Prescaler that divides the TIM5 kernel clock down to
+  *         HRTIMER_COUNTER_HZ.
+  * @retval Value for the PSC register.
+  */
+static uint32_t prvTimerPrescaler(void)
+{
+  uint32_t ulTimerClock;
+
+  /* TIM5 sits on APB1.  Its kernel clock is twice PCLK1 whenever the APB1
+     prescaler divides. */
+  ulTimerClock = HAL_RCC_GetPCLK1Freq();
+  if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+  {
+    ulTimerClock *= 2UL;
+  }
+
+  return (ulTimerClock / HRTIMER_COUNTER_HZ) - 1UL;
+}
+
+/**
+  * @brief  Link a waiter into the list in ulCompare order.  Called with the
+  *         TIM5 interrupt masked.
+  * @param  pxWaiter: Waiter to insert.
+  * @retval None
+  */
+static void prvInsertWaiter(HRTimerWaiter_t *pxWaiter)
+{
+  HRTimerWaiter_t **ppxLink = &pxWaiterList;
+
+  while ((*ppxLink != NULL) && ((int32_t)((*ppxLink)->ulCompare - pxWaiter->ulCompare) <= 0))
+  {
+    ppxLink = &((*ppxLink)->pxNext);
+  }
+
+  pxWaiter->pxNext = *ppxLink;
+  *ppxLink = pxWaiter;
+}
+
+/**
+  * @brief  Program compare channel 1 with the earliest ulCompare, or disable
+  *         the compare interrupt if nothing is waiting.  Called with the TIM5
+  *         interrupt masked.
+  * @retval None
+  */
+static void prvProgramCompare(void)
+{
+  if (pxWaiterList == NULL)
+  {
+    HRTIMER_TIM->DIER &= ~TIM_DIER_CC1IE;
+    return;
+  }
+
+  HRTIMER_TIM->CCR1 = pxWaiterList->ulCompare;
+  HRTIMER_TIM->DIER |= TIM_DIER_CC1IE;
+
+  /* The counter may already have passed the compare value while it was
+     being written, in which case no match would occur until the counter
+     wraps. */
+  if (hrtimerDEADLINE_REACHED(pxWaiterList->ulCompare))
+  {
+    HRTIMER_TIM->EGR = TIM_EGR_CC1G;
+  }
+}
+
+/**
+  * @brief  Arm a waiter for the calling task.
+  * @param  pxWaiter: Waiter, normally on the caller's stack.
+  * @param  ulTimeoutUs: Timeout in microseconds.
+  * @retval pdFALSE if there is nothing to wait for, because the timeout is
+  *         zero or the scheduler is not running.
+  */
+static BaseType_t prvArmWaiter(HRTimerWaiter_t *pxWaiter, uint32_t ulTimeoutUs)
+{
+  configASSERT(ulTimeoutUs <= HRTIMER_MAX_TIMEOUT_US);
+  configASSERT((HRTIMER_TIM->CR1 & TIM_CR1_CEN) != 0UL);
+
+  if ((ulTimeoutUs == 0UL) || (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING))
+  {
+    return pdFALSE;
+  }
+
+  pxWaiter->xTask = xTaskGetCurrentTaskHandle();
+  pxWaiter->ulRetryUs = HRTIMER_RETRY_US;
+  pxWaiter->xExpired = pdFALSE;
+
+  taskENTER_CRITICAL();
+  {
+    pxWaiter->ulDeadline = HRTIMER_TIM->CNT + ulTimeoutUs;
+    pxWaiter->ulCompare = pxWaiter->ulDeadline;
+    prvInsertWaiter(pxWaiter);
+    prvProgramCompare();
+  }
+  taskEXIT_CRITICAL();
+
+  return pdTRUE;
+}
+
+/**
+  * @brief  Tick timeout to block with.  The compare interrupt normally ends
+  *         the wait first; this only bounds the wait should it not.
+  * @param  pxWaiter: Armed waiter.
+  * @retval Block time in ticks, 0 once the waiter has expired.
+  */
+static TickType_t prvBackstopTicks(const HRTimerWaiter_t *pxWaiter)
+{
+  int32_t lRemaining = (int32_t)(pxWaiter->ulDeadline - HRTIMER_TIM->CNT);
+
+  if ((pxWaiter->xExpired != pdFALSE) || (lRemaining <= 0))
+  {
+    return (TickType_t)0;
+  }
+
+  return (TickType_t)((uint32_t)lRemaining / HRTIMER_US_PER_TICK) + (TickType_t)2;
+}
+
+/**
+  * @brief  Whether the caller should keep waiting.
+  * @param  pxWaiter: Armed waiter.
+  * @retval pdFALSE once the deadline has been reached.
+  */
+static BaseType_t prvWaiterPending(const HRTimerWaiter_t *pxWaiter)
+{
+  if ((pxWaiter->xExpired != pdFALSE) || hrtimerDEADLINE_REACHED(pxWaiter->ulDeadline))
+  {
+    return pdFALSE;
+  }
+
+  return pdTRUE;
+}
+
+/**
+  * @brief  Unlink the waiters of a task that is being deleted.  Call from
+  *         vApplicationTaskDeleteHook(), which the kernel calls from inside
+  *         a critical section, so the TIM5 interrupt is masked.
+  * @param  xTask: Task being deleted.
+  * @retval None
+  */
+void vHRTimerTaskDeleted(TaskHandle_t xTask)
+{
+  HRTimerWaiter_t **ppxLink = &pxWaiterList;
+
+  while (*ppxLink != NULL)
+  {
+    if ((*ppxLink)->xTask == xTask)
+    {
+      *ppxLink = (*ppxLink)->pxNext;
+    }
+    else
+    {
+      ppxLink = &((*ppxLink)->pxNext);
+    }
+  }
+
+  prvProgramCompare();
+}
+
+/**
+  * @brief  Remove a waiter from the list if the interrupt has not already.
+  * @param  pxWaiter: Armed waiter.
+  * @retval None
+  */
+static void prvCancelWaiter(HRTimerWaiter_t *pxWaiter)
+{
+  HRTimerWaiter_t **ppxLink;
+
+  taskENTER_CRITICAL();
+  {
+    for (ppxLink = &pxWaiterList; *ppxLink != NULL; ppxLink = &((*ppxLink)->pxNext))
+    {
+      if (*ppxLink == pxWaiter)
+      {
+        *ppxLink = pxWaiter->pxNext;
+        prvProgramCompare();
+        break;
+      }
+    }
+  }
+  taskEXIT_CRITICAL();
+}
+
+#endif /* configUSE_HRTIMER */
@@ -32,6 +32,8 @@
 
 #include "stdlib.h"
 #include "string.h"
+#include "task_stacks.h"
+#include "clock_profile.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -139,10 +141,10 @@ int main(void)
 
   //create Tasks
 
-  xTaskCreate(HPT_TASK, "HPT", 128, NULL, 3, &HPThandler);
-  xTaskCreate(MPT_TASK, "MPT", 128, NULL, 2, &MPThandler);
-  xTaskCreate(LPT_TASK, "LPT", 128, NULL, 1, &LPThandler);
-  xTaskCreate(VLPT_TASK, "VLPT", 128, NULL, 0, &VLPThandler);
+  xTaskCreate(HPT_TASK, "HPT", TASK_STACK_WORDS_HPT_TASK, NULL, 3, &HPThandler);
+  xTaskCreate(MPT_TASK, "MPT", TASK_STACK_WORDS_MPT_TASK, NULL, 2, &MPThandler);
+  xTaskCreate(LPT_TASK, "LPT", TASK_STACK_WORDS_LPT_TASK, NULL, 1, &LPThandler);
+  xTaskCreate(VLPT_TASK, "VLPT", TASK_STACK_WORDS_VLPT_TASK, NULL, 0, &VLPThandler);
 
   vTaskStartScheduler();
 
@@ -442,6 +444,32 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 	}
 }
 
+/**
+  * @brief  Let the byte being sent on the UART finish before the bus clock
+  *         changes under it.
+  * @param  eProfile: Profile about to be switched to.
+  * @retval None
+  */
+void vClockProfileChangingHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartWaitIdle(&huart1);
+}
+
+/**
+  * @brief  Recompute the UART baud rate divider for the bus clock of the new
+  *         clock profile.  A task may be part way through
+  *         HAL_UART_Transmit(), so only BRR is rewritten.
+  * @param  eProfile: Profile now running.
+  * @retval None
+  */
+void vClockProfileChangedHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartRetune(&huart1);
+}
 
 /* USER CODE END 4 */
 
@@ -31,6 +31,8 @@
 
 #include "string.h"
 #include "stdio.h"
+#include "task_stacks.h"
+#include "clock_profile.h"
 
 
 /* USER CODE END Includes */
@@ -122,7 +124,13 @@ int main(void)
   MX_USART1_UART_Init();
   /* USER CODE BEGIN 2 */
 
+#if ( configUSE_TRACE_RECORDER == 1 )
+  /* Record the priority inversion, before the objects to trace are created. */
+  vTraceRecorderStart();
+#endif
+
   SimpleMutex = xSemaphoreCreateMutex();
+  vQueueAddToRegistry(SimpleMutex, "SimpleMutex");
 
   if(SimpleMutex != NULL)
   {
@@ -131,6 +139,7 @@ int main(void)
   }
 
   BinSemaphore = xSemaphoreCreateBinary();
+  vQueueAddToRegistry(BinSemaphore, "BinSemaphore");
 
   if(BinSemaphore != NULL)
   {
@@ -142,9 +151,9 @@ int main(void)
 
   ///create tasks
 
-  xTaskCreate(HPT_Task, "HPT", 128, NULL, 3, &HPT_Handler);
-  xTaskCreate(MPT_Task, "MPT", 128, NULL, 2, &MPT_Handler);
-  xTaskCreate(LPT_Task, "LPT", 128, NULL, 1, &LPT_Handler);
+  xTaskCreate(HPT_Task, "HPT", TASK_STACK_WORDS_HPT_Task, NULL, 3, &HPT_Handler);
+  xTaskCreate(MPT_Task, "MPT", TASK_STACK_WORDS_MPT_Task, NULL, 2, &MPT_Handler);
+  xTaskCreate(LPT_Task, "LPT", TASK_STACK_WORDS_LPT_Task, NULL, 1, &LPT_Handler);
 
   vTaskStartScheduler();
 
@@ -347,6 +356,33 @@ void LPT_Task(void *argument)
 	}
 }
 
+/**
+  * @brief  Let the byte being sent on the UART finish before the bus clock
+  *         changes under it.
+  * @param  eProfile: Profile about to be switched to.
+  * @retval None
+  */
+void vClockProfileChangingHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartWaitIdle(&huart1);
+}
+
+/**
+  * @brief  Recompute the UART baud rate divider for the bus clock of the new
+  *         clock profile.  A task may be part way through
+  *         HAL_UART_Transmit(), so only BRR is rewritten.
+  * @param  eProfile: Profile now running.
+  * @retval None
+  */
+void vClockProfileChangedHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartRetune(&huart1);
+}
+
 /* USER CODE END 4 */
 
 
@@ -41,7 +41,7 @@ TIM_HandleTypeDef        htim1;
 HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
 {
   RCC_ClkInitTypeDef    clkconfig;
-  uint32_t              uwTimclock = 0U;
+  uint32_t              uwTimclock, uwAPB2Prescaler = 0U;
 
   uint32_t              uwPrescalerValue = 0U;
   uint32_t              pFLatency;
@@ -53,8 +53,17 @@ HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
   /* Get clock configuration */
   HAL_RCC_GetClockConfig(&clkconfig, &pFLatency);
 
+  /* Get APB2 prescaler */
+  uwAPB2Prescaler = clkconfig.APB2CLKDivider;
   /* Compute TIM1 clock */
-      uwTimclock = HAL_RCC_GetPCLK2Freq();
+  if (uwAPB2Prescaler == RCC_HCLK_DIV1)
+  {
+    uwTimclock = HAL_RCC_GetPCLK2Freq();
+  }
+  else
+  {
+    uwTimclock = 2UL * HAL_RCC_GetPCLK2Freq();
+  }
 
   /* Compute the prescaler value to have TIM1 counter clock equal to 1MHz */
   uwPrescalerValue = (uint32_t) ((uwTimclock / 1000000U) - 1U);
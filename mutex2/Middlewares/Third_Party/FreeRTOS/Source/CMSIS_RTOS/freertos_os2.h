@@ -0,0 +1,197 @@
+/* --------------------------------------------------------------------------
+ * Project:      CMSIS-RTOS2 API
+ * Title:        freertos_os2.h FreeRTOS specific definitions
+ *
+ * FreeRTOS specific part of the CMSIS-RTOS2 implementation in cmsis_os2.c:
+ * the control block types to size caller supplied memory with, and notes on
+ * how the two CMSIS-RTOS versions work together.
+ *
+ * <b>Caller supplied memory</b>
+ *
+ * Every object can be created without touching the FreeRTOS heap by passing
+ * cb_mem and cb_size in its attributes, together with stack_mem/stack_size
+ * for threads, mp_mem/mp_size for memory pools and mq_mem/mq_size for
+ * message queues.  Size cb_mem with the osStaticXxxDef_t types below, and the
+ * data memory with osMemoryPoolMemSize() and osMessageQueueMemSize().
+ * Memory must either be supplied completely or not at all - an object with,
+ * say, a control block but no stack is not created.
+ *
+ * \code
+ * static osStaticThreadDef_t rx_tcb;
+ * static uint32_t rx_stack[128];
+ * static const osThreadAttr_t rx_attr = {
+ *   .name = "rx",
+ *   .cb_mem = &rx_tcb, .cb_size = sizeof(rx_tcb),
+ *   .stack_mem = rx_stack, .stack_size = sizeof(rx_stack),
+ *   .priority = osPriorityAboveNormal
+ * };
+ * \endcode
+ *
+ * <b>Zero-copy messages</b>
+ *
+ * osMessageQueuePut() and osMessageQueueGet() copy the message into and out of
+ * the queue, as the API requires.  The osMessageRefQueue extension below
+ * passes messages without copying them: the sender takes a message block
+ * with osMessageQueueAllocBlock(), fills it in place and queues it with
+ * osMessageQueuePutRef(); the receiver gets the same block from
+ * osMessageQueueGetRef(), works on it where it is and hands it back with
+ * osMessageQueueFreeBlock().  The blocks are an osMemoryPool, so allocating
+ * and freeing them are O(1), and the queue holds one pointer per block, so
+ * only the pointer is ever copied and a put never has to wait for space.
+ *
+ * \code
+ * static osMessageRefQueueId_t rx_q;
+ *
+ * rx_q = osMessageRefQueueNew(4U, sizeof(frame_t), NULL);
+ *
+ * frame_t *f = osMessageQueueAllocBlock(rx_q, osWaitForever);   // sender
+ * f->len = fill(f->data);
+ * osMessageQueuePutRef(rx_q, f);
+ *
+ * frame_t *f;                                                    // receiver
+ * if (osMessageQueueGetRef(rx_q, (void **)&f, osWaitForever) == osOK) {
+ *   handle(f);
+ *   osMessageQueueFreeBlock(rx_q, f);
+ * }
+ * \endcode
+ *
+ * <b>Migrating from CMSIS-RTOS v1</b>
+ *
+ * cmsis_os.c and cmsis_os2.c are built into the same image.  The v1 functions
+ * whose names the v2 API reuses are renamed by cmsis_os.h (osDelay becomes
+ * osDelay_v1 and so on), so each source file includes either cmsis_os.h or
+ * cmsis_os2.h, never both, and can be moved over one at a time:
+ *  - thread, message queue, mutex, semaphore and timer handles are plain
+ *    FreeRTOS handles in both versions, so an object created through one API
+ *    can be passed to the other.  The exceptions are recursive mutexes created
+ *    by osMutexNew(), whose ID has bit 0 set, v2 timers, whose timer ID holds
+ *    the callback, and v1 semaphores built with
+ *    configUSE_CMSIS_FAST_SEMAPHORES.
+ *  - thread flags and v1 signals both use task notification index 0, so
+ *    osThreadFlagsSet() wakes a thread in osSignalWait() and osSignalSet()
+ *    wakes one in osThreadFlagsWait().
+ *  - v2 priorities are grouped in bands of eight (osPriorityLow..Low7 and so
+ *    on), and each band maps to the FreeRTOS priority of the v1 priority with
+ *    the same name, up to configMAX_PRIORITIES - 1.  With configMAX_PRIORITIES
+ *    of 56 or more the v2 priorities map one to one instead.
+ * -------------------------------------------------------------------------- */
+
+#ifndef FREERTOS_OS2_H_
+#define FREERTOS_OS2_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "timers.h"
+
+#include "cmsis_os2.h"
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+/* Timer callback and argument, stored as the FreeRTOS timer ID. */
+typedef struct {
+  osTimerFunc_t func;
+  void         *arg;
+} TimerCallback_t;
+
+/* Free memory pool block, linked through its first word. */
+typedef struct MemPoolBlock_s {
+  struct MemPoolBlock_s *next;
+} MemPoolBlock_t;
+
+/* Memory pool control block. */
+typedef struct {
+  StaticSemaphore_t  sem_cb;  /* Storage for sem when the pool is static      */
+  QueueHandle_t      sem;     /* Counts free blocks, so Alloc can block       */
+  MemPoolBlock_t    *head;    /* Blocks returned by osMemoryPoolFree          */
+  uint8_t           *unused;  /* First block never handed out                 */
+  uint8_t           *mem_arr; /* Block storage                                */
+  uint8_t           *mem_end;
+  uint32_t           bl_sz;   /* Block size, rounded up to a pointer          */
+  uint32_t           bl_cnt;  /* Number of blocks                             */
+  volatile uint32_t  n;       /* Number of blocks allocated                   */
+  const char        *name;
+  uint32_t           flags;   /* MPOOL_DYNAMIC_xxx, see cmsis_os2.c           */
+} MemPool_t;
+
+/* Zero-copy message queue control block: the message blocks and a queue of
+   pointers to the blocks that have been put. */
+typedef struct {
+  MemPool_t          pool;     /* Message blocks                              */
+  StaticQueue_t      queue_cb; /* Storage for queue when the queue is static  */
+  QueueHandle_t      queue;    /* Addresses of the blocks put                 */
+  uint32_t           flags;    /* MPOOL_DYNAMIC_CB if on the FreeRTOS heap    */
+} MessageRefQueue_t;
+
+/* Control block types, for sizing cb_mem. */
+typedef StaticTask_t        osStaticThreadDef_t;
+typedef StaticEventGroup_t  osStaticEventGroupDef_t;
+typedef StaticSemaphore_t   osStaticMutexDef_t;
+typedef StaticSemaphore_t   osStaticSemaphoreDef_t;
+typedef StaticQueue_t       osStaticMessageQDef_t;
+typedef MemPool_t           osStaticMemPoolDef_t;
+typedef MessageRefQueue_t   osStaticMessageRefQDef_t;
+typedef struct {
+  StaticTimer_t   timer;
+  TimerCallback_t callb;
+} osStaticTimerDef_t;
+
+/* Size of a memory pool block, and of the data memory of a memory pool and a
+   message queue. */
+#define osMemoryPoolBlockSize(block_size) \
+  (((uint32_t)(block_size) + (sizeof(void *) - 1U)) & ~(uint32_t)(sizeof(void *) - 1U))
+#define osMemoryPoolMemSize(block_count, block_size) \
+  ((uint32_t)(block_count) * osMemoryPoolBlockSize(block_size))
+#define osMessageQueueMemSize(msg_count, msg_size) \
+  ((uint32_t)(msg_count) * (uint32_t)(msg_size))
+
+/* Size of the data memory of a zero-copy message queue: the message blocks,
+   then a pointer for each of them. */
+#define osMessageRefQueueMemSize(msg_count, msg_size) \
+  (osMemoryPoolMemSize((msg_count), (msg_size)) + osMessageQueueMemSize((msg_count), sizeof(void *)))
+
+/* ==== Zero-copy message queue (extension) ==== */
+
+/* Zero-copy message queue ID, from osMessageRefQueueNew().  It is not a
+   message queue ID, and cannot be passed to the osMessageQueueXxx functions
+   of cmsis_os2.h. */
+typedef void *osMessageRefQueueId_t;
+
+/* Create a zero-copy message queue of msg_count blocks of msg_size bytes.
+   attr is as for osMessageQueueNew(), with cb_mem sized by
+   osStaticMessageRefQDef_t and mq_mem by osMessageRefQueueMemSize().
+   Returns NULL on error, or if called from an ISR. */
+osMessageRefQueueId_t osMessageRefQueueNew (uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr);
+
+/* Take a free message block, waiting up to timeout for one, as
+   osMemoryPoolAlloc().  Returns NULL if there is none. */
+void *osMessageQueueAllocBlock (osMessageRefQueueId_t mq_id, uint32_t timeout);
+
+/* Queue a block taken with osMessageQueueAllocBlock(), without copying it.
+   There is room in the queue for every block, so this does not wait.
+   Returns osErrorParameter if block is not a block of the queue. */
+osStatus_t osMessageQueuePutRef (osMessageRefQueueId_t mq_id, void *block);
+
+/* Get the oldest queued block, waiting up to timeout for one, as
+   osMessageQueueGet().  The receiver owns the block until it frees it. */
+osStatus_t osMessageQueueGetRef (osMessageRefQueueId_t mq_id, void **block, uint32_t timeout);
+
+/* Return a block to the free blocks, as osMemoryPoolFree(). */
+osStatus_t osMessageQueueFreeBlock (osMessageRefQueueId_t mq_id, void *block);
+
+/* Number of blocks queued and not yet got. */
+uint32_t osMessageRefQueueGetCount (osMessageRefQueueId_t mq_id);
+
+/* Delete a zero-copy message queue.  Not callable from an ISR. */
+osStatus_t osMessageRefQueueDelete (osMessageRefQueueId_t mq_id);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* FREERTOS_OS2_H_ */
@@ -56,6 +56,11 @@ extern "C" {
 #define tskMPU_REGION_NORMAL_MEMORY		( 1UL << 3UL )
 #define tskMPU_REGION_DEVICE_MEMORY		( 1UL << 4UL )
 
+/* The index within the array of task notifications used by the notification
+API functions that do not take an index, so by the kernel, stream buffers and
+the CMSIS signal flags. */
+#define tskDEFAULT_INDEX_TO_NOTIFY		( 0 )
+
 /**
  * task. h
  *
@@ -147,6 +152,27 @@ typedef struct xTASK_STATUS
 	configSTACK_DEPTH_TYPE usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with the uxTaskGetCpuStats() and vTaskGetTaskCpuStats() functions to
+return the processor time accounted to each task.  All times are in run time
+counter units, which are core clock cycles when configUSE_DWT_RUN_TIME_COUNTER
+is set to 1. */
+typedef struct xTASK_CPU_STATS
+{
+	TaskHandle_t xHandle;			/* The handle of the task to which the rest of the information in the structure relates. */
+	uint64_t ullTotalTime;			/* The total time the task has spent in the Running state.  64 bits wide so it does not wrap. */
+	uint32_t ulLastSliceTime;		/* The length of the task's most recent uninterrupted period in the Running state. */
+	uint32_t ulMaxSliceTime;		/* The longest uninterrupted period the task has spent in the Running state. */
+	uint32_t ulPreemptions;			/* The number of times the task was switched out without having blocked, suspended or deleted itself. */
+} TaskCpuStats_t;
+
+/* Actions that can be taken when a task exhausts its CPU budget.  See
+vTaskSetCpuBudget(). */
+typedef enum
+{
+	eBudgetDemote = 0,	/* The task runs at configCPU_BUDGET_DEMOTED_PRIORITY until its budget is replenished. */
+	eBudgetSuspend		/* The task is held in the Suspended state until its budget is replenished. */
+} eBudgetAction;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -846,6 +872,168 @@ void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xT
  */
 BaseType_t xTaskAbortDelay( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>BaseType_t xTaskAbortDelayFromISR( TaskHandle_t xTask, BaseType_t *pxHigherPriorityTaskWoken );</pre>
+ *
+ * INCLUDE_xTaskAbortDelay must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * A version of xTaskAbortDelay() that can be called from an interrupt service
+ * routine, for example to end a wait at a time measured by a hardware timer
+ * that is finer grained than the tick.  The task returns from whichever
+ * function placed it into the Blocked state exactly as if its block time had
+ * expired.
+ *
+ * Unlike xTaskAbortDelay(), only a task that is blocked with a finite block
+ * time can be removed from the Blocked state, and the call fails if the
+ * scheduler is suspended when the interrupt executes.  The interrupt is
+ * expected to try again a short time later in that case.
+ *
+ * @param xTask The handle of the task to remove from the Blocked state.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if removing the task from the
+ * Blocked state caused it to preempt the task that was running when the
+ * interrupt occurred, in which case a context switch should be requested
+ * before the interrupt exits.  Can be NULL.
+ *
+ * @return pdPASS if the task was removed from the Blocked state, otherwise
+ * pdFAIL.
+ *
+ * \defgroup xTaskAbortDelayFromISR xTaskAbortDelayFromISR
+ * \ingroup TaskCtrl
+ */
+BaseType_t xTaskAbortDelayFromISR( TaskHandle_t xTask, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskEDFSetParameters( TaskHandle_t xTask, const TickType_t xPeriod, const TickType_t xRelativeDeadline );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Registers a task as a periodic job for the earliest deadline first
+ * scheduling class.  Ready tasks that run at configEDF_PRIORITY are selected
+ * by nearest absolute deadline rather than round robin.  Tasks at any other
+ * priority are scheduled exactly as before, so the EDF band can be placed
+ * between fixed priority tasks that must always preempt it and those it must
+ * always preempt.  A task must run at configEDF_PRIORITY to be scheduled by
+ * deadline - registering the parameters does not change the task's priority.
+ *
+ * The first job is released when this function is called, and must complete
+ * within xRelativeDeadline ticks.  Each subsequent job is released xPeriod
+ * ticks after the previous one - see vTaskEDFWaitForNextPeriod().
+ *
+ * Tasks at configEDF_PRIORITY that have not registered a period are
+ * considered to have no deadline, so only run when no registered task is
+ * ready.
+ *
+ * @param xTask Handle of the task being registered.  Passing NULL registers
+ * the calling task.
+ *
+ * @param xPeriod The time, in ticks, between the releases of successive jobs.
+ * Passing 0 removes the task from deadline scheduling.
+ *
+ * @param xRelativeDeadline The time, in ticks, after its release by which each
+ * job must complete.  Normally less than or equal to xPeriod.
+ *
+ * Example usage:
+   <pre>
+ // Run a control loop every 5 ticks, completing within 4 ticks of each release.
+ void vControlTask( void * pvParameters )
+ {
+	 vTaskEDFSetParameters( NULL, 5, 4 );
+
+	 for( ;; )
+	 {
+		 // Perform the control action here.
+
+		 vTaskEDFWaitForNextPeriod();
+	 }
+ }
+   </pre>
+ * \defgroup vTaskEDFSetParameters vTaskEDFSetParameters
+ * \ingroup TaskCtrl
+ */
+void vTaskEDFSetParameters( TaskHandle_t xTask, const TickType_t xPeriod, const TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskEDFWaitForNextPeriod( void );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Called by a task registered with vTaskEDFSetParameters() to signal that its
+ * current job has completed.  The task blocks until its next job is released,
+ * at which point it becomes ready with the deadline of the new job.  Release
+ * times advance by exactly one period, so the schedule does not drift.  If
+ * the next job has already been released (the task overran) then the task
+ * does not block, but is rescheduled according to its new deadline.
+ *
+ * A job that completes after its deadline is counted - see
+ * uxTaskEDFGetDeadlineMisses().
+ *
+ * \defgroup vTaskEDFWaitForNextPeriod vTaskEDFWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+void vTaskEDFWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskEDFGetDeadlineMisses( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the task being queried.  Passing NULL queries the
+ * calling task.
+ *
+ * @return The number of jobs of the task that have completed after their
+ * absolute deadline since the task was last registered.
+ *
+ * \defgroup uxTaskEDFGetDeadlineMisses uxTaskEDFGetDeadlineMisses
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskEDFGetDeadlineMisses( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskUseFPU( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_TASK_FPU_FLAG must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Marks a task as using the floating point unit.  Only marked tasks can
+ * execute floating point instructions - the FPU is disabled while any other
+ * task is running, so an unmarked task that executes a floating point
+ * instruction causes a usage fault rather than silently acquiring a floating
+ * point context that then has to be saved and restored on every switch.
+ *
+ * Call it on a newly created task before the task first runs, or from the
+ * task itself before it first uses the FPU.  Interrupt service routines must
+ * not use the FPU when configUSE_TASK_FPU_FLAG is 1.
+ *
+ * @param xTask Handle of the task to mark.  Passing NULL marks the calling
+ * task.
+ *
+ * Example usage:
+   <pre>
+ void vDSPTask( void * pvParameters )
+ {
+	 vTaskUseFPU( NULL );
+
+	 for( ;; )
+	 {
+		 // Filtering code using floats goes here.
+	 }
+ }
+   </pre>
+ * \defgroup vTaskUseFPU vTaskUseFPU
+ * \ingroup TaskCtrl
+ */
+void vTaskUseFPU( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask );</pre>
@@ -1771,9 +1959,150 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 */
 uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <PRE>UBaseType_t uxTaskGetCpuStats( TaskCpuStats_t * const pxCpuStatsArray, const UBaseType_t uxArraySize, uint64_t * const pullTotalTime );</PRE>
+ *
+ * configUSE_TASK_CPU_ACCOUNTING must be defined as 1 for this function to be
+ * available.  configUSE_TASK_CPU_ACCOUNTING requires
+ * configGENERATE_RUN_TIME_STATS, and on this port the run time counter can be
+ * provided by the DWT cycle counter by setting configUSE_DWT_RUN_TIME_COUNTER
+ * to 1.
+ *
+ * Populates a TaskCpuStats_t structure for each task in the system.  Unlike
+ * vTaskGetRunTimeStats() the data is returned in binary form, so no string
+ * formatting is performed and the function is cheap enough to call
+ * periodically from application code.  The accounting itself costs a few
+ * instructions per context switch and per tick.
+ *
+ * Times are accumulated at each context switch and each tick interrupt, so the
+ * time of the task that is running when the function is called is up to date
+ * as of the most recent tick.
+ *
+ * @param pxCpuStatsArray A pointer to an array of TaskCpuStats_t structures.
+ * The array must contain at least one TaskCpuStats_t structure for each task
+ * that is under the control of the RTOS.  The number of tasks under the
+ * control of the RTOS can be determined using uxTaskGetNumberOfTasks().
+ *
+ * @param uxArraySize The size of the array pointed to by pxCpuStatsArray.
+ *
+ * @param pullTotalTime If pullTotalTime is not NULL then *pullTotalTime is
+ * set to the total run time accumulated by all tasks, against which the
+ * ullTotalTime of each task can be compared.
+ *
+ * @return The number of TaskCpuStats_t structures that were populated.  This
+ * will be zero if the array is too small.
+ *
+ * \defgroup uxTaskGetCpuStats uxTaskGetCpuStats
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskGetCpuStats( TaskCpuStats_t * const pxCpuStatsArray, const UBaseType_t uxArraySize, uint64_t * const pullTotalTime ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>void vTaskGetTaskCpuStats( TaskHandle_t xTask, TaskCpuStats_t *pxCpuStats );</PRE>
+ *
+ * configUSE_TASK_CPU_ACCOUNTING must be defined as 1 for this function to be
+ * available.
+ *
+ * Populates a TaskCpuStats_t structure for a single task.  See
+ * uxTaskGetCpuStats().
+ *
+ * @param xTask The handle of the task being queried.  Passing NULL queries
+ * the calling task.
+ *
+ * @param pxCpuStats The structure to populate.
+ *
+ * \defgroup vTaskGetTaskCpuStats vTaskGetTaskCpuStats
+ * \ingroup TaskUtils
+ */
+void vTaskGetTaskCpuStats( TaskHandle_t xTask, TaskCpuStats_t *pxCpuStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>void vTaskSetCpuBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xPeriod, eBudgetAction eAction );</PRE>
+ *
+ * configUSE_TASK_CPU_BUDGET must be defined as 1 for this function to be
+ * available.
+ *
+ * Limits the processor time a task can use in each replenishment period.  The
+ * time the task spends in the Running state is charged against its budget as
+ * it is accounted by configUSE_TASK_CPU_ACCOUNTING.  A task that has used all
+ * of its budget is demoted or suspended, at the next tick or the next time it
+ * would be selected to run, and only recovers when the budget is refilled at
+ * the start of its next period.  Higher priority work is therefore never
+ * delayed by more than ulBudget in any xPeriod by the task, no matter how it
+ * behaves.
+ *
+ * Do not change the priority of, suspend or resume a task while it is held
+ * back by its budget, as the change is overridden when the budget is
+ * replenished.
+ *
+ * @param xTask The handle of the task being limited.  Passing NULL limits the
+ * calling task.
+ *
+ * @param ulBudget The processor time, in run time counter units (core clock
+ * cycles when configUSE_DWT_RUN_TIME_COUNTER is set to 1), the task can use in
+ * each period.  Passing 0 removes any budget from the task.
+ *
+ * @param xPeriod The replenishment period in ticks.  Must be greater than 0
+ * if ulBudget is not 0.
+ *
+ * @param eAction eBudgetDemote to run the task at
+ * configCPU_BUDGET_DEMOTED_PRIORITY once its budget is exhausted, or
+ * eBudgetSuspend to stop it from running at all.  eBudgetSuspend requires
+ * INCLUDE_vTaskSuspend to be set to 1.
+ *
+ * Example usage:
+   <pre>
+ // Allow the logging task 2ms of processor time in every 10ms at 180MHz.
+ vTaskSetCpuBudget( xLogTask, 360000UL, pdMS_TO_TICKS( 10 ), eBudgetDemote );
+   </pre>
+ * \defgroup vTaskSetCpuBudget vTaskSetCpuBudget
+ * \ingroup TaskCtrl
+ */
+void vTaskSetCpuBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xPeriod, eBudgetAction eAction ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>uint32_t ulTaskGetCpuBudgetRemaining( TaskHandle_t xTask );</PRE>
+ *
+ * configUSE_TASK_CPU_BUDGET must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask The handle of the task being queried.  Passing NULL queries
+ * the calling task.
+ *
+ * @return The processor time the task can still use in its current period,
+ * or 0 if the task has no budget.
+ *
+ * \defgroup ulTaskGetCpuBudgetRemaining ulTaskGetCpuBudgetRemaining
+ * \ingroup TaskCtrl
+ */
+uint32_t ulTaskGetCpuBudgetRemaining( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>UBaseType_t uxTaskGetCpuBudgetExhaustions( TaskHandle_t xTask );</PRE>
+ *
+ * configUSE_TASK_CPU_BUDGET must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask The handle of the task being queried.  Passing NULL queries
+ * the calling task.
+ *
+ * @return The number of periods in which the task was demoted or suspended
+ * because it used all of its budget, since the budget was last set.
+ *
+ * \defgroup uxTaskGetCpuBudgetExhaustions uxTaskGetCpuBudgetExhaustions
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskGetCpuBudgetExhaustions( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1781,6 +2110,15 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * When configUSE_TASK_NOTIFICATIONS is set to one each task has its own private
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
+ * Each task has an array of configTASK_NOTIFICATION_ARRAY_ENTRIES such
+ * notifications, each with its own value and pending state, so a task can be
+ * sent several independent kinds of notification.  The API functions whose
+ * names end in "Indexed" take the index of the notification to act on.  The
+ * other functions, and the kernel itself, act on index tskDEFAULT_INDEX_TO_NOTIFY
+ * (0), so xTaskNotify() is equivalent to xTaskNotifyIndexed() with
+ * uxIndexToNotify set to 0.  A notification at one index does not unblock a
+ * task waiting at another.
+ *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
  * are a method of sending an event directly to a task without the need for such
@@ -1809,6 +2147,10 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index of the notification within the task's array
+ * of notifications.  Must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ * xTaskNotify() does not have this parameter and always uses index 0.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1850,13 +2192,16 @@ uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
-#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
-#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1865,7 +2210,8 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
  * A version of xTaskNotify() that can be used from an interrupt service routine
- * (ISR).
+ * (ISR).  See xTaskNotify() for the array of notifications each task has, and
+ * for the uxIndexToNotify parameter of xTaskNotifyIndexedFromISR().
  *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
@@ -1941,13 +2287,16 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
-#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
-#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
+ * <PRE>BaseType_t xTaskNotifyWaitIndexed( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1978,6 +2327,11 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn The index of the notification within the calling
+ * task's array of notifications to wait for.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  xTaskNotifyWait() does not have this
+ * parameter and always waits on index 0.
+ *
  * @param ulBitsToClearOnEntry Bits that are set in ulBitsToClearOnEntry value
  * will be cleared in the calling task's notification value before the task
  * checks to see if any notifications are pending, and optionally blocks if no
@@ -2018,11 +2372,14 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( tskDEFAULT_INDEX_TO_NOTIFY, ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+#define xTaskNotifyWaitIndexed( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );</PRE>
+ * <PRE>BaseType_t xTaskNotifyGiveIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2064,11 +2421,13 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyGive xTaskNotifyGive
  * \ingroup TaskNotifications
  */
-#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
 /**
  * task. h
  * <PRE>void vTaskNotifyGiveFromISR( TaskHandle_t xTaskHandle, BaseType_t *pxHigherPriorityTaskWoken );
+ * <PRE>void vTaskNotifyGiveIndexedFromISR( TaskHandle_t xTaskHandle, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken );
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2119,11 +2478,14 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pxHigherPriorityTaskWoken ) )
+#define vTaskNotifyGiveIndexedFromISR( xTaskToNotify, uxIndexToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
+ * <PRE>uint32_t ulTaskNotifyTakeIndexed( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -2167,6 +2529,11 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn The index of the notification within the calling
+ * task's array of notifications to take.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.  ulTaskNotifyTake() does not have
+ * this parameter and always takes index 0.
+ *
  * @param xClearCountOnExit if xClearCountOnExit is pdFALSE then the task's
  * notification value is decremented when the function exits.  In this way the
  * notification value acts like a counting semaphore.  If xClearCountOnExit is
@@ -2188,30 +2555,38 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  * \defgroup ulTaskNotifyTake ulTaskNotifyTake
  * \ingroup TaskNotifications
  */
-uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyTake( xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( xTicksToWait ) )
+#define ulTaskNotifyTakeIndexed( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( uxIndexToWaitOn ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );</pre>
+ * <PRE>BaseType_t xTaskNotifyStateClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear );</pre>
  *
  * If the notification state of the task referenced by the handle xTask is
  * eNotified, then set the task's notification state to eNotWaitingNotification.
  * The task's notification value is not altered.  Set xTask to NULL to clear the
- * notification state of the calling task.
+ * notification state of the calling task.  xTaskNotifyStateClear() acts on
+ * notification index 0, xTaskNotifyStateClearIndexed() on uxIndexToClear.
  *
  * @return pdTRUE if the task's notification state was set to
  * eNotWaitingNotification, otherwise pdFALSE.
  * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyStateClear( xTask ) xTaskGenericNotifyStateClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ) )
+#define xTaskNotifyStateClearIndexed( xTask, uxIndexToClear ) xTaskGenericNotifyStateClear( ( xTask ), ( uxIndexToClear ) )
 
 /**
 * task. h
 * <PRE>uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear );</pre>
+* <PRE>uint32_t ulTaskNotifyValueClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear );</pre>
 *
 * Clears the bits specified by the ulBitsToClear bit mask in the notification
-* value of the task referenced by xTask.
+* value of the task referenced by xTask, at index 0 or, for
+* ulTaskNotifyValueClearIndexed(), at uxIndexToClear.
 *
 * Set ulBitsToClear to 0xffffffff (UINT_MAX on 32-bit architectures) to clear
 * the notification value to 0.  Set ulBitsToClear to 0 to query the task's
@@ -2222,7 +2597,9 @@ BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
 * \defgroup ulTaskNotifyValueClear ulTaskNotifyValueClear
 * \ingroup TaskNotifications
 */
-uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyValueClear( xTask, ulBitsToClear ) ulTaskGenericNotifyValueClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClear ) )
+#define ulTaskNotifyValueClearIndexed( xTask, uxIndexToClear, ulBitsToClear ) ulTaskGenericNotifyValueClear( ( xTask ), ( uxIndexToClear ), ( ulBitsToClear ) )
 
 /**
  * task.h
@@ -2416,6 +2793,23 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTi
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be called
+ * from a critical section within an ISR.
+ *
+ * The same as vTaskRemoveFromUnorderedEventList(), but for event lists that
+ * interrupts access, as the event groups do when
+ * configUSE_EVENT_GROUP_DIRECT_WAKE is set to 1.  If the scheduler is
+ * suspended the task is held pending until it is resumed.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * making the call, otherwise pdFALSE.
+ */
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -2471,6 +2865,14 @@ BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGE
  */
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
 
+/*
+ * Raises the priority of the calling task to the ceiling priority of a mutex
+ * it has just obtained, should the task have a priority less than the ceiling.
+ * The priority is restored by xTaskPriorityDisinherit() when the task no
+ * longer holds any mutexes.
+ */
+void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
 /*
  * Get the uxTCBNumber assigned to the task referenced by the xTask parameter.
  */
@@ -2527,6 +2929,13 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Decrement the mutex held count when a mutex is
+ * given back without entering a critical section, disinheriting any raised
+ * priority.  Returns pdTRUE if a context switch is required.
+ */
+BaseType_t xTaskDecrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critial
  * section.
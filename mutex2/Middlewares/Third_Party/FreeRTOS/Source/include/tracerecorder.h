@@ -0,0 +1,159 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * The trace recorder implements the kernel trace macros by writing an 8 byte,
+ * cycle counter timestamped event into a ring in RAM for each context switch,
+ * queue, semaphore and mutex operation, priority inheritance and interrupt.
+ * Nothing is sent while the application runs.  The recorder is read by halting
+ * the target and dumping xTraceRecorder, for example from GDB:
+ *
+ *     dump binary value trace.bin xTraceRecorder
+ *
+ * and tools/trace_to_perfetto.py converts the dump into a trace that can be
+ * opened in Perfetto or chrome://tracing.  Once the ring is full the oldest
+ * events are overwritten, so the dump always holds the most recent
+ * configTRACE_RECORDER_EVENTS events.
+ *
+ * configUSE_TRACE_RECORDER and configUSE_TRACE_FACILITY must both be set to 1
+ * in FreeRTOSConfig.h for the recorder to be available.  This file is included
+ * by FreeRTOS.h and must not be included directly.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Event codes, held in the ucEvent member of each event.  The host tool must
+be updated if these change. */
+#define traceEVENT_TASK_CREATE					( ( uint8_t ) 0x01 )
+#define traceEVENT_TASK_DELETE					( ( uint8_t ) 0x02 )
+#define traceEVENT_TASK_SWITCHED_IN				( ( uint8_t ) 0x03 )
+#define traceEVENT_TASK_SWITCHED_OUT			( ( uint8_t ) 0x04 )
+#define traceEVENT_TASK_READY					( ( uint8_t ) 0x05 )
+#define traceEVENT_TASK_DELAY					( ( uint8_t ) 0x06 )
+#define traceEVENT_TASK_PRIORITY_INHERIT		( ( uint8_t ) 0x07 )
+#define traceEVENT_TASK_PRIORITY_DISINHERIT		( ( uint8_t ) 0x08 )
+#define traceEVENT_QUEUE_CREATE					( ( uint8_t ) 0x10 )
+#define traceEVENT_QUEUE_SEND					( ( uint8_t ) 0x11 )
+#define traceEVENT_QUEUE_SEND_FAILED			( ( uint8_t ) 0x12 )
+#define traceEVENT_QUEUE_SEND_FROM_ISR			( ( uint8_t ) 0x13 )
+#define traceEVENT_QUEUE_RECEIVE				( ( uint8_t ) 0x14 )
+#define traceEVENT_QUEUE_RECEIVE_FAILED			( ( uint8_t ) 0x15 )
+#define traceEVENT_QUEUE_RECEIVE_FROM_ISR		( ( uint8_t ) 0x16 )
+#define traceEVENT_QUEUE_BLOCKING_ON_SEND		( ( uint8_t ) 0x17 )
+#define traceEVENT_QUEUE_BLOCKING_ON_RECEIVE	( ( uint8_t ) 0x18 )
+#define traceEVENT_ISR_ENTER					( ( uint8_t ) 0x20 )
+#define traceEVENT_ISR_EXIT						( ( uint8_t ) 0x21 )
+#define traceEVENT_CLOCK_CHANGE					( ( uint8_t ) 0x30 )
+
+/*
+ * Functions beyond this part are called from the trace macros below and are
+ * not intended to be called directly.
+ */
+void vTraceRecordEvent( uint8_t ucEvent, UBaseType_t uxArgument, UBaseType_t uxObject ) PRIVILEGED_FUNCTION;
+void vTraceRecordTaskCreate( void *pxTCB, const char *pcName, UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+void vTraceRecordQueueCreate( void *pxQueue, uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
+void vTraceRecordObjectName( UBaseType_t uxObject, const char *pcName ) PRIVILEGED_FUNCTION;
+
+/*
+ * tracerecorder. h
+ * <pre>void vTraceRecorderStart( void );</pre>
+ *
+ * Clears the ring and starts recording.  Call before the tasks and queues to
+ * be traced are created - objects created while the recorder is stopped are
+ * not given a number, so their events cannot be told apart in the trace.
+ */
+void vTraceRecorderStart( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * tracerecorder. h
+ * <pre>void vTraceRecorderStop( void );</pre>
+ *
+ * Stops recording, leaving the events recorded so far in the ring.  Useful to
+ * freeze the trace when a fault is detected, before it is overwritten.
+ */
+void vTraceRecorderStop( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * tracerecorder. h
+ * <pre>void vTraceRecorderClockChanged( void );</pre>
+ *
+ * Timestamps are core clock cycles, so call this after changing the core
+ * clock (and SystemCoreClock) at run time.  The recorder takes the new rate
+ * from configCPU_CLOCK_HZ and records the old one in a
+ * traceEVENT_CLOCK_CHANGE event, as a 24 bit kHz value with the high byte in
+ * the argument and the low 16 bits in the object number, so the host tool can
+ * convert each part of the trace at the rate it was recorded at.
+ */
+void vTraceRecorderClockChanged( void ) PRIVILEGED_FUNCTION;
+
+/* Tasks and queues are identified in events by the number the recorder gives
+them when they are created, held in uxTaskNumber and uxQueueNumber, so the
+macros only read a member of the object. */
+#define traceTASK_CREATE( pxNewTCB )											vTraceRecordTaskCreate( ( void * ) ( pxNewTCB ), ( pxNewTCB )->pcTaskName, ( pxNewTCB )->uxPriority )
+#define traceTASK_DELETE( pxTaskToDelete )										vTraceRecordEvent( traceEVENT_TASK_DELETE, 0U, ( pxTaskToDelete )->uxTaskNumber )
+#define traceTASK_SWITCHED_IN()													vTraceRecordEvent( traceEVENT_TASK_SWITCHED_IN, pxCurrentTCB->uxPriority, pxCurrentTCB->uxTaskNumber )
+#define traceTASK_SWITCHED_OUT()												vTraceRecordEvent( traceEVENT_TASK_SWITCHED_OUT, pxCurrentTCB->uxPriority, pxCurrentTCB->uxTaskNumber )
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )									vTraceRecordEvent( traceEVENT_TASK_READY, ( pxTCB )->uxPriority, ( pxTCB )->uxTaskNumber )
+#define traceTASK_DELAY()														vTraceRecordEvent( traceEVENT_TASK_DELAY, 0U, pxCurrentTCB->uxTaskNumber )
+#define traceTASK_DELAY_UNTIL( xTimeToWake )									vTraceRecordEvent( traceEVENT_TASK_DELAY, 0U, pxCurrentTCB->uxTaskNumber )
+#define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority )	vTraceRecordEvent( traceEVENT_TASK_PRIORITY_INHERIT, ( uxInheritedPriority ), ( pxTCBOfMutexHolder )->uxTaskNumber )
+#define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )	vTraceRecordEvent( traceEVENT_TASK_PRIORITY_DISINHERIT, ( uxOriginalPriority ), ( pxTCBOfMutexHolder )->uxTaskNumber )
+
+/* Semaphores and mutexes are queues, so their gives and takes are recorded
+as sends and receives.  The host tool names them from the queue type recorded
+when the queue was created.  The argument is the number of items in the queue,
+or the count of a semaphore. */
+#define traceQUEUE_CREATE( pxNewQueue )											vTraceRecordQueueCreate( ( void * ) ( pxNewQueue ), ( pxNewQueue )->ucQueueType )
+#define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )							vTraceRecordObjectName( ( xQueue )->uxQueueNumber, ( pcQueueName ) )
+#define traceQUEUE_SEND( pxQueue )												vTraceRecordEvent( traceEVENT_QUEUE_SEND, ( pxQueue )->uxMessagesWaiting, ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_SEND_FAILED( pxQueue )										vTraceRecordEvent( traceEVENT_QUEUE_SEND_FAILED, ( pxQueue )->uxMessagesWaiting, ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )										vTraceRecordEvent( traceEVENT_QUEUE_SEND_FROM_ISR, ( pxQueue )->uxMessagesWaiting, ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_RECEIVE( pxQueue )											vTraceRecordEvent( traceEVENT_QUEUE_RECEIVE, ( pxQueue )->uxMessagesWaiting, ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )									vTraceRecordEvent( traceEVENT_QUEUE_RECEIVE_FAILED, ( pxQueue )->uxMessagesWaiting, ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )									vTraceRecordEvent( traceEVENT_QUEUE_RECEIVE_FROM_ISR, ( pxQueue )->uxMessagesWaiting, ( pxQueue )->uxQueueNumber )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )									vTraceRecordEvent( traceEVENT_QUEUE_BLOCKING_ON_SEND, ( pxQueue )->uxMessagesWaiting, ( pxQueue )->uxQueueNumber )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )								vTraceRecordEvent( traceEVENT_QUEUE_BLOCKING_ON_RECEIVE, ( pxQueue )->uxMessagesWaiting, ( pxQueue )->uxQueueNumber )
+
+#ifndef portGET_INTERRUPT_NUMBER
+	#define portGET_INTERRUPT_NUMBER() 0U
+#endif
+
+/* The argument is the exception number, so 15 for the SysTick and 16 plus the
+IRQ number for peripheral interrupts. */
+#define traceISR_ENTER()														vTraceRecordEvent( traceEVENT_ISR_ENTER, portGET_INTERRUPT_NUMBER(), 0U )
+#define traceISR_EXIT()															vTraceRecordEvent( traceEVENT_ISR_EXIT, portGET_INTERRUPT_NUMBER(), 0U )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_RECORDER_H */
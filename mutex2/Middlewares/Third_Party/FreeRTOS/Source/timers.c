@@ -57,6 +57,7 @@ configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
 
 /* Misc definitions. */
 #define tmrNO_DELAY		( TickType_t ) 0U
+#define tmrMAX_TIME_BEFORE_OVERFLOW	( ( TickType_t ) -1 )
 
 /* The name assigned to the timer service task.  This can be overridden by
 defining trmTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h. */
@@ -69,6 +70,18 @@ defining trmTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h. */
 #define tmrSTATUS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 0x02 )
 #define tmrSTATUS_IS_AUTORELOAD				( ( uint8_t ) 0x04 )
 
+#if( configUSE_TIMER_WHEEL == 1 )
+	/* Masks an expiry time down to the index of its slot in the wheel. */
+	#define tmrWHEEL_SLOT_MASK				( ( TickType_t ) configTIMER_WHEEL_SLOTS - ( TickType_t ) 1 )
+#endif
+
+#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+	/* Values of xDaemonState. */
+	#define tmrDAEMON_BUSY					( ( BaseType_t ) 0 )
+	#define tmrDAEMON_WAITING				( ( BaseType_t ) 1 )
+	#define tmrDAEMON_WAITING_FOREVER		( ( BaseType_t ) 2 )
+#endif
+
 /* The definition of the timers themselves. */
 typedef struct tmrTimerControl /* The old naming convention is used to prevent breaking kernel aware debuggers. */
 {
@@ -81,6 +94,20 @@ typedef struct tmrTimerControl /* The old naming convention is used to prevent b
 		UBaseType_t			uxTimerNumber;		/*<< An ID assigned by trace tools such as FreeRTOS+Trace */
 	#endif
 	uint8_t 				ucStatus;			/*<< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
+	#if( configUSE_TIMER_PHASE_LOCK == 1 )
+		uint32_t			ulPeriodFraction;	/*<< The fraction of a tick added to xTimerPeriodInTicks, in units of 1/2^32 of a tick. */
+		uint32_t			ulPhaseFraction;	/*<< The fraction of a tick by which the expiry time held in xTimerListItem is earlier than the exact expiry time. */
+	#endif
+	#if( configUSE_TIMER_PROFILING == 1 )
+		uint64_t			ullTotalCycles;		/*<< The time taken by all the calls of the callback, in core clock cycles. */
+		uint32_t			ulCallbacks;		/*<< The number of times the callback has been called. */
+		uint32_t			ulMinCycles;		/*<< The shortest a call of the callback has taken. */
+		uint32_t			ulMaxCycles;		/*<< The longest a call of the callback has taken. */
+		uint32_t			ulMissedPeriods;	/*<< The number of expiries that had already passed when the timer was reloaded. */
+		uint32_t			ulOverruns;			/*<< The number of calls that took longer than ulBudgetCycles. */
+		uint32_t			ulBudgetCycles;		/*<< The time a call of the callback can take before it is an overrun.  0 for no budget. */
+		TickType_t			xMaxLateness;		/*<< The furthest the callback has been called behind its expiry time. */
+	#endif
 } xTIMER;
 
 /* The old xTIMER name is maintained above then typedefed to the new Timer_t
@@ -96,6 +123,9 @@ typedef struct tmrTimerParameters
 {
 	TickType_t			xMessageValue;		/*<< An optional value used by a subset of commands, for example, when changing the period of a timer. */
 	Timer_t *			pxTimer;			/*<< The timer to which the command will be applied. */
+	#if( configUSE_TIMER_PHASE_LOCK == 1 )
+		uint32_t		ulPeriodFraction;	/*<< The fraction of a tick in the new period, used by tmrCOMMAND_CHANGE_PERIOD_EXACT. */
+	#endif
 } TimerParameter_t;
 
 
@@ -126,21 +156,58 @@ typedef struct tmrTimerQueueMessage
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access these lists.
-xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
-breaks some kernel aware debuggers, and debuggers that reply on removing the
-static qualifier. */
-PRIVILEGED_DATA static List_t xActiveTimerList1;
-PRIVILEGED_DATA static List_t xActiveTimerList2;
-PRIVILEGED_DATA static List_t *pxCurrentTimerList;
-PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/* The hashed timing wheel in which active timers are stored.  A timer is
+	held, unsorted, in the slot indexed by its expiry time masked with
+	tmrWHEEL_SLOT_MASK, so starting, stopping and resetting a timer is a
+	constant time list insert or remove however many timers are active.  Each
+	time the wheel is turned the slots it passes are searched for timers that
+	have expired - timers whose expiry time is one or more revolutions away
+	stay where they are.  xWheelTime is the tick the wheel was last turned to.
+	Every active timer expires after it, which lets expiry times be compared
+	relative to it without separate lists for tick count overflows.  Only the
+	timer service task is allowed to access the wheel, other than as described
+	for xDaemonState below. */
+	PRIVILEGED_DATA static List_t xTimerWheel[ configTIMER_WHEEL_SLOTS ];
+	PRIVILEGED_DATA static TickType_t xWheelTime;
+
+#else
+
+	/* The list in which active timers are stored.  Timers are referenced in expire
+	time order, with the nearest expiry time at the front of the list.  Only the
+	timer service task is allowed to access these lists, other than as described
+	for xDaemonState below.
+	xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
+	breaks some kernel aware debuggers, and debuggers that reply on removing the
+	static qualifier. */
+	PRIVILEGED_DATA static List_t xActiveTimerList1;
+	PRIVILEGED_DATA static List_t xActiveTimerList2;
+	PRIVILEGED_DATA static List_t *pxCurrentTimerList;
+	PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
 PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 
+#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	/* Whether a task can update the active timers itself.  While xDaemonState
+	is tmrDAEMON_BUSY the timer service task may be part way through updating
+	them - including from within a timer callback - so only it can.  Otherwise
+	it is blocked, or about to block, having sampled the tick count at
+	xDaemonBlockTime, and does not look at the active timers again until a
+	command arrives or, if xDaemonState is tmrDAEMON_WAITING, xDaemonWakeTime
+	is reached.  These are only written by the timer service task, and only
+	read by tasks with the scheduler suspended. */
+	PRIVILEGED_DATA static volatile BaseType_t xDaemonState = tmrDAEMON_BUSY;
+	PRIVILEGED_DATA static TickType_t xDaemonBlockTime;
+	PRIVILEGED_DATA static TickType_t xDaemonWakeTime;
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -174,6 +241,13 @@ static portTASK_FUNCTION_PROTO( prvTimerTask, pvParameters ) PRIVILEGED_FUNCTION
  */
 static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Carry out a command from a task directly, if possible, or send it to the
+ * timer service task.  ulPeriodFraction is only used by the commands that
+ * change the period to a period and a fraction of a tick.
+ */
+static BaseType_t prvSendTimerCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, const uint32_t ulPeriodFraction, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
  * depending on if the expire time causes a timer counter overflow.
@@ -181,16 +255,119 @@ static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
 /*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto-reload timer, then call its callback.
+ * Reload an auto-reload timer that expired at xExpiredTime, then call its
+ * callback for that expiry.  If its next expiry time has already passed too,
+ * the callback is then called for that expiry and the timer reloaded again,
+ * until an expiry time that has not passed is found.  The callbacks are
+ * therefore called in the order of the expiries they are for.
  */
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+static void prvReloadTimer( Timer_t * const pxTimer, TickType_t xExpiredTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
 /*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
+ * Process a timer that has been removed from the active timers, or was never
+ * added to them, because it expired at xExpiredTime - reload it if it is an
+ * auto-reload timer, and call its callback.
  */
-static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+static void prvTimerExpired( Timer_t * const pxTimer, const TickType_t xExpiredTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_PHASE_LOCK == 1 )
+
+	/*
+	 * Return the number of ticks from one expiry of the timer to the next,
+	 * adding up the fraction of a tick in its period so each call moves the
+	 * phase of the timer on by one period.  prvResetTimerPhase() restarts the
+	 * adding up when the timer is started.
+	 */
+	static TickType_t prvGetReloadPeriod( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+	#define prvResetTimerPhase( pxTimer ) ( ( pxTimer )->ulPhaseFraction = 0UL )
+
+#else
+
+	#define prvGetReloadPeriod( pxTimer ) ( ( pxTimer )->xTimerPeriodInTicks )
+	#define prvResetTimerPhase( pxTimer )
+
+#endif /* configUSE_TIMER_PHASE_LOCK */
+
+#if( configUSE_TIMER_PROFILING == 1 )
+
+	/*
+	 * Call the callback of a timer that expired at xExpiredTime, timing it and
+	 * recording how late it is called.  Calls the overrun hook if the callback
+	 * takes longer than the timer's budget.
+	 */
+	static void prvCallTimerCallback( Timer_t * const pxTimer, const TickType_t xExpiredTime ) PRIVILEGED_FUNCTION;
+
+	#if( configUSE_TIMER_OVERRUN_HOOK == 1 )
+		extern void vApplicationTimerOverrunHook( TimerHandle_t xTimer, uint32_t ulCycles );
+	#endif
+
+#else
+
+	#define prvCallTimerCallback( pxTimer, xExpiredTime ) ( pxTimer )->pxCallbackFunction( ( TimerHandle_t ) ( pxTimer ) )
+
+#endif /* configUSE_TIMER_PROFILING */
+
+#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	/*
+	 * Carry out a start, reset, stop or change period command sent from a task
+	 * by updating the active timers directly, if the timer service task is idle
+	 * and would not have to wake any earlier than it already will.  Returns
+	 * pdFAIL if the command has to be sent to the timer service task instead.
+	 */
+	static BaseType_t prvTryDirectCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, const uint32_t ulPeriodFraction ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the timer service task with the scheduler suspended just before
+	 * it blocks until xWakeTime, or indefinitely, having sampled the tick count
+	 * at xTimeNow - and again as soon as it runs after blocking.
+	 */
+	#define prvDaemonBlocking( xTimeNow, xWakeTime, xWaitIndefinitely )	\
+	{																	\
+		xDaemonBlockTime = ( xTimeNow );								\
+		xDaemonWakeTime = ( xWakeTime );								\
+		if( ( xWaitIndefinitely ) != pdFALSE )							\
+		{																\
+			xDaemonState = tmrDAEMON_WAITING_FOREVER;					\
+		}																\
+		else															\
+		{																\
+			xDaemonState = tmrDAEMON_WAITING;							\
+		}																\
+	}
+	#define prvDaemonRunning() ( xDaemonState = tmrDAEMON_BUSY )
+
+#else
+
+	#define prvDaemonBlocking( xTimeNow, xWakeTime, xWaitIndefinitely )
+	#define prvDaemonRunning()
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/*
+	 * Turn the wheel from xWheelTime to xTimeNow.  Every timer that expires in
+	 * between is removed from the wheel, reloaded if it is an auto-reload timer,
+	 * and has its callback called.
+	 */
+	static void prvAdvanceWheel( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * An active timer has reached its expire time.  Reload the timer if it is an
+	 * auto-reload timer, then call its callback.
+	 */
+	static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -369,6 +546,24 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 		pxNewTimer->pvTimerID = pvTimerID;
 		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
 		vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+		#if( configUSE_TIMER_PHASE_LOCK == 1 )
+		{
+			pxNewTimer->ulPeriodFraction = 0UL;
+			pxNewTimer->ulPhaseFraction = 0UL;
+		}
+		#endif
+		#if( configUSE_TIMER_PROFILING == 1 )
+		{
+			pxNewTimer->ullTotalCycles = 0ULL;
+			pxNewTimer->ulCallbacks = 0UL;
+			pxNewTimer->ulMinCycles = 0UL;
+			pxNewTimer->ulMaxCycles = 0UL;
+			pxNewTimer->ulMissedPeriods = 0UL;
+			pxNewTimer->ulOverruns = 0UL;
+			pxNewTimer->ulBudgetCycles = ( uint32_t ) configTIMER_CALLBACK_BUDGET_CYCLES;
+			pxNewTimer->xMaxLateness = ( TickType_t ) 0U;
+		}
+		#endif
 		if( uxAutoReload != pdFALSE )
 		{
 			pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
@@ -379,6 +574,22 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 /*-----------------------------------------------------------*/
 
 BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait )
+{
+	return prvSendTimerCommand( xTimer, xCommandID, xOptionalValue, 0UL, pxHigherPriorityTaskWoken, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_PHASE_LOCK == 1 )
+
+	BaseType_t xTimerGenericCommandExact( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, const uint32_t ulPeriodFraction, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait )
+	{
+		return prvSendTimerCommand( xTimer, xCommandID, xOptionalValue, ulPeriodFraction, pxHigherPriorityTaskWoken, xTicksToWait );
+	}
+
+#endif /* configUSE_TIMER_PHASE_LOCK */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendTimerCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, const uint32_t ulPeriodFraction, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait )
 {
 BaseType_t xReturn = pdFAIL;
 DaemonTaskMessage_t xMessage;
@@ -389,25 +600,55 @@ DaemonTaskMessage_t xMessage;
 	on a particular timer definition. */
 	if( xTimerQueue != NULL )
 	{
-		/* Send a command to the timer service task to start the xTimer timer. */
-		xMessage.xMessageID = xCommandID;
-		xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
-		xMessage.u.xTimerParameters.pxTimer = xTimer;
+		#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+		{
+			/* A command from a task might not need to be sent at all. */
+			if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+			{
+				xReturn = prvTryDirectCommand( xTimer, xCommandID, xOptionalValue, ulPeriodFraction );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TIMER_DIRECT_COMMANDS */
 
-		if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+		if( xReturn == pdFAIL )
 		{
-			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+			/* Send a command to the timer service task to start the xTimer timer. */
+			xMessage.xMessageID = xCommandID;
+			xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+			xMessage.u.xTimerParameters.pxTimer = xTimer;
+			#if( configUSE_TIMER_PHASE_LOCK == 1 )
+			{
+				xMessage.u.xTimerParameters.ulPeriodFraction = ulPeriodFraction;
+			}
+			#else
 			{
-				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+				( void ) ulPeriodFraction;
+			}
+			#endif
+
+			if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+			{
+				if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+				}
+				else
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+				}
 			}
 			else
 			{
-				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+				xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 			}
 		}
 		else
 		{
-			xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+			mtCOVERAGE_TEST_MARKER();
 		}
 
 		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
@@ -421,6 +662,177 @@ DaemonTaskMessage_t xMessage;
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xTimerGenericCommandMultiple( TimerHandle_t const * const pxTimers, const UBaseType_t uxCount, const BaseType_t xCommandID, const TickType_t xOptionalValue, const TickType_t xTicksToWait )
+{
+BaseType_t xReturn = pdPASS;
+UBaseType_t uxSent = 0;
+
+	configASSERT( pxTimers );
+
+	/* Only commands that are sent from a task can be sent together. */
+	configASSERT( ( xCommandID > tmrCOMMAND_START_DONT_TRACE ) && ( xCommandID < tmrFIRST_FROM_ISR_COMMAND ) );
+
+	while( ( uxSent < uxCount ) && ( xReturn != pdFAIL ) )
+	{
+		/* Send as many of the commands as there is space for with the
+		scheduler suspended.  xTimerGenericCommand() does not block while the
+		scheduler is suspended, and the timer service task cannot run until
+		the scheduler is resumed, so it then processes the commands together
+		rather than being switched to after each one. */
+		vTaskSuspendAll();
+		{
+			while( ( uxSent < uxCount ) && ( xTimerGenericCommand( pxTimers[ uxSent ], xCommandID, xOptionalValue, NULL, tmrNO_DELAY ) != pdFAIL ) )
+			{
+				uxSent++;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		if( uxSent < uxCount )
+		{
+			/* The timer command queue is full.  Wait for space for the next
+			command, which lets the timer service task empty the queue, then
+			send the rest. */
+			if( xTimerGenericCommand( pxTimers[ uxSent ], xCommandID, xOptionalValue, NULL, xTicksToWait ) != pdFAIL )
+			{
+				uxSent++;
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	static BaseType_t prvTryDirectCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, const uint32_t ulPeriodFraction )
+	{
+	BaseType_t xReturn = pdFAIL;
+	TickType_t xTimeNow, xCommandTime, xPeriod;
+
+		vTaskSuspendAll();
+		{
+			xTimeNow = xTaskGetTickCount();
+
+			/* The active timers can only be updated here while the timer
+			service task is blocked with no commands waiting, as a command
+			already in the queue must be processed before this one.  Once its
+			wake time has been reached the timer service task is about to run,
+			and with the sorted list might not have seen the tick count
+			overflow yet, so the command is left to it. */
+			if( ( xDaemonState != tmrDAEMON_BUSY ) &&
+				( uxQueueMessagesWaiting( xTimerQueue ) == ( UBaseType_t ) 0 ) &&
+				( ( xDaemonState == tmrDAEMON_WAITING_FOREVER ) || ( ( TickType_t ) ( xTimeNow - xDaemonBlockTime ) < ( TickType_t ) ( xDaemonWakeTime - xDaemonBlockTime ) ) ) )
+			{
+				if( xCommandID == tmrCOMMAND_STOP )
+				{
+					/* Stopping a timer can at most leave the timer service
+					task to wake with nothing to do. */
+					if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+					{
+						( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+					xReturn = pdPASS;
+				}
+				else if( ( xDaemonState == tmrDAEMON_WAITING ) &&
+						 ( ( xCommandID == tmrCOMMAND_START ) || ( xCommandID == tmrCOMMAND_RESET ) ||
+						   ( xCommandID == tmrCOMMAND_CHANGE_PERIOD ) || ( xCommandID == tmrCOMMAND_CHANGE_PERIOD_EXACT ) ) )
+				{
+					/* Work out the expiry time as the timer service task
+					would, in prvProcessReceivedCommands(). */
+					if( ( xCommandID == tmrCOMMAND_CHANGE_PERIOD ) || ( xCommandID == tmrCOMMAND_CHANGE_PERIOD_EXACT ) )
+					{
+						configASSERT( ( xOptionalValue > 0 ) );
+						xCommandTime = xTimeNow;
+						xPeriod = xOptionalValue;
+					}
+					else
+					{
+						xCommandTime = xOptionalValue;
+						xPeriod = pxTimer->xTimerPeriodInTicks;
+					}
+
+					/* The timer can only be added if it expires no earlier
+					than the timer service task is going to wake, otherwise
+					the timer service task has to be woken to block again for
+					less time.  Times are measured from when the timer service
+					task blocked, so a command time from before then is also
+					left to the timer service task. */
+					if( ( ( TickType_t ) ( xCommandTime - xDaemonBlockTime ) <= ( TickType_t ) ( xTimeNow - xDaemonBlockTime ) ) &&
+						( ( TickType_t ) ( ( xCommandTime + xPeriod ) - xDaemonBlockTime ) >= ( TickType_t ) ( xDaemonWakeTime - xDaemonBlockTime ) ) )
+					{
+						if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+						{
+							( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+						pxTimer->xTimerPeriodInTicks = xPeriod;
+						#if( configUSE_TIMER_PHASE_LOCK == 1 )
+						{
+							if( xCommandID == tmrCOMMAND_CHANGE_PERIOD_EXACT )
+							{
+								pxTimer->ulPeriodFraction = ulPeriodFraction;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#else
+						{
+							( void ) ulPeriodFraction;
+						}
+						#endif
+						prvResetTimerPhase( pxTimer );
+
+						/* The expiry time is after the time now, so the timer
+						cannot need processing straight away. */
+						( void ) prvInsertTimerInActiveList( pxTimer, ( xCommandTime + prvGetReloadPeriod( pxTimer ) ), xTimeNow, xCommandTime );
+						xReturn = pdPASS;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+/*-----------------------------------------------------------*/
+
 TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
 {
 	/* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
@@ -504,45 +916,345 @@ Timer_t *pxTimer = xTimer;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
-{
-BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+#if( configUSE_TIMER_PHASE_LOCK == 1 )
 
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
-	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-	traceTIMER_EXPIRED( pxTimer );
+	void vTimerSetPeriodFraction( TimerHandle_t xTimer, const uint32_t ulPeriodFraction )
+	{
+	Timer_t * pxTimer =  xTimer;
+	UBaseType_t uxSavedInterruptStatus;
 
-	/* If the timer is an auto-reload timer then calculate the next
-	expiry time and re-insert the timer in the list of active timers. */
-	if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+		configASSERT( xTimer );
+
+		/* The interrupt version of the critical section is used so the
+		function can be called from an interrupt as well as a task. */
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			pxTimer->ulPeriodFraction = ulPeriodFraction;
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configUSE_TIMER_PHASE_LOCK */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_PHASE_LOCK == 1 )
+
+	uint32_t ulTimerGetPeriodFraction( TimerHandle_t xTimer )
+	{
+	Timer_t * pxTimer =  xTimer;
+
+		configASSERT( xTimer );
+		return pxTimer->ulPeriodFraction;
+	}
+
+#endif /* configUSE_TIMER_PHASE_LOCK */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_PROFILING == 1 )
+
+	void vTimerGetCallbackStats( TimerHandle_t xTimer, TimerCallbackStats_t *pxStats )
 	{
-		/* The timer is inserted into a list using a time relative to anything
-		other than the current time.  It will therefore be inserted into the
-		correct list relative to the time this task thinks it is now. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+	Timer_t * pxTimer =  xTimer;
+
+		configASSERT( xTimer );
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
 		{
-			/* The timer expired before it was added to the active timer
-			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-			configASSERT( xResult );
-			( void ) xResult;
+			pxStats->ulCallbacks = pxTimer->ulCallbacks;
+			pxStats->ulMinCycles = pxTimer->ulMinCycles;
+			pxStats->ulMaxCycles = pxTimer->ulMaxCycles;
+			pxStats->xMaxLateness = pxTimer->xMaxLateness;
+			pxStats->ulMissedPeriods = pxTimer->ulMissedPeriods;
+			pxStats->ulOverruns = pxTimer->ulOverruns;
+
+			if( pxTimer->ulCallbacks != 0UL )
+			{
+				pxStats->ulAverageCycles = ( uint32_t ) ( pxTimer->ullTotalCycles / pxTimer->ulCallbacks );
+			}
+			else
+			{
+				pxStats->ulAverageCycles = 0UL;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_PROFILING == 1 )
+
+	void vTimerResetCallbackStats( TimerHandle_t xTimer )
+	{
+	Timer_t * pxTimer =  xTimer;
+
+		configASSERT( xTimer );
+
+		taskENTER_CRITICAL();
+		{
+			pxTimer->ullTotalCycles = 0ULL;
+			pxTimer->ulCallbacks = 0UL;
+			pxTimer->ulMinCycles = 0UL;
+			pxTimer->ulMaxCycles = 0UL;
+			pxTimer->ulMissedPeriods = 0UL;
+			pxTimer->ulOverruns = 0UL;
+			pxTimer->xMaxLateness = ( TickType_t ) 0U;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_PROFILING == 1 )
+
+	void vTimerSetCallbackBudget( TimerHandle_t xTimer, const uint32_t ulBudgetCycles )
+	{
+	Timer_t * pxTimer =  xTimer;
+
+		configASSERT( xTimer );
+
+		taskENTER_CRITICAL();
+		{
+			pxTimer->ulBudgetCycles = ulBudgetCycles;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_PROFILING == 1 )
+
+	static void prvCallTimerCallback( Timer_t * const pxTimer, const TickType_t xExpiredTime )
+	{
+	TickType_t xLateness;
+	uint32_t ulStart, ulCycles;
+	BaseType_t xOverrun = pdFALSE;
+
+		/* The tick count is read again rather than using the time the timer
+		service task sampled, as callbacks called before this one since then
+		make this one later. */
+		xLateness = xTaskGetTickCount() - xExpiredTime;
+
+		ulStart = portGET_CYCLE_COUNTER();
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+		ulCycles = portGET_CYCLE_COUNTER() - ulStart;
+
+		/* The statistics are only written by this task, but are read by
+		vTimerGetCallbackStats() from other tasks, so are updated together. */
+		taskENTER_CRITICAL();
+		{
+			pxTimer->ullTotalCycles += ulCycles;
+			pxTimer->ulCallbacks++;
+
+			/* The minimum is only meaningful once there has been a call. */
+			if( ( pxTimer->ulCallbacks == 1UL ) || ( ulCycles < pxTimer->ulMinCycles ) )
+			{
+				pxTimer->ulMinCycles = ulCycles;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ulCycles > pxTimer->ulMaxCycles )
+			{
+				pxTimer->ulMaxCycles = ulCycles;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xLateness > pxTimer->xMaxLateness )
+			{
+				pxTimer->xMaxLateness = xLateness;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( pxTimer->ulBudgetCycles != 0UL ) && ( ulCycles > pxTimer->ulBudgetCycles ) )
+			{
+				pxTimer->ulOverruns++;
+				xOverrun = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xOverrun != pdFALSE )
+		{
+			traceTIMER_CALLBACK_OVERRUN( pxTimer, ulCycles );
+
+			#if( configUSE_TIMER_OVERRUN_HOOK == 1 )
+			{
+				vApplicationTimerOverrunHook( ( TimerHandle_t ) pxTimer, ulCycles );
+			}
+			#endif
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
+
+#endif /* configUSE_TIMER_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_PHASE_LOCK == 1 )
+
+	static TickType_t prvGetReloadPeriod( Timer_t * const pxTimer )
+	{
+	TickType_t xPeriod = pxTimer->xTimerPeriodInTicks;
+	uint32_t ulPhaseFraction;
+
+		/* Add the fraction of a tick in the period to the fraction the expiry
+		time is already behind by.  When that carries a whole tick has built
+		up, so this period is a tick longer. */
+		ulPhaseFraction = pxTimer->ulPhaseFraction + pxTimer->ulPeriodFraction;
+
+		if( ulPhaseFraction < pxTimer->ulPhaseFraction )
+		{
+			xPeriod++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxTimer->ulPhaseFraction = ulPhaseFraction;
+
+		return xPeriod;
+	}
+
+#endif /* configUSE_TIMER_PHASE_LOCK */
+/*-----------------------------------------------------------*/
+
+static void prvReloadTimer( Timer_t * const pxTimer, TickType_t xExpiredTime, const TickType_t xTimeNow )
+{
+TickType_t xNextExpiryTime;
+BaseType_t xNextHasPassed;
+
+	/* The next expiry time is calculated from the time the timer expired
+	rather than the time now, so the period does not drift.  If the next
+	expiry time has also passed, call the callback for it here, after the one
+	for the expiry being processed, and try the one after, rather than queue a
+	command to do so. */
+	for( ;; )
+	{
+		xNextExpiryTime = xExpiredTime + prvGetReloadPeriod( pxTimer );
+		xNextHasPassed = prvInsertTimerInActiveList( pxTimer, xNextExpiryTime, xTimeNow, xExpiredTime );
+
+		prvCallTimerCallback( pxTimer, xExpiredTime );
+
+		if( xNextHasPassed == pdFALSE )
+		{
+			break;
+		}
+
+		xExpiredTime = xNextExpiryTime;
+
+		#if( configUSE_TIMER_PROFILING == 1 )
+		{
+			pxTimer->ulMissedPeriods++;
+		}
+		#endif
+
+		traceTIMER_EXPIRED( pxTimer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerExpired( Timer_t * const pxTimer, const TickType_t xExpiredTime, const TickType_t xTimeNow )
+{
+	traceTIMER_EXPIRED( pxTimer );
+
+	/* If the timer is an auto-reload timer then calculate the next expiry time
+	and re-insert the timer in the list of active timers.  The time is relative
+	to the time this task thinks it is now, not the current time, so the timer
+	is inserted into the correct list. */
+	if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+	{
+		prvReloadTimer( pxTimer, xExpiredTime, xTimeNow );
+	}
 	else
 	{
 		pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
-		mtCOVERAGE_TEST_MARKER();
+		prvCallTimerCallback( pxTimer, xExpiredTime );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+static void prvAdvanceWheel( const TickType_t xTimeNow )
+{
+TickType_t xTicksElapsed, xTick, xExpiryTime;
+List_t *pxSlot;
+ListItem_t *pxItem, *pxNextItem;
+Timer_t *pxTimer;
+
+	xTicksElapsed = xTimeNow - xWheelTime;
+
+	/* Visit the slot of each tick the wheel passes.  If the wheel has fallen
+	behind by a whole revolution or more every slot is visited once. */
+	for( xTick = ( TickType_t ) 1; ( xTick <= xTicksElapsed ) && ( xTick <= ( TickType_t ) configTIMER_WHEEL_SLOTS ); xTick++ )
+	{
+		pxSlot = &( xTimerWheel[ ( xWheelTime + xTick ) & tmrWHEEL_SLOT_MASK ] );
+		pxItem = listGET_HEAD_ENTRY( pxSlot );
+
+		while( pxItem != listGET_END_MARKER( pxSlot ) )
+		{
+			/* The timer may be removed, and re-inserted at the end of this
+			same slot, so move on before processing it. */
+			pxNextItem = listGET_NEXT( pxItem );
+			xExpiryTime = listGET_LIST_ITEM_VALUE( pxItem );
+
+			/* Has the expiry time been passed, or is the timer in this slot
+			for a later revolution? */
+			if( ( TickType_t ) ( xExpiryTime - xWheelTime - ( TickType_t ) 1 ) < xTicksElapsed )
+			{
+				pxTimer = ( Timer_t * ) listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				( void ) uxListRemove( pxItem );
+
+				/* A timer reloaded into this same slot goes on the end of it,
+				and as its new expiry time has not passed it is left there when
+				it is reached. */
+				prvTimerExpired( pxTimer, xExpiryTime, xTimeNow );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxItem = pxNextItem;
+		}
 	}
 
-	/* Call the timer callback. */
-	pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+	xWheelTime = xTimeNow;
 }
+
+#else /* configUSE_TIMER_WHEEL */
+
+static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+{
+Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+	/* Remove the timer from the list of active timers.  A check has already
+	been performed to ensure the list is not empty. */
+	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+	prvTimerExpired( pxTimer, xNextExpireTime, xTimeNow );
+}
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static portTASK_FUNCTION( prvTimerTask, pvParameters )
@@ -553,6 +1265,13 @@ BaseType_t xListWasEmpty;
 	/* Just to avoid compiler warnings. */
 	( void ) pvParameters;
 
+	#if( configUSE_TIMER_PROFILING == 1 )
+	{
+		/* The cycle counter times the callbacks. */
+		portENABLE_CYCLE_COUNTER();
+	}
+	#endif
+
 	#if( configUSE_DAEMON_TASK_STARTUP_HOOK == 1 )
 	{
 		extern void vApplicationDaemonTaskStartupHook( void );
@@ -581,6 +1300,51 @@ BaseType_t xListWasEmpty;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 1 )
+
+static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
+{
+TickType_t xTimeNow;
+
+	vTaskSuspendAll();
+	{
+		xTimeNow = xTaskGetTickCount();
+
+		/* Times are measured from xWheelTime, so the comparison is correct
+		even if the tick count has overflowed. */
+		if( ( xListWasEmpty == pdFALSE ) && ( ( TickType_t ) ( xNextExpireTime - xWheelTime ) <= ( TickType_t ) ( xTimeNow - xWheelTime ) ) )
+		{
+			( void ) xTaskResumeAll();
+			prvAdvanceWheel( xTimeNow );
+		}
+		else
+		{
+			/* Block until the wheel next has to be turned, or a command is
+			received.  There are no lists to switch when the tick count
+			overflows, so if no timers are active the block is indefinite. */
+			prvDaemonBlocking( xTimeNow, xNextExpireTime, xListWasEmpty );
+			vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+
+			if( xTaskResumeAll() == pdFALSE )
+			{
+				/* Yield to wait for either a command to arrive, or the
+				block time to expire.  If a command arrived between the
+				critical section being exited and this yield then the yield
+				will not cause the task to block. */
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvDaemonRunning();
+		}
+	}
+}
+
+#else /* configUSE_TIMER_WHEEL */
+
 static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
 {
 TickType_t xTimeNow;
@@ -617,6 +1381,7 @@ BaseType_t xTimerListsWereSwitched;
 					xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
 				}
 
+				prvDaemonBlocking( xTimeNow, xNextExpireTime, xListWasEmpty );
 				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
 
 				if( xTaskResumeAll() == pdFALSE )
@@ -631,6 +1396,8 @@ BaseType_t xTimerListsWereSwitched;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				prvDaemonRunning();
 			}
 		}
 		else
@@ -639,8 +1406,42 @@ BaseType_t xTimerListsWereSwitched;
 		}
 	}
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 1 )
+
+static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
+{
+TickType_t xNextExpireTime = ( TickType_t ) 0U;
+TickType_t xTick;
+
+	/* Find the next tick at which the wheel passes a slot that holds a timer.
+	The timer may be a revolution or more away, in which case turning the wheel
+	to that tick finds nothing to do, but no timer can expire before it.  If
+	every slot is empty there are no active timers. */
+	*pxListWasEmpty = pdTRUE;
+
+	for( xTick = ( TickType_t ) 1; xTick <= ( TickType_t ) configTIMER_WHEEL_SLOTS; xTick++ )
+	{
+		if( listLIST_IS_EMPTY( &( xTimerWheel[ ( xWheelTime + xTick ) & tmrWHEEL_SLOT_MASK ] ) ) == pdFALSE )
+		{
+			xNextExpireTime = xWheelTime + xTick;
+			*pxListWasEmpty = pdFALSE;
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xNextExpireTime;
+}
+
+#else /* configUSE_TIMER_WHEEL */
+
 static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
 {
 TickType_t xNextExpireTime;
@@ -665,8 +1466,32 @@ TickType_t xNextExpireTime;
 
 	return xNextExpireTime;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 1 )
+
+static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
+{
+TickType_t xTimeNow;
+
+	xTimeNow = xTaskGetTickCount();
+
+	/* Turn the wheel up to the time now before a command inserts a timer, so
+	every active timer still expires after xWheelTime.  This also stops
+	xWheelTime falling a whole tick count range behind while no timers are
+	active. */
+	prvAdvanceWheel( xTimeNow );
+
+	/* There are no timer lists to switch. */
+	*pxTimerListsWereSwitched = pdFALSE;
+
+	return xTimeNow;
+}
+
+#else /* configUSE_TIMER_WHEEL */
+
 static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
 {
 TickType_t xTimeNow;
@@ -688,8 +1513,38 @@ PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Va
 
 	return xTimeNow;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 1 )
+
+static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
+{
+BaseType_t xProcessTimerNow = pdFALSE;
+
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+	/* Has the expiry time elapsed between the command to start/reset a timer
+	being issued, and the command being processed?  Both times are measured
+	from the command time, so a tick count overflow in between does not
+	matter. */
+	if( ( ( TickType_t ) ( xNextExpiryTime - xCommandTime ) ) <= ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+	{
+		xProcessTimerNow = pdTRUE;
+	}
+	else
+	{
+		/* The order of the timers within a slot does not matter. */
+		vListInsertEnd( &( xTimerWheel[ xNextExpiryTime & tmrWHEEL_SLOT_MASK ] ), &( pxTimer->xTimerListItem ) );
+	}
+
+	return xProcessTimerNow;
+}
+
+#else /* configUSE_TIMER_WHEEL */
+
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
 {
 BaseType_t xProcessTimerNow = pdFALSE;
@@ -700,8 +1555,10 @@ BaseType_t xProcessTimerNow = pdFALSE;
 	if( xNextExpiryTime <= xTimeNow )
 	{
 		/* Has the expiry time elapsed between the command to start/reset a
-		timer was issued, and the time the command was processed? */
-		if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		timer was issued, and the time the command was processed?  The time
+		to the expiry is used rather than the period, as with
+		configUSE_TIMER_PHASE_LOCK the two can differ by a tick. */
+		if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= ( ( TickType_t ) ( xNextExpiryTime - xCommandTime ) ) ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		{
 			/* The time between a command being issued and the command being
 			processed actually exceeds the timers period.  */
@@ -729,14 +1586,16 @@ BaseType_t xProcessTimerNow = pdFALSE;
 
 	return xProcessTimerNow;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void	prvProcessReceivedCommands( void )
 {
 DaemonTaskMessage_t xMessage;
 Timer_t *pxTimer;
-BaseType_t xTimerListsWereSwitched, xResult;
-TickType_t xTimeNow;
+BaseType_t xTimerListsWereSwitched;
+TickType_t xTimeNow, xExpiryTime;
 
 	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
 	{
@@ -797,25 +1656,17 @@ TickType_t xTimeNow;
 				case tmrCOMMAND_RESET :
 				case tmrCOMMAND_RESET_FROM_ISR :
 				case tmrCOMMAND_START_DONT_TRACE :
-					/* Start or restart a timer. */
+					/* Start or restart a timer.  Its phase is taken from the
+					time the command was sent. */
 					pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-					if( prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
+					prvResetTimerPhase( pxTimer );
+					xExpiryTime = xMessage.u.xTimerParameters.xMessageValue + prvGetReloadPeriod( pxTimer );
+
+					if( prvInsertTimerInActiveList( pxTimer, xExpiryTime, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
 					{
 						/* The timer expired before it was added to the active
 						timer list.  Process it now. */
-						pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-						traceTIMER_EXPIRED( pxTimer );
-
-						if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-						{
-							xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-							configASSERT( xResult );
-							( void ) xResult;
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
+						prvTimerExpired( pxTimer, xExpiryTime, xTimeNow );
 					}
 					else
 					{
@@ -823,12 +1674,48 @@ TickType_t xTimeNow;
 					}
 					break;
 
+				#if( configUSE_TIMER_PHASE_LOCK == 1 )
+					case tmrCOMMAND_START_AT :
+					case tmrCOMMAND_START_AT_FROM_ISR :
+						/* Start a timer with its first expiry at an absolute
+						time, which anchors its phase.  There is no command
+						time to measure the expiry time from, so it is taken to
+						have passed if it is no more than half the range of the
+						tick count behind the time now. */
+						pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+						prvResetTimerPhase( pxTimer );
+						xExpiryTime = xMessage.u.xTimerParameters.xMessageValue;
+
+						if( ( ( TickType_t ) ( xTimeNow - xExpiryTime ) ) > ( portMAX_DELAY >> 1 ) )
+						{
+							/* The expiry time is in the future, so measured
+							from the time now it cannot be processed
+							immediately. */
+							( void ) prvInsertTimerInActiveList( pxTimer, xExpiryTime, xTimeNow, xTimeNow );
+						}
+						else
+						{
+							prvTimerExpired( pxTimer, xExpiryTime, xTimeNow );
+						}
+						break;
+				#endif /* configUSE_TIMER_PHASE_LOCK */
+
 				case tmrCOMMAND_STOP :
 				case tmrCOMMAND_STOP_FROM_ISR :
 					/* The timer has already been removed from the active list. */
 					pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
 					break;
 
+				#if( configUSE_TIMER_PHASE_LOCK == 1 )
+					case tmrCOMMAND_CHANGE_PERIOD_EXACT :
+					case tmrCOMMAND_CHANGE_PERIOD_EXACT_FROM_ISR :
+						/* The fraction is set here, with the period, so the
+						two cannot be out of step if the command fails to be
+						sent or the timer reloads before it is processed. */
+						pxTimer->ulPeriodFraction = xMessage.u.xTimerParameters.ulPeriodFraction;
+						/* Fall through. */
+				#endif /* configUSE_TIMER_PHASE_LOCK */
+
 				case tmrCOMMAND_CHANGE_PERIOD :
 				case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
 					pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
@@ -841,7 +1728,8 @@ TickType_t xTimeNow;
 					be zero the next expiry time can only be in the future,
 					meaning (unlike for the xTimerStart() case above) there is
 					no fail case that needs to be handled here. */
-					( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+					prvResetTimerPhase( pxTimer );
+					( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + prvGetReloadPeriod( pxTimer ) ), xTimeNow, xTimeNow );
 					break;
 
 				case tmrCOMMAND_DELETE :
@@ -879,12 +1767,12 @@ TickType_t xTimeNow;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 0 )
+
 static void prvSwitchTimerLists( void )
 {
-TickType_t xNextExpireTime, xReloadTime;
+TickType_t xNextExpireTime;
 List_t *pxTemp;
-Timer_t *pxTimer;
-BaseType_t xResult;
 
 	/* The tick count has overflowed.  The timer lists must be switched.
 	If there are any timers still referenced from the current timer list
@@ -894,48 +1782,20 @@ BaseType_t xResult;
 	{
 		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-		/* Remove the timer from the list. */
-		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-		traceTIMER_EXPIRED( pxTimer );
-
-		/* Execute its callback, then send a command to restart the timer if
-		it is an auto-reload timer.  It cannot be restarted here as the lists
-		have not yet been switched. */
-		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-
-		if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-		{
-			/* Calculate the reload value, and if the reload value results in
-			the timer going into the same timer list then it has already expired
-			and the timer should be re-inserted into the current list so it is
-			processed again within this loop.  Otherwise a command should be sent
-			to restart the timer to ensure it is only inserted into a list after
-			the lists have been swapped. */
-			xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
-			if( xReloadTime > xNextExpireTime )
-			{
-				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
-				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
-			}
-			else
-			{
-				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-				configASSERT( xResult );
-				( void ) xResult;
-			}
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+		/* Process the timer as if the time now were the last tick before the
+		overflow.  An auto-reload timer whose next expiry time is also before
+		the overflow is expired again by prvReloadTimer(), and one whose next
+		expiry time is after the overflow goes into the overflow list, which
+		is about to become the current list. */
+		prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
 	}
 
 	pxTemp = pxCurrentTimerList;
 	pxCurrentTimerList = pxOverflowTimerList;
 	pxOverflowTimerList = pxTemp;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
@@ -947,10 +1807,25 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+			UBaseType_t x;
+
+				for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTIMER_WHEEL_SLOTS; x++ )
+				{
+					vListInitialise( &( xTimerWheel[ x ] ) );
+				}
+
+				xWheelTime = xTaskGetTickCount();
+			}
+			#else
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -0,0 +1,85 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    clock_profile.h
+  * @brief   Predefined system clock profiles, switchable while the scheduler
+  *          is running.
+  ******************************************************************************
+  * @attention
+  *
+  * SystemClock_Config() sets the clock the application starts with.  After
+  * that, xClockProfileSet() moves the system to any of the profiles below,
+  * reprogramming the PLL, the regulator voltage scale, over-drive, the flash
+  * wait states and the bus dividers in the order the reference manual
+  * requires.  Everything derived from the core clock follows it: the SysTick
+  * reload value (so configTICK_RATE_HZ is kept), the HAL time base timer,
+  * and, when they are enabled, the hrtimer prescaler and the trace recorder
+  * timestamp rate.
+  *
+  *   Profile                SYSCLK   Source    Scale  Over-drive  Flash  APB1/APB2
+  *   CLOCK_PROFILE_180MHZ   180 MHz  HSE, PLL  1      on          5 WS   /4 /2
+  *   CLOCK_PROFILE_168MHZ   168 MHz  HSE, PLL  1      off         5 WS   /4 /2
+  *   CLOCK_PROFILE_72MHZ     72 MHz  HSE, PLL  3      off         2 WS   /2 /1
+  *   CLOCK_PROFILE_16MHZ     16 MHz  HSI       3      off         0 WS   /1 /1
+  *
+  * A typical use is to run flat out while there is work queued and drop to a
+  * lower profile when the system goes quiet, from a low priority task:
+  *
+  *   xClockProfileSet(CLOCK_PROFILE_180MHZ);
+  *   ...
+  *   xClockProfileSet(CLOCK_PROFILE_16MHZ);
+  *
+  * Peripherals whose timing is worked out from a bus clock when they are
+  * initialised, such as UART baud rates, must be brought in line afterwards.
+  * vClockProfileChangingHook() is called before the switch, to let transfers
+  * in progress finish, and vClockProfileChangedHook() after it.  A task may
+  * be suspended part way through using the peripheral, so the hooks must not
+  * reinitialise its handle; for a UART, call vClockProfileUartWaitIdle() from
+  * the first and vClockProfileUartRetune() from the second.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CLOCK_PROFILE_H
+#define __CLOCK_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  CLOCK_PROFILE_180MHZ = 0U,
+  CLOCK_PROFILE_168MHZ,
+  CLOCK_PROFILE_72MHZ,
+  CLOCK_PROFILE_16MHZ,
+  CLOCK_PROFILE_COUNT
+} ClockProfile_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Returned by eClockProfileGet() while the system runs at a clock that is not
+   one of the profiles, for example one set up by SystemClock_Config(). */
+#define CLOCK_PROFILE_NONE        CLOCK_PROFILE_COUNT
+
+/* Exported functions prototypes ---------------------------------------------*/
+HAL_StatusTypeDef xClockProfileSet(ClockProfile_t eProfile);
+ClockProfile_t eClockProfileGet(void);
+void vClockProfileChangingHook(ClockProfile_t eProfile);
+void vClockProfileChangedHook(ClockProfile_t eProfile);
+#ifdef HAL_UART_MODULE_ENABLED
+void vClockProfileUartWaitIdle(UART_HandleTypeDef *huart);
+void vClockProfileUartRetune(UART_HandleTypeDef *huart);
+#endif /* HAL_UART_MODULE_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CLOCK_PROFILE_H */
@@ -0,0 +1,18 @@
+/* Generated by tools/stack_analyzer.py from the -fstack-usage output and the
+ * call graph of the linked image.  Do not edit: the file is rewritten by every
+ * build whose worst case stack usage changed.
+ *
+ * Each size is the deepest call chain of the task, plus 204 bytes for the
+ * port to save the task context and a 32 byte margin, in words.
+ */
+
+#ifndef TASK_STACKS_H
+#define TASK_STACKS_H
+
+/* HPT_Task: 216 bytes, HPT_Task -> Sende_Uart -> HAL_UART_Transmit -> UART_WaitOnFlagUntilTimeout -> UART_EndRxTransfer */
+#define TASK_STACK_WORDS_HPT_Task 114
+
+/* MPT_Task: 216 bytes, MPT_Task -> Sende_Uart -> HAL_UART_Transmit -> UART_WaitOnFlagUntilTimeout -> UART_EndRxTransfer */
+#define TASK_STACK_WORDS_MPT_Task 114
+
+#endif /* TASK_STACKS_H */
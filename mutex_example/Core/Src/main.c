@@ -31,6 +31,8 @@
 
 #include "string.h"
 #include "stdio.h"
+#include "task_stacks.h"
+#include "clock_profile.h"
 
 
 /* USER CODE END Includes */
@@ -131,8 +133,8 @@ int main(void)
 
   ///create tasks
 
-  xTaskCreate(HPT_Task, "HPT", 128, NULL, 3, &HPT_Handler);
-  xTaskCreate(MPT_Task, "MPT", 128, NULL, 2, &MPT_Handler);
+  xTaskCreate(HPT_Task, "HPT", TASK_STACK_WORDS_HPT_Task, NULL, 3, &HPT_Handler);
+  xTaskCreate(MPT_Task, "MPT", TASK_STACK_WORDS_MPT_Task, NULL, 2, &MPT_Handler);
   //xTaskCreate(LPT_Task, "LPT", 128, NULL, 3, &LPT_Handler);
 
   vTaskStartScheduler();
@@ -321,6 +323,33 @@ void MPT_Task(void *argument)
 	}
 }
 
+/**
+  * @brief  Let the byte being sent on the UART finish before the bus clock
+  *         changes under it.
+  * @param  eProfile: Profile about to be switched to.
+  * @retval None
+  */
+void vClockProfileChangingHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartWaitIdle(&huart1);
+}
+
+/**
+  * @brief  Recompute the UART baud rate divider for the bus clock of the new
+  *         clock profile.  A task may be part way through
+  *         HAL_UART_Transmit(), so only BRR is rewritten.
+  * @param  eProfile: Profile now running.
+  * @retval None
+  */
+void vClockProfileChangedHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartRetune(&huart1);
+}
+
 /* USER CODE END 4 */
 
 
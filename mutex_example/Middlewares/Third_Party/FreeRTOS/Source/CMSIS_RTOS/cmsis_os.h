@@ -159,6 +159,42 @@ used throughout the whole project.
 #define osFeature_Wait         0       ///< osWait function: 1=available, 0=not available
 #define osFeature_SysTick      1       ///< osKernelSysTick functions: 1=available, 0=not available
 
+/// Set configUSE_CMSIS_FAST_SEMAPHORES to 1 in FreeRTOSConfig.h to implement osSemaphore objects
+/// as an atomic count plus direct to task notifications instead of FreeRTOS queues.
+/// Uncontended waits and releases then never enter a critical section.
+#ifndef configUSE_CMSIS_FAST_SEMAPHORES
+#define configUSE_CMSIS_FAST_SEMAPHORES 0
+#endif
+
+#if (configUSE_CMSIS_FAST_SEMAPHORES == 1) && (configUSE_TASK_NOTIFICATIONS != 1)
+#error configUSE_CMSIS_FAST_SEMAPHORES requires configUSE_TASK_NOTIFICATIONS to be set to 1
+#endif
+
+/// The CMSIS-RTOS2 API in cmsis_os2.h is built into the same image, and reuses some of the
+/// names below with different arguments.  The v1 functions are linked under these names
+/// instead, so code can move to cmsis_os2.h one source file at a time - see freertos_os2.h.
+/// A source file includes either cmsis_os.h or cmsis_os2.h, not both.
+#define osKernelInitialize     osKernelInitialize_v1
+#define osKernelStart          osKernelStart_v1
+#define osThreadGetId          osThreadGetId_v1
+#define osThreadTerminate      osThreadTerminate_v1
+#define osThreadYield          osThreadYield_v1
+#define osThreadSetPriority    osThreadSetPriority_v1
+#define osThreadGetPriority    osThreadGetPriority_v1
+#define osThreadGetState       osThreadGetState_v1
+#define osThreadSuspend        osThreadSuspend_v1
+#define osThreadResume         osThreadResume_v1
+#define osDelay                osDelay_v1
+#define osDelayUntil           osDelayUntil_v1
+#define osTimerStart           osTimerStart_v1
+#define osTimerStop            osTimerStop_v1
+#define osTimerDelete          osTimerDelete_v1
+#define osMutexRelease         osMutexRelease_v1
+#define osMutexDelete          osMutexDelete_v1
+#define osSemaphoreRelease     osSemaphoreRelease_v1
+#define osSemaphoreDelete      osSemaphoreDelete_v1
+#define osSemaphoreGetCount    osSemaphoreGetCount_v1
+
 #ifdef  __cplusplus
 extern "C"
 {
@@ -247,7 +283,11 @@ typedef SemaphoreHandle_t osMutexId;
 
 /// Semaphore ID identifies the semaphore (pointer to a semaphore control block).
 /// \note CAN BE CHANGED: \b os_semaphore_cb is implementation specific in every CMSIS-RTOS.
+#if (configUSE_CMSIS_FAST_SEMAPHORES == 1)
+typedef struct os_semaphore_cb *osSemaphoreId;
+#else
 typedef SemaphoreHandle_t osSemaphoreId;
+#endif
 
 /// Pool ID identifies the memory pool (pointer to a memory pool control block).
 /// \note CAN BE CHANGED: \b os_pool_cb is implementation specific in every CMSIS-RTOS.
@@ -1019,6 +1059,86 @@ osStatus osRecursiveMutexWait (osMutexId mutex_id, uint32_t millisec);
 */
 uint32_t osSemaphoreGetCount(osSemaphoreId semaphore_id);
 
+/*************************** Interrupt service routine entry points ***********/
+/*
+ * The functions above can be called from threads and from interrupt service
+ * routines, and read IPSR on every call to find out which.  An interrupt
+ * handler knows where it runs, so it can call these instead: they go straight
+ * to the FreeRTOS FromISR functions, never wait, and request a context switch
+ * on return when they wake a higher priority thread.  As with any FreeRTOS
+ * FromISR call, the interrupt priority must not be above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.  Calling them from a thread is an
+ * error.
+ */
+
+/**
+* @brief  Start or restart a timer from an ISR, see \ref osTimerStart.
+*/
+osStatus osTimerStartFromISR (osTimerId timer_id, uint32_t millisec);
+
+/**
+* @brief  Stop a timer from an ISR, see \ref osTimerStop.
+*/
+osStatus osTimerStopFromISR (osTimerId timer_id);
+
+/**
+* @brief  Set Signal Flags of a thread from an ISR, see \ref osSignalSet.
+*/
+int32_t osSignalSetFromISR (osThreadId thread_id, int32_t signal);
+
+#if (defined (osFeature_Semaphore)  &&  (osFeature_Semaphore != 0))
+/**
+* @brief  Take a Semaphore token from an ISR, see \ref osSemaphoreWait with no time-out.
+*/
+int32_t osSemaphoreWaitFromISR (osSemaphoreId semaphore_id);
+
+/**
+* @brief  Release a Semaphore token from an ISR, see \ref osSemaphoreRelease.
+*/
+osStatus osSemaphoreReleaseFromISR (osSemaphoreId semaphore_id);
+#endif
+
+#if (defined (osFeature_Pool)  &&  (osFeature_Pool != 0))
+/**
+* @brief  Allocate a memory block from an ISR, see \ref osPoolAlloc.
+*/
+void *osPoolAllocFromISR (osPoolId pool_id);
+#endif
+
+#if (defined (osFeature_MessageQ)  &&  (osFeature_MessageQ != 0))
+/**
+* @brief  Put a Message to a Queue from an ISR, see \ref osMessagePut.
+*/
+osStatus osMessagePutFromISR (osMessageQId queue_id, uint32_t info);
+
+/**
+* @brief  Get a Message from a Queue from an ISR, see \ref osMessageGet with no time-out.
+*/
+osEvent osMessageGetFromISR (osMessageQId queue_id);
+#endif
+
+#if (defined (osFeature_MailQ)  &&  (osFeature_MailQ != 0))
+/**
+* @brief  Allocate a memory block for mail from an ISR, see \ref osMailAlloc with no time-out.
+*/
+void *osMailAllocFromISR (osMailQId queue_id);
+
+/**
+* @brief  Put a mail to a queue from an ISR, see \ref osMailPut.
+*/
+osStatus osMailPutFromISR (osMailQId queue_id, void *mail);
+
+/**
+* @brief  Get a mail from a queue from an ISR, see \ref osMailGet with no time-out.
+*/
+osEvent osMailGetFromISR (osMailQId queue_id);
+
+/**
+* @brief  Free a memory block from a mail from an ISR, see \ref osMailFree.
+*/
+osStatus osMailFreeFromISR (osMailQId queue_id, void *mail);
+#endif
+
 #ifdef  __cplusplus
 }
 #endif
@@ -166,6 +166,19 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Allocate and free the TCBs and stacks of tasks created by xTaskCreate().
+ * Provided by the application when configTASK_MEMORY_FROM_SEPARATE_HEAP is 1,
+ * otherwise the same as pvPortMalloc() and vPortFree().
+ */
+#if( configTASK_MEMORY_FROM_SEPARATE_HEAP == 1 )
+	void *pvPortMallocTaskMemory( size_t xSize ) PRIVILEGED_FUNCTION;
+	void vPortFreeTaskMemory( void *pv ) PRIVILEGED_FUNCTION;
+#else
+	#define pvPortMallocTaskMemory		pvPortMalloc
+	#define vPortFreeTaskMemory			vPortFree
+#endif
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
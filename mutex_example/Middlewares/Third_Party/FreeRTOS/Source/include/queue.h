@@ -899,6 +899,38 @@ UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue ) PRIVILEGED_FUNC
  */
 UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>UBaseType_t uxQueueGetQueueItemSize( const QueueHandle_t xQueue );</pre>
+ *
+ * Return the size, in bytes, of each item the queue holds - the uxItemSize
+ * value the queue was created with.  Can be called from an interrupt.
+ *
+ * @param xQueue A handle to the queue being queried.
+ *
+ * @return The size of each item in the queue.
+ *
+ * \defgroup uxQueueGetQueueItemSize uxQueueGetQueueItemSize
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueGetQueueItemSize( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>UBaseType_t uxQueueGetQueueLength( const QueueHandle_t xQueue );</pre>
+ *
+ * Return the maximum number of items the queue can hold - the uxQueueLength
+ * value the queue was created with.  Can be called from an interrupt.
+ *
+ * @param xQueue A handle to the queue being queried.
+ *
+ * @return The length of the queue.
+ *
+ * \defgroup uxQueueGetQueueLength uxQueueGetQueueLength
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueGetQueueLength( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * <pre>void vQueueDelete( QueueHandle_t xQueue );</pre>
@@ -1413,6 +1445,8 @@ BaseType_t xQueueCRReceive( QueueHandle_t xQueue, void *pvBuffer, TickType_t xTi
  */
 QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeilingStatic( const UBaseType_t uxCeilingPriority, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
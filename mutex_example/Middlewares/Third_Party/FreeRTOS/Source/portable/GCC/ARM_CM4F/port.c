@@ -84,6 +84,8 @@ r0p1 port. */
 /* Constants required to manipulate the VFP. */
 #define portFPCCR							( ( volatile uint32_t * ) 0xe000ef34 ) /* Floating point context control register. */
 #define portASPEN_AND_LSPEN_BITS			( 0x3UL << 30UL )
+#define portCPACR							( ( volatile uint32_t * ) 0xe000ed88 ) /* Coprocessor access control register. */
+#define portCPACR_CP10_CP11_FULL_ACCESS		( 0xfUL << 20UL )
 
 /* Constants required to set up the initial stack. */
 #define portINITIAL_XPSR					( 0x01000000 )
@@ -117,6 +119,13 @@ debugger. */
  */
 void vPortSetupTimerInterrupt( void );
 
+/*
+ * Reprogram the timer that generates the tick interrupts after its clock has
+ * changed.  Also weak, so it can be replaced along with
+ * vPortSetupTimerInterrupt().
+ */
+void vPortRecalibrateTimerInterrupt( void );
+
 /*
  * Exception handlers.
  */
@@ -130,9 +139,12 @@ void vPortSVCHandler( void ) __attribute__ (( naked ));
 static void prvPortStartFirstTask( void ) __attribute__ (( naked ));
 
 /*
- * Function to enable the VFP.
+ * Function to enable the VFP.  When configUSE_TASK_FPU_FLAG is 1 the kernel
+ * enables and disables the VFP per task using vPortSetTaskFPUAccess() instead.
  */
-static void vPortEnableVFP( void ) __attribute__ (( naked ));
+#if( configUSE_TASK_FPU_FLAG == 0 )
+	static void vPortEnableVFP( void ) __attribute__ (( naked ));
+#endif
 
 /*
  * Used to catch tasks that attempt to return from their implementing function.
@@ -369,8 +381,17 @@ BaseType_t xPortStartScheduler( void )
 	/* Initialise the critical nesting count ready for the first task. */
 	uxCriticalNesting = 0;
 
-	/* Ensure the VFP is enabled - it should be anyway. */
-	vPortEnableVFP();
+	#if( configUSE_TASK_FPU_FLAG == 0 )
+	{
+		/* Ensure the VFP is enabled - it should be anyway. */
+		vPortEnableVFP();
+	}
+	#else
+	{
+		/* The kernel has already enabled or disabled the VFP to match the
+		first task, so leave it alone. */
+	}
+	#endif
 
 	/* Lazy save always. */
 	*( portFPCCR ) |= portASPEN_AND_LSPEN_BITS;
@@ -493,6 +514,8 @@ void xPortSysTickHandler( void )
 	known. */
 	portDISABLE_INTERRUPTS();
 	{
+		traceISR_ENTER();
+
 		/* Increment the RTOS tick. */
 		if( xTaskIncrementTick() != pdFALSE )
 		{
@@ -500,6 +523,8 @@ void xPortSysTickHandler( void )
 			the PendSV interrupt.  Pend the PendSV interrupt. */
 			portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
 		}
+
+		traceISR_EXIT();
 	}
 	portENABLE_INTERRUPTS();
 }
@@ -697,21 +722,106 @@ __attribute__(( weak )) void vPortSetupTimerInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
-/* This is a naked function. */
-static void vPortEnableVFP( void )
+/*
+ * Recalculate the SysTick reload value from configSYSTICK_CLOCK_HZ after the
+ * application has changed the core clock (and with it SystemCoreClock), so the
+ * tick keeps running at configTICK_RATE_HZ.
+ */
+__attribute__(( weak )) void vPortRecalibrateTimerInterrupt( void )
 {
-	__asm volatile
-	(
-		"	ldr.w r0, =0xE000ED88		\n" /* The FPU enable bits are in the CPACR. */
-		"	ldr r1, [r0]				\n"
-		"								\n"
-		"	orr r1, r1, #( 0xf << 20 )	\n" /* Enable CP10 and CP11 coprocessors, then save back. */
-		"	str r1, [r0]				\n"
-		"	bx r14						"
-	);
+uint32_t ulCountsForOneTick, ulRemainingCounts, ulSavedInterruptStatus;
+
+	ulCountsForOneTick = ( configSYSTICK_CLOCK_HZ / configTICK_RATE_HZ );
+	configASSERT( ( ulCountsForOneTick - 1UL ) <= portMAX_24_BIT_NUMBER );
+
+	/* Also called before the scheduler has started, when a critical section
+	would leave interrupts masked, so the mask is saved and restored. */
+	ulSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		#if( configUSE_TICKLESS_IDLE == 1 )
+		{
+			ulTimerCountsForOneTick = ulCountsForOneTick;
+			xMaximumPossibleSuppressedTicks = portMAX_24_BIT_NUMBER / ulTimerCountsForOneTick;
+			ulStoppedTimerCompensation = portMISSED_COUNTS_FACTOR / ( configCPU_CLOCK_HZ / configSYSTICK_CLOCK_HZ );
+		}
+		#endif /* configUSE_TICKLESS_IDLE */
+
+		/* Before the scheduler has started there is nothing more to do -
+		vPortSetupTimerInterrupt() reads the new clock when it starts. */
+		if( ( portNVIC_SYSTICK_CTRL_REG & portNVIC_SYSTICK_ENABLE_BIT ) != 0UL )
+		{
+			/* Scale what remains of the current tick period to the new clock,
+			so the tick in progress keeps its length and no tick is gained or
+			lost.  A remainder shorter than the restart below takes, which
+			portMISSED_COUNTS_FACTOR estimates, is extended slightly. */
+			ulRemainingCounts = ( uint32_t ) ( ( ( uint64_t ) portNVIC_SYSTICK_CURRENT_VALUE_REG * ulCountsForOneTick ) / ( portNVIC_SYSTICK_LOAD_REG + 1UL ) );
+			if( ulRemainingCounts < portMISSED_COUNTS_FACTOR )
+			{
+				ulRemainingCounts = portMISSED_COUNTS_FACTOR;
+			}
+
+			/* Run the remainder, then the new reload value, as the tickless
+			idle code does when it wakes. */
+			portNVIC_SYSTICK_CTRL_REG = ( portNVIC_SYSTICK_CLK_BIT | portNVIC_SYSTICK_INT_BIT );
+			portNVIC_SYSTICK_LOAD_REG = ulRemainingCounts;
+			portNVIC_SYSTICK_CURRENT_VALUE_REG = 0UL;
+			portNVIC_SYSTICK_CTRL_REG |= portNVIC_SYSTICK_ENABLE_BIT;
+			portNVIC_SYSTICK_LOAD_REG = ulCountsForOneTick - 1UL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( ulSavedInterruptStatus );
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TASK_FPU_FLAG == 0 )
+
+	/* This is a naked function. */
+	static void vPortEnableVFP( void )
+	{
+		__asm volatile
+		(
+			"	ldr.w r0, =0xE000ED88		\n" /* The FPU enable bits are in the CPACR. */
+			"	ldr r1, [r0]				\n"
+			"								\n"
+			"	orr r1, r1, #( 0xf << 20 )	\n" /* Enable CP10 and CP11 coprocessors, then save back. */
+			"	str r1, [r0]				\n"
+			"	bx r14						"
+		);
+	}
+
+#endif /* configUSE_TASK_FPU_FLAG */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_FPU_FLAG == 1 )
+
+	void vPortSetTaskFPUAccess( BaseType_t xTaskUsesFPU )
+	{
+		/* Called from the PendSV handler after the outgoing task's high VFP
+		registers have been stacked, which also completes any lazy stacking
+		of the low registers, so the VFP is never disabled while it still
+		holds state that has to be saved.  A task that has not been marked as
+		using the VFP never sets CONTROL.FPCA, so its stack frames stay the
+		basic 8 words and its switches never touch the VFP registers. */
+		if( xTaskUsesFPU != pdFALSE )
+		{
+			*( portCPACR ) |= portCPACR_CP10_CP11_FULL_ACCESS;
+		}
+		else
+		{
+			*( portCPACR ) &= ~portCPACR_CP10_CP11_FULL_ACCESS;
+		}
+
+		__asm volatile( "dsb" ::: "memory" );
+		__asm volatile( "isb" );
+	}
+
+#endif /* configUSE_TASK_FPU_FLAG */
+/*-----------------------------------------------------------*/
+
 #if( configASSERT_DEFINED == 1 )
 
 	void vPortValidateInterruptPriority( void )
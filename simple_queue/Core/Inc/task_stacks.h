@@ -0,0 +1,21 @@
+/* Generated by tools/stack_analyzer.py from the -fstack-usage output and the
+ * call graph of the linked image.  Do not edit: the file is rewritten by every
+ * build whose worst case stack usage changed.
+ *
+ * Each size is the deepest call chain of the task, plus 204 bytes for the
+ * port to save the task context and a 32 byte margin, in words.
+ */
+
+#ifndef TASK_STACKS_H
+#define TASK_STACKS_H
+
+/* Sender_HPT_Task: 200 bytes, Sender_HPT_Task -> HAL_UART_Transmit -> UART_WaitOnFlagUntilTimeout -> UART_EndRxTransfer */
+#define TASK_STACK_WORDS_Sender_HPT_Task 110
+
+/* Sender_LPT_Task: 200 bytes, Sender_LPT_Task -> HAL_UART_Transmit -> UART_WaitOnFlagUntilTimeout -> UART_EndRxTransfer */
+#define TASK_STACK_WORDS_Sender_LPT_Task 110
+
+/* Receiver_Task: 648 bytes, Receiver_Task -> siprintf -> _svfiprintf_r -> __ssputs_r -> _realloc_r -> _malloc_r -> sbrk_aligned -> _sbrk_r -> _sbrk -> __errno */
+#define TASK_STACK_WORDS_Receiver_Task 222
+
+#endif /* TASK_STACKS_H */
@@ -32,6 +32,8 @@
 
 #include "string.h"
 #include "stdio.h"
+#include "task_stacks.h"
+#include "clock_profile.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -133,10 +135,10 @@ int main(void)
 
   /*********************************Task Related********************************************/
 
-  xTaskCreate(Sender_HPT_Task, "HPT_SEND", 128, NULL, 3, &Sender_HPT_Handler);
-  xTaskCreate(Sender_LPT_Task, "LPT_SEND", 128, (void *)111, 2, &Sender_LPT_Handler);
+  xTaskCreate(Sender_HPT_Task, "HPT_SEND", TASK_STACK_WORDS_Sender_HPT_Task, NULL, 3, &Sender_HPT_Handler);
+  xTaskCreate(Sender_LPT_Task, "LPT_SEND", TASK_STACK_WORDS_Sender_LPT_Task, (void *)111, 2, &Sender_LPT_Handler);
 
-  xTaskCreate(Receiver_Task, "Receive", 128, NULL, 1, &Receiver_Handler);
+  xTaskCreate(Receiver_Task, "Receive", TASK_STACK_WORDS_Receiver_Task, NULL, 1, &Receiver_Handler);
 
   HAL_UART_Receive_IT(&huart1, &Rx_data, 1);
 
@@ -349,6 +351,34 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 	}
 }
+
+/**
+  * @brief  Let the byte being sent on the UART finish before the bus clock
+  *         changes under it.
+  * @param  eProfile: Profile about to be switched to.
+  * @retval None
+  */
+void vClockProfileChangingHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartWaitIdle(&huart1);
+}
+
+/**
+  * @brief  Recompute the UART baud rate divider for the bus clock of the new
+  *         clock profile.  A task may be part way through
+  *         HAL_UART_Transmit(), so only BRR is rewritten.
+  * @param  eProfile: Profile now running.
+  * @retval None
+  */
+void vClockProfileChangedHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartRetune(&huart1);
+}
+
 /* USER CODE END 4 */
 
 
@@ -60,10 +60,27 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
 #endif
 
+/* When configUSE_EVENT_GROUP_DIRECT_WAKE is 1 interrupts set bits and unblock
+tasks themselves, so a task must test the bits and block in a critical section
+as well as with the scheduler suspended. */
+#if( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+	#define eventENTER_CRITICAL()	taskENTER_CRITICAL()
+	#define eventEXIT_CRITICAL()	taskEXIT_CRITICAL()
+#else
+	#define eventENTER_CRITICAL()
+	#define eventEXIT_CRITICAL()
+#endif
+
 typedef struct EventGroupDef_t
 {
 	EventBits_t uxEventBits;
-	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
+
+	#if( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+		List_t xTasksWaitingForBits[ configEVENT_GROUP_WAITER_LISTS ];		/*< Lists of tasks waiting for a bit to be set, indexed by the lowest bit each task waits for. */
+		EventBits_t uxBitsWaitedFor[ configEVENT_GROUP_WAITER_LISTS ];		/*< At least the bits waited for by the tasks in each list. */
+	#else
+		List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
+	#endif
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxEventGroupNumber;
@@ -86,6 +103,28 @@ typedef struct EventGroupDef_t
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the list, or lists, of tasks waiting for bits.
+ */
+static void prvInitialiseWaitingLists( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place the calling task in the list of tasks waiting for bits.  uxValue is
+ * the bits waited for combined with the control bits.
+ */
+static void prvPlaceOnWaitingList( EventGroup_t *pxEventBits, const EventBits_t uxValue, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+
+	/*
+	 * Set bits and unblock the tasks whose wait condition is then met.  Must be
+	 * called from a critical section, which can be within an ISR.  Returns
+	 * pdTRUE if an unblocked task has a priority above the calling task.
+	 */
+	static BaseType_t prvSetBitsAndUnblock( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_WAKE */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -113,7 +152,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitingLists( pxEventBits );
 
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
@@ -164,7 +203,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitingLists( pxEventBits );
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -204,10 +243,22 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventENTER_CRITICAL();
 	{
 		uxOriginalBitValue = pxEventBits->uxEventBits;
 
-		( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
+		#if( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+		{
+			/* Tasks unblocked here are held pending until the scheduler is
+			resumed below, which also performs any yield that is needed. */
+			traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+			( void ) prvSetBitsAndUnblock( pxEventBits, uxBitsToSet );
+		}
+		#else
+		{
+			( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
+		}
+		#endif /* configUSE_EVENT_GROUP_DIRECT_WAKE */
 
 		if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
 		{
@@ -229,7 +280,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				prvPlaceOnWaitingList( pxEventBits, ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -246,6 +297,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			}
 		}
 	}
+	eventEXIT_CRITICAL();
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -327,6 +379,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventENTER_CRITICAL();
 	{
 		const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -384,7 +437,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			prvPlaceOnWaitingList( pxEventBits, ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -394,6 +447,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
 		}
 	}
+	eventEXIT_CRITICAL();
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -485,7 +539,29 @@ EventBits_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if ( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+
+	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		/* Clearing bits never unblocks a task, so is done straight away. */
+		traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			pxEventBits->uxEventBits &= ~uxBitsToClear;
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		return pdPASS;
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
 	{
@@ -516,6 +592,42 @@ EventBits_t uxReturn;
 } /*lint !e818 EventGroupHandle_t is a typedef used in other functions to so can't be pointer to const. */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+
+EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
+{
+EventGroup_t *pxEventBits = xEventGroup;
+EventBits_t uxReturn;
+BaseType_t xYieldRequired;
+
+	/* Check the user is not attempting to set the bits used by the kernel
+	itself. */
+	configASSERT( xEventGroup );
+	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+	taskENTER_CRITICAL();
+	{
+		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+
+		xYieldRequired = prvSetBitsAndUnblock( pxEventBits, uxBitsToSet );
+		uxReturn = pxEventBits->uxEventBits;
+	}
+	taskEXIT_CRITICAL();
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return uxReturn;
+}
+
+#else /* configUSE_EVENT_GROUP_DIRECT_WAKE */
+
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
 {
 ListItem_t *pxListItem, *pxNext;
@@ -608,24 +720,54 @@ BaseType_t xMatchFound = pdFALSE;
 
 	return pxEventBits->uxEventBits;
 }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_WAKE */
 /*-----------------------------------------------------------*/
 
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
 EventGroup_t *pxEventBits = xEventGroup;
-const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
-		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+		#if( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
 		{
-			/* Unblock the task, returning 0 as the event list is being deleted
-			and cannot therefore have any bits set. */
-			configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+		const List_t *pxTasksWaitingForBits;
+		UBaseType_t uxList;
+
+			taskENTER_CRITICAL();
+			{
+				for( uxList = 0; uxList < ( UBaseType_t ) configEVENT_GROUP_WAITER_LISTS; uxList++ )
+				{
+					pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits[ uxList ] );
+
+					while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+					{
+						/* Unblock the task, returning 0 as the event list is
+						being deleted and cannot therefore have any bits set.
+						The scheduler is suspended, so the task is held pending
+						until it is resumed. */
+						( void ) xTaskRemoveFromUnorderedEventListFromISR( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
 		}
+		#else
+		{
+		const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+
+			while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+			{
+				/* Unblock the task, returning 0 as the event list is being deleted
+				and cannot therefore have any bits set. */
+				configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+				vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			}
+		}
+		#endif /* configUSE_EVENT_GROUP_DIRECT_WAKE */
 
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
@@ -703,7 +845,176 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+static void prvInitialiseWaitingLists( EventGroup_t *pxEventBits )
+{
+	#if( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+	{
+	UBaseType_t uxList;
+
+		for( uxList = 0; uxList < ( UBaseType_t ) configEVENT_GROUP_WAITER_LISTS; uxList++ )
+		{
+			vListInitialise( &( pxEventBits->xTasksWaitingForBits[ uxList ] ) );
+			pxEventBits->uxBitsWaitedFor[ uxList ] = 0;
+		}
+	}
+	#else
+	{
+		vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+	}
+	#endif /* configUSE_EVENT_GROUP_DIRECT_WAKE */
+}
+/*-----------------------------------------------------------*/
+
+static void prvPlaceOnWaitingList( EventGroup_t *pxEventBits, const EventBits_t uxValue, const TickType_t xTicksToWait )
+{
+	#if( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+	{
+	const EventBits_t uxBitsToWaitFor = uxValue & ~eventEVENT_BITS_CONTROL_BYTES;
+	UBaseType_t uxBit = 0;
+
+		/* File the task by the lowest bit it waits for, and note the bits it
+		waits for against the list so setting bits can skip the lists that no
+		task is interested in. */
+		while( ( uxBitsToWaitFor & ( ( EventBits_t ) 1 << uxBit ) ) == ( EventBits_t ) 0 )
+		{
+			uxBit++;
+		}
+
+		uxBit &= ( UBaseType_t ) ( configEVENT_GROUP_WAITER_LISTS - 1 );
+		pxEventBits->uxBitsWaitedFor[ uxBit ] |= uxBitsToWaitFor;
+		vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits[ uxBit ] ), uxValue, xTicksToWait );
+	}
+	#else
+	{
+		vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), uxValue, xTicksToWait );
+	}
+	#endif /* configUSE_EVENT_GROUP_DIRECT_WAKE */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+
+	static BaseType_t prvSetBitsAndUnblock( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet )
+	{
+	ListItem_t *pxListItem, *pxNext;
+	ListItem_t const *pxListEnd;
+	List_t const * pxList;
+	EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits, uxBitsStillWaitedFor;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	UBaseType_t uxList;
+
+		/* Set the bits. */
+		pxEventBits->uxEventBits |= uxBitsToSet;
+
+		for( uxList = 0; uxList < ( UBaseType_t ) configEVENT_GROUP_WAITER_LISTS; uxList++ )
+		{
+			/* A task's wait condition can only become true when one of the
+			bits it waits for is set, so only the lists holding such a task are
+			searched.  The critical section is held for the time taken to
+			search those lists only. */
+			if( ( pxEventBits->uxBitsWaitedFor[ uxList ] & uxBitsToSet ) != ( EventBits_t ) 0 )
+			{
+				pxList = &( pxEventBits->xTasksWaitingForBits[ uxList ] );
+				pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+				pxListItem = listGET_HEAD_ENTRY( pxList );
+				uxBitsStillWaitedFor = 0;
+
+				while( pxListItem != pxListEnd )
+				{
+					pxNext = listGET_NEXT( pxListItem );
+					uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+
+					/* Split the bits waited for from the control bits. */
+					uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+					uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+					if( prvTestWaitCondition( pxEventBits->uxEventBits, uxBitsWaitedFor, ( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 ) ? pdTRUE : pdFALSE ) != pdFALSE )
+					{
+						/* The bits match.  Should the bits be cleared on exit? */
+						if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+						{
+							uxBitsToClear |= uxBitsWaitedFor;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						/* As in the scheduler suspended version, the event
+						value is stored in the task's event list item with
+						eventUNBLOCKED_DUE_TO_BIT_SET set. */
+						if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+						{
+							xHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						uxBitsStillWaitedFor |= uxBitsWaitedFor;
+					}
+
+					pxListItem = pxNext;
+				}
+
+				/* Rebuilt from the tasks left in the list, which also drops the
+				bits of tasks that have timed out since the list was last
+				searched. */
+				pxEventBits->uxBitsWaitedFor[ uxList ] = uxBitsStillWaitedFor;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+		bit was set in the control word. */
+		pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+		return xHigherPriorityTaskWoken;
+	}
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_WAKE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+
+	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xTaskWoken;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+		/* The waiting tasks are unblocked here, without going through the
+		timer task. */
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			xTaskWoken = prvSetBitsAndUnblock( pxEventBits, uxBitsToSet );
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		if( ( xTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pdPASS;
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
 	{
@@ -70,6 +70,17 @@ extern "C" {
 #if ( configUSE_NEWLIB_REENTRANT == 1 )
 	#include <reent.h>
 #endif
+
+/* Must be defaulted before the trace macros are defaulted below. */
+#ifndef configUSE_TRACE_RECORDER
+	#define configUSE_TRACE_RECORDER 0
+#endif
+
+/* The trace recorder defines the trace macros it records, so must be included
+before the remaining trace macros are defined as nothing. */
+#if ( configUSE_TRACE_RECORDER == 1 )
+	#include "tracerecorder.h"
+#endif
 /*
  * Check all the required application specific macros have been defined.
  * These macros are application specific and (as downloaded) are defined
@@ -190,6 +201,10 @@ extern "C" {
 	#define configUSE_DAEMON_TASK_STARTUP_HOOK 0
 #endif
 
+#ifndef configUSE_TASK_DELETE_HOOK
+	#define configUSE_TASK_DELETE_HOOK 0
+#endif
+
 #ifndef configUSE_APPLICATION_TASK_TAG
 	#define configUSE_APPLICATION_TASK_TAG 0
 #endif
@@ -568,6 +583,12 @@ hold explicit before calling the code. */
 	#define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )
 #endif
 
+#ifndef traceTIMER_CALLBACK_OVERRUN
+	/* Called when a timer callback takes longer than the timer's callback
+	budget.  ulCycles is the time the callback took. */
+	#define traceTIMER_CALLBACK_OVERRUN( pxTimer, ulCycles )
+#endif
+
 #ifndef traceMALLOC
     #define traceMALLOC( pvAddress, uiSize )
 #endif
@@ -712,6 +733,26 @@ hold explicit before calling the code. */
 	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef traceTASK_CPU_BUDGET_EXHAUSTED
+	/* Called when a task that has used all of its CPU budget is demoted or
+	suspended. */
+	#define traceTASK_CPU_BUDGET_EXHAUSTED( pxTCB )
+#endif
+
+#ifndef traceTASK_CPU_BUDGET_REPLENISHED
+	#define traceTASK_CPU_BUDGET_REPLENISHED( pxTCB )
+#endif
+
+#ifndef traceISR_ENTER
+	/* Called on entry to, and just before returning from, the interrupts
+	handled by the port.  Application interrupt handlers can call them too. */
+	#define traceISR_ENTER()
+#endif
+
+#ifndef traceISR_EXIT
+	#define traceISR_EXIT()
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
@@ -734,6 +775,34 @@ hold explicit before calling the code. */
 	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
 
+#ifndef configUSE_TASK_CPU_ACCOUNTING
+	#define configUSE_TASK_CPU_ACCOUNTING 0
+#endif
+
+#if ( ( configUSE_TASK_CPU_ACCOUNTING == 1 ) && ( configGENERATE_RUN_TIME_STATS != 1 ) )
+	#error configGENERATE_RUN_TIME_STATS must be set to 1 to use configUSE_TASK_CPU_ACCOUNTING
+#endif
+
+#ifndef configUSE_TASK_CPU_BUDGET
+	/* Set to 1 to include vTaskSetCpuBudget(), which limits the processor time
+	a task can use in each replenishment period. */
+	#define configUSE_TASK_CPU_BUDGET 0
+#endif
+
+#ifndef configCPU_BUDGET_DEMOTED_PRIORITY
+	/* The priority at which a task set to eBudgetDemote runs once its budget
+	is exhausted. */
+	#define configCPU_BUDGET_DEMOTED_PRIORITY 0
+#endif
+
+#if ( ( configUSE_TASK_CPU_BUDGET == 1 ) && ( configUSE_TASK_CPU_ACCOUNTING != 1 ) )
+	#error configUSE_TASK_CPU_ACCOUNTING must be set to 1 to use configUSE_TASK_CPU_BUDGET
+#endif
+
+#if ( ( configUSE_TASK_CPU_BUDGET == 1 ) && ( configCPU_BUDGET_DEMOTED_PRIORITY >= configMAX_PRIORITIES ) )
+	#error configCPU_BUDGET_DEMOTED_PRIORITY must be less than configMAX_PRIORITIES
+#endif
+
 #ifndef configUSE_MALLOC_FAILED_HOOK
 	#define configUSE_MALLOC_FAILED_HOOK 0
 #endif
@@ -830,6 +899,24 @@ hold explicit before calling the code. */
 	#define configAPPLICATION_ALLOCATED_HEAP 0
 #endif
 
+/* configKERNEL_DATA_ATTRIBUTE can be defined to an attribute that places the
+scheduler's own data - pxCurrentTCB, the ready and delayed lists and the
+variables read on every tick and context switch - in faster memory, such as the
+core coupled RAM of an STM32F4.  It is ignored by the MPU ports, which place
+that data in the privileged_data section. */
+#ifndef configKERNEL_DATA_ATTRIBUTE
+	#define configKERNEL_DATA_ATTRIBUTE
+#endif
+
+/* Set configTASK_MEMORY_FROM_SEPARATE_HEAP to 1 to have the TCB and stack of a
+task created by xTaskCreate() allocated with pvPortMallocTaskMemory() and freed
+with vPortFreeTaskMemory(), which the application provides, rather than taken
+from the heap used by pvPortMalloc().  That lets them go in memory, such as
+core coupled RAM, that other allocations must stay out of. */
+#ifndef configTASK_MEMORY_FROM_SEPARATE_HEAP
+	#define configTASK_MEMORY_FROM_SEPARATE_HEAP 0
+#endif
+
 #ifndef configUSE_TASK_NOTIFICATIONS
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
@@ -865,6 +952,152 @@ hold explicit before calling the code. */
 	#define configMESSAGE_BUFFER_LENGTH_TYPE size_t
 #endif
 
+#ifndef configUSE_EDF_SCHEDULING
+	/* Set to 1 to schedule the tasks that run at configEDF_PRIORITY in earliest
+	deadline first order rather than round robin. */
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#ifndef configUSE_MUTEX_PRIORITY_CEILING
+	/* Set to 1 to include xSemaphoreCreateMutexWithCeiling(). */
+	#define configUSE_MUTEX_PRIORITY_CEILING 0
+#endif
+
+#ifndef configUSE_MUTEX_FAST_PATH
+	/* Set to 1 to take and give uncontended mutexes with a single atomic
+	update of the holder, without entering a critical section.  Requires a port
+	that defines portCOMPARE_AND_SWAP_POINTER(). */
+	#define configUSE_MUTEX_FAST_PATH 0
+#endif
+
+#ifndef configUSE_TASK_FPU_FLAG
+	/* Set to 1 to only allow tasks marked with vTaskUseFPU() to access the
+	FPU.  Requires a port that defines portSET_TASK_FPU_ACCESS(). */
+	#define configUSE_TASK_FPU_FLAG 0
+#endif
+
+#ifndef configUSE_WORK_QUEUE
+	/* Set to 1 to include the deferred interrupt work queue, which runs
+	functions posted by xWorkQueuePostFromISR() in its own task. */
+	#define configUSE_WORK_QUEUE 0
+#endif
+
+#ifndef configWORK_QUEUE_LENGTH
+	/* The number of posted functions the work queue can hold.  Must be a
+	power of 2. */
+	#define configWORK_QUEUE_LENGTH 16
+#endif
+
+#ifndef configWORK_QUEUE_TASK_PRIORITY
+	#define configWORK_QUEUE_TASK_PRIORITY ( configMAX_PRIORITIES - 1 )
+#endif
+
+#ifndef configWORK_QUEUE_TASK_STACK_DEPTH
+	#define configWORK_QUEUE_TASK_STACK_DEPTH configMINIMAL_STACK_SIZE
+#endif
+
+#ifndef configTRACE_RECORDER_EVENTS
+	/* The number of events held by the trace recorder ring.  Each takes 8
+	bytes.  Must be a power of 2. */
+	#define configTRACE_RECORDER_EVENTS 512
+#endif
+
+#ifndef configTRACE_RECORDER_OBJECTS
+	/* The number of tasks and queues the trace recorder keeps names for. */
+	#define configTRACE_RECORDER_OBJECTS 16
+#endif
+
+#ifndef configUSE_JOB_EXECUTOR
+	/* Set to 1 to include the job executor, which runs stackless jobs (see
+	jobs.h) inside a single task. */
+	#define configUSE_JOB_EXECUTOR 0
+#endif
+
+#ifndef configMAX_JOB_PRIORITIES
+	#define configMAX_JOB_PRIORITIES 4
+#endif
+
+#ifndef configJOB_EXECUTOR_TASK_PRIORITY
+	#define configJOB_EXECUTOR_TASK_PRIORITY 1
+#endif
+
+#ifndef configJOB_EXECUTOR_STACK_DEPTH
+	#define configJOB_EXECUTOR_STACK_DEPTH configMINIMAL_STACK_SIZE
+#endif
+
+#ifndef configUSE_EVENT_GROUP_DIRECT_WAKE
+	/* Set to 1 for event groups to unblock tasks directly from
+	xEventGroupSetBits() and xEventGroupSetBitsFromISR(), inside a critical
+	section, instead of with the scheduler suspended and through the timer
+	task. */
+	#define configUSE_EVENT_GROUP_DIRECT_WAKE 0
+#endif
+
+#ifndef configEVENT_GROUP_WAITER_LISTS
+	/* With configUSE_EVENT_GROUP_DIRECT_WAKE, the number of lists each event
+	group files its waiting tasks in, by the lowest bit they wait for.  Setting
+	bits only searches the lists holding a task that waits for one of them.
+	Must be a power of 2 no larger than the number of event bits. */
+	#define configEVENT_GROUP_WAITER_LISTS 4
+#endif
+
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	/* The number of independent notifications, each with its own value and
+	state, held by each task.  Index 0 is used by the API functions that do
+	not take an index. */
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+	/* Set to 1 for the timer service task to hold active timers in a hashed
+	timing wheel instead of a list sorted by expiry time, so starting,
+	stopping and resetting a timer takes constant time however many timers
+	are active.  The API is unchanged. */
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOTS
+	/* With configUSE_TIMER_WHEEL, the number of slots in the wheel, each a
+	List_t.  Must be a power of 2.  Timers whose period is longer than this
+	many ticks cost a visit by the timer service task each revolution. */
+	#define configTIMER_WHEEL_SLOTS 64
+#endif
+
+#ifndef configUSE_TIMER_PHASE_LOCK
+	/* Set to 1 to allow timer periods with a fraction of a tick, and timers
+	started at an absolute tick count, so auto-reload timers stay locked to
+	the tick count however long they run. */
+	#define configUSE_TIMER_PHASE_LOCK 0
+#endif
+
+#ifndef configUSE_TIMER_PROFILING
+	/* Set to 1 for the timer service task to time each timer callback with
+	the cycle counter, and to record how late and how many periods behind the
+	callbacks are called.  See vTimerGetCallbackStats(). */
+	#define configUSE_TIMER_PROFILING 0
+#endif
+
+#ifndef configTIMER_CALLBACK_BUDGET_CYCLES
+	/* With configUSE_TIMER_PROFILING, the number of core clock cycles a timer
+	callback can take before it is counted as an overrun, for timers that have
+	not been given a budget of their own by vTimerSetCallbackBudget().  0 means
+	no budget. */
+	#define configTIMER_CALLBACK_BUDGET_CYCLES 0
+#endif
+
+#ifndef configUSE_TIMER_OVERRUN_HOOK
+	/* Set to 1 to have vApplicationTimerOverrunHook() called each time a timer
+	callback overruns its budget. */
+	#define configUSE_TIMER_OVERRUN_HOOK 0
+#endif
+
+#ifndef configUSE_TIMER_DIRECT_COMMANDS
+	/* Set to 1 to let tasks start, reset, stop and change the period of timers
+	by updating the active timers themselves, rather than by sending a command
+	to the timer service task, whenever the timer service task is idle. */
+	#define configUSE_TIMER_DIRECT_COMMANDS 0
+#endif
+
 /* Sanity check the configuration. */
 #if( configUSE_TICKLESS_IDLE != 0 )
 	#if( INCLUDE_vTaskSuspend != 1 )
@@ -880,6 +1113,105 @@ hold explicit before calling the code. */
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( configUSE_EDF_SCHEDULING == 1 )
+	#ifndef configEDF_PRIORITY
+		#error Missing definition:  configEDF_PRIORITY must be defined in FreeRTOSConfig.h when configUSE_EDF_SCHEDULING is set to 1.  configEDF_PRIORITY is the priority at which tasks are scheduled by deadline.
+	#endif
+	#if( ( configEDF_PRIORITY == 0 ) || ( configEDF_PRIORITY >= configMAX_PRIORITIES ) )
+		#error configEDF_PRIORITY must be above the idle priority and below configMAX_PRIORITIES
+	#endif
+#endif /* configUSE_EDF_SCHEDULING */
+
+#if( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use configUSE_MUTEX_PRIORITY_CEILING
+#endif
+
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+	#if( configUSE_MUTEXES != 1 )
+		#error configUSE_MUTEXES must be set to 1 to use configUSE_MUTEX_FAST_PATH
+	#endif
+
+	#ifndef portCOMPARE_AND_SWAP_POINTER
+		#error configUSE_MUTEX_FAST_PATH is set to 1 but the port in use does not define portCOMPARE_AND_SWAP_POINTER()
+	#endif
+#endif
+
+#if( ( configUSE_TASK_FPU_FLAG == 1 ) && !defined( portSET_TASK_FPU_ACCESS ) )
+	#error configUSE_TASK_FPU_FLAG is set to 1 but the port in use does not define portSET_TASK_FPU_ACCESS()
+#endif
+
+#if( configUSE_WORK_QUEUE == 1 )
+	#if( configUSE_TASK_NOTIFICATIONS != 1 )
+		#error configUSE_TASK_NOTIFICATIONS must be set to 1 to use configUSE_WORK_QUEUE
+	#endif
+
+	#ifndef portCOMPARE_AND_SWAP_U32
+		#error configUSE_WORK_QUEUE is set to 1 but the port in use does not define portCOMPARE_AND_SWAP_U32()
+	#endif
+
+	#if( ( configWORK_QUEUE_LENGTH < 2 ) || ( ( configWORK_QUEUE_LENGTH & ( configWORK_QUEUE_LENGTH - 1 ) ) != 0 ) )
+		#error configWORK_QUEUE_LENGTH must be a power of 2
+	#endif
+#endif
+
+#if( configUSE_TRACE_RECORDER == 1 )
+	#if( configUSE_TRACE_FACILITY != 1 )
+		#error configUSE_TRACE_FACILITY must be set to 1 to use configUSE_TRACE_RECORDER
+	#endif
+
+	#ifndef portGET_CYCLE_COUNTER
+		#error configUSE_TRACE_RECORDER is set to 1 but the port in use does not define portGET_CYCLE_COUNTER()
+	#endif
+
+	#ifndef portCOMPARE_AND_SWAP_U32
+		#error configUSE_TRACE_RECORDER is set to 1 but the port in use does not define portCOMPARE_AND_SWAP_U32()
+	#endif
+
+	#if( ( configTRACE_RECORDER_EVENTS < 2 ) || ( ( configTRACE_RECORDER_EVENTS & ( configTRACE_RECORDER_EVENTS - 1 ) ) != 0 ) )
+		#error configTRACE_RECORDER_EVENTS must be a power of 2
+	#endif
+#endif
+
+#if( configUSE_JOB_EXECUTOR == 1 )
+	#if( configUSE_TASK_NOTIFICATIONS != 1 )
+		#error configUSE_TASK_NOTIFICATIONS must be set to 1 to use configUSE_JOB_EXECUTOR
+	#endif
+
+	#if( ( configMAX_JOB_PRIORITIES < 1 ) || ( configMAX_JOB_PRIORITIES > 256 ) )
+		#error configMAX_JOB_PRIORITIES must be between 1 and 256
+	#endif
+#endif
+
+#if( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+	#if( ( configEVENT_GROUP_WAITER_LISTS < 1 ) || ( ( configEVENT_GROUP_WAITER_LISTS & ( configEVENT_GROUP_WAITER_LISTS - 1 ) ) != 0 ) )
+		#error configEVENT_GROUP_WAITER_LISTS must be a power of 2
+	#endif
+
+	#if( ( ( configUSE_16_BIT_TICKS == 1 ) && ( configEVENT_GROUP_WAITER_LISTS > 8 ) ) || ( configEVENT_GROUP_WAITER_LISTS > 24 ) )
+		#error configEVENT_GROUP_WAITER_LISTS must not be larger than the number of event bits
+	#endif
+#endif
+
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES < 1 )
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
+#if( configUSE_TIMER_WHEEL == 1 )
+	#if( ( configTIMER_WHEEL_SLOTS < 2 ) || ( ( configTIMER_WHEEL_SLOTS & ( configTIMER_WHEEL_SLOTS - 1 ) ) != 0 ) )
+		#error configTIMER_WHEEL_SLOTS must be a power of 2
+	#endif
+#endif
+
+#if( configUSE_TIMER_PROFILING == 1 )
+	#ifndef portGET_CYCLE_COUNTER
+		#error configUSE_TIMER_PROFILING is set to 1 but the port in use does not define portGET_CYCLE_COUNTER()
+	#endif
+#endif
+
+#if( ( configUSE_TIMER_OVERRUN_HOOK == 1 ) && ( configUSE_TIMER_PROFILING != 1 ) )
+	#error configUSE_TIMER_PROFILING must be set to 1 to use configUSE_TIMER_OVERRUN_HOOK
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
 	#define configINITIAL_TICK_COUNT 0
 #endif
@@ -1140,12 +1472,16 @@ typedef struct xSTATIC_TCB
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		uint32_t		ulDummy16;
 	#endif
+	#if ( configUSE_TASK_CPU_ACCOUNTING == 1 )
+		uint64_t		ullDummy25;
+		uint32_t		ulDummy26[ 3 ];
+	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
 		uint8_t			uxDummy20;
@@ -1157,6 +1493,20 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_POSIX_ERRNO == 1 )
 		int				iDummy22;
 	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy23[ 4 ];
+		UBaseType_t		uxDummy24;
+	#endif
+	#if ( configUSE_TASK_FPU_FLAG == 1 )
+		uint8_t			ucDummy27;
+	#endif
+	#if ( configUSE_TASK_CPU_BUDGET == 1 )
+		StaticListItem_t	xDummy28;
+		uint32_t		ulDummy29[ 2 ];
+		TickType_t		xDummy30[ 2 ];
+		UBaseType_t		uxDummy31[ 2 ];
+		uint8_t			ucDummy32[ 2 ];
+	#endif
 } StaticTask_t;
 
 /*
@@ -1200,6 +1550,10 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+		UBaseType_t uxDummy10;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1220,7 +1574,13 @@ typedef StaticQueue_t StaticSemaphore_t;
 typedef struct xSTATIC_EVENT_GROUP
 {
 	TickType_t xDummy1;
-	StaticList_t xDummy2;
+
+	#if( configUSE_EVENT_GROUP_DIRECT_WAKE == 1 )
+		StaticList_t xDummy2[ configEVENT_GROUP_WAITER_LISTS ];
+		TickType_t xDummy5[ configEVENT_GROUP_WAITER_LISTS ];
+	#else
+		StaticList_t xDummy2;
+	#endif
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy3;
@@ -1257,6 +1617,14 @@ typedef struct xSTATIC_TIMER
 		UBaseType_t		uxDummy7;
 	#endif
 	uint8_t 			ucDummy8;
+	#if( configUSE_TIMER_PHASE_LOCK == 1 )
+		uint32_t		ulDummy9[ 2 ];
+	#endif
+	#if( configUSE_TIMER_PROFILING == 1 )
+		uint64_t		ullDummy10;
+		uint32_t		ulDummy11[ 5 ];
+		TickType_t		xDummy12;
+	#endif
 
 } StaticTimer_t;
 
@@ -59,12 +59,16 @@ or interrupt version of the queue send function should be used. */
 #define tmrCOMMAND_STOP							( ( BaseType_t ) 3 )
 #define tmrCOMMAND_CHANGE_PERIOD				( ( BaseType_t ) 4 )
 #define tmrCOMMAND_DELETE						( ( BaseType_t ) 5 )
+#define tmrCOMMAND_START_AT						( ( BaseType_t ) 6 )
+#define tmrCOMMAND_CHANGE_PERIOD_EXACT			( ( BaseType_t ) 7 )
 
-#define tmrFIRST_FROM_ISR_COMMAND				( ( BaseType_t ) 6 )
-#define tmrCOMMAND_START_FROM_ISR				( ( BaseType_t ) 6 )
-#define tmrCOMMAND_RESET_FROM_ISR				( ( BaseType_t ) 7 )
-#define tmrCOMMAND_STOP_FROM_ISR				( ( BaseType_t ) 8 )
-#define tmrCOMMAND_CHANGE_PERIOD_FROM_ISR		( ( BaseType_t ) 9 )
+#define tmrFIRST_FROM_ISR_COMMAND				( ( BaseType_t ) 8 )
+#define tmrCOMMAND_START_FROM_ISR				( ( BaseType_t ) 8 )
+#define tmrCOMMAND_RESET_FROM_ISR				( ( BaseType_t ) 9 )
+#define tmrCOMMAND_STOP_FROM_ISR				( ( BaseType_t ) 10 )
+#define tmrCOMMAND_CHANGE_PERIOD_FROM_ISR		( ( BaseType_t ) 11 )
+#define tmrCOMMAND_START_AT_FROM_ISR			( ( BaseType_t ) 12 )
+#define tmrCOMMAND_CHANGE_PERIOD_EXACT_FROM_ISR	( ( BaseType_t ) 13 )
 
 
 /**
@@ -87,6 +91,21 @@ typedef void (*TimerCallbackFunction_t)( TimerHandle_t xTimer );
  */
 typedef void (*PendedFunction_t)( void *, uint32_t );
 
+/* Used with vTimerGetCallbackStats() to return the timing of a timer's
+callback.  Cycle counts are core clock cycles, measured from when the callback
+is called to when it returns, so they include any time the timer service task
+spends preempted by interrupts or higher priority tasks. */
+typedef struct xTIMER_CALLBACK_STATS
+{
+	uint32_t ulCallbacks;			/* The number of times the callback has been called. */
+	uint32_t ulMinCycles;			/* The shortest a call of the callback has taken, 0 if it has not been called. */
+	uint32_t ulMaxCycles;			/* The longest a call of the callback has taken. */
+	uint32_t ulAverageCycles;		/* The mean time a call of the callback has taken. */
+	TickType_t xMaxLateness;		/* The furthest, in ticks, the callback has been called behind the expiry time it was called for. */
+	uint32_t ulMissedPeriods;		/* The number of expiries of an auto-reload timer that had already passed when the timer was reloaded, so were caught up late. */
+	uint32_t ulOverruns;			/* The number of calls that took longer than the timer's callback budget. */
+} TimerCallbackStats_t;
+
 /**
  * TimerHandle_t xTimerCreate( 	const char * const pcTimerName,
  * 								TickType_t xTimerPeriodInTicks,
@@ -1288,12 +1307,261 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_TIMER_PHASE_LOCK == 1 )
+
+/**
+ * void vTimerSetPeriodFraction( TimerHandle_t xTimer, const uint32_t ulPeriodFraction );
+ *
+ * configUSE_TIMER_PHASE_LOCK must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Adds a fraction of a tick to the period of a timer, so an auto-reload timer
+ * can run at a rate that is not a whole number of ticks.  The fraction is
+ * added up from one expiry to the next, and whenever it reaches a whole tick
+ * that period is a tick longer.  Each expiry time is therefore the exact
+ * expiry time rounded down to a tick, and the timer does not drift however
+ * long it runs.  For example, a period of 33 ticks with a fraction of
+ * 0x55555556 expires 3 times every 100 ticks.  Round the fraction up, as
+ * here, so the timer never expires before the exact time.
+ *
+ * The fraction is kept when the period is changed with xTimerChangePeriod(),
+ * and is used from the next time the timer is reloaded.  To change the period
+ * and the fraction together use xTimerChangePeriodExact() instead, which sends
+ * both in one command, so the timer is never reloaded with the new fraction
+ * and the old period, or left with the new fraction if the command cannot be
+ * sent.  Starting, resetting
+ * or changing the period of the timer restarts the adding up, so the phase of
+ * the timer is taken from the time of that command.  Use xTimerStartAt() to
+ * anchor the phase to a particular tick count instead.
+ *
+ * This function can be called from a task or an interrupt.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param ulPeriodFraction The fraction of a tick to add to the period, in
+ * units of 1/2^32 of a tick.
+ */
+void vTimerSetPeriodFraction( TimerHandle_t xTimer, const uint32_t ulPeriodFraction ) PRIVILEGED_FUNCTION;
+
+/**
+ * uint32_t ulTimerGetPeriodFraction( TimerHandle_t xTimer );
+ *
+ * Returns the fraction of a tick set by vTimerSetPeriodFraction().
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The fraction of a tick added to the period of the timer, in units of
+ * 1/2^32 of a tick.
+ */
+uint32_t ulTimerGetPeriodFraction( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xTimerStartAt( TimerHandle_t xTimer,
+ *							 TickType_t xFirstExpiryTime,
+ *							 TickType_t xTicksToWait );
+ *
+ * configUSE_TIMER_PHASE_LOCK must be set to 1 in FreeRTOSConfig.h for this
+ * macro to be available.
+ *
+ * Starts a timer like xTimerStart(), but with its first expiry at the absolute
+ * tick count xFirstExpiryTime rather than one period after the time the
+ * command is sent.  An auto-reload timer then expires at xFirstExpiryTime plus
+ * whole multiples of its period, so its phase is anchored to the tick count
+ * and is not moved by the command waiting in the timer command queue.
+ *
+ * If xFirstExpiryTime has already passed when the timer service task processes
+ * the command - measured as being no more than half the range of TickType_t
+ * behind the tick count - the callback function is called straight away, and
+ * an auto-reload timer catches up with any periods that have passed since.
+ *
+ * @param xTimer The handle of the timer being started.
+ *
+ * @param xFirstExpiryTime The tick count at which the timer is to first expire.
+ *
+ * @param xTicksToWait As for xTimerStart().
+ *
+ * @return As for xTimerStart().
+ *
+ * Example usage:
+ * @verbatim
+ * // Sample at exactly 30Hz with a 1000Hz tick, locked to tick count 0.
+ * xSampleTimer = xTimerCreate( "Sample", 33, pdTRUE, NULL, prvSampleCallback );
+ * vTimerSetPeriodFraction( xSampleTimer, 0x55555556UL );
+ * xTimerStartAt( xSampleTimer, 0, portMAX_DELAY );
+ * @endverbatim
+ */
+#define xTimerStartAt( xTimer, xFirstExpiryTime, xTicksToWait ) xTimerGenericCommand( ( xTimer ), tmrCOMMAND_START_AT, ( xFirstExpiryTime ), NULL, ( xTicksToWait ) )
+
+/**
+ * BaseType_t xTimerStartAtFromISR( TimerHandle_t xTimer,
+ *									TickType_t xFirstExpiryTime,
+ *									BaseType_t *pxHigherPriorityTaskWoken );
+ *
+ * A version of xTimerStartAt() that can be called from an interrupt service
+ * routine.  pxHigherPriorityTaskWoken and the return value are as for
+ * xTimerStartFromISR().
+ */
+#define xTimerStartAtFromISR( xTimer, xFirstExpiryTime, pxHigherPriorityTaskWoken ) xTimerGenericCommand( ( xTimer ), tmrCOMMAND_START_AT_FROM_ISR, ( xFirstExpiryTime ), ( pxHigherPriorityTaskWoken ), 0U )
+
+/**
+ * BaseType_t xTimerChangePeriodExact( TimerHandle_t xTimer,
+ *									   TickType_t xNewPeriod,
+ *									   uint32_t ulPeriodFraction,
+ *									   TickType_t xTicksToWait );
+ *
+ * configUSE_TIMER_PHASE_LOCK must be set to 1 in FreeRTOSConfig.h for this
+ * macro to be available.
+ *
+ * Changes the period of a timer like xTimerChangePeriod(), and the fraction of
+ * a tick added to it like vTimerSetPeriodFraction(), in a single command.  The
+ * timer service task sets both when it processes the command, so the timer is
+ * only ever reloaded with the old period and fraction or with the new ones.
+ *
+ * @param xTimer The handle of the timer being changed.
+ *
+ * @param xNewPeriod As for xTimerChangePeriod().
+ *
+ * @param ulPeriodFraction The fraction of a tick to add to the new period, in
+ * units of 1/2^32 of a tick.
+ *
+ * @param xTicksToWait As for xTimerChangePeriod().
+ *
+ * @return As for xTimerChangePeriod().  The fraction is left unchanged if the
+ * command cannot be sent.
+ */
+#define xTimerChangePeriodExact( xTimer, xNewPeriod, ulPeriodFraction, xTicksToWait ) xTimerGenericCommandExact( ( xTimer ), tmrCOMMAND_CHANGE_PERIOD_EXACT, ( xNewPeriod ), ( ulPeriodFraction ), NULL, ( xTicksToWait ) )
+
+/**
+ * BaseType_t xTimerChangePeriodExactFromISR( TimerHandle_t xTimer,
+ *											  TickType_t xNewPeriod,
+ *											  uint32_t ulPeriodFraction,
+ *											  BaseType_t *pxHigherPriorityTaskWoken );
+ *
+ * A version of xTimerChangePeriodExact() that can be called from an interrupt
+ * service routine.  pxHigherPriorityTaskWoken and the return value are as for
+ * xTimerChangePeriodFromISR().
+ */
+#define xTimerChangePeriodExactFromISR( xTimer, xNewPeriod, ulPeriodFraction, pxHigherPriorityTaskWoken ) xTimerGenericCommandExact( ( xTimer ), tmrCOMMAND_CHANGE_PERIOD_EXACT_FROM_ISR, ( xNewPeriod ), ( ulPeriodFraction ), ( pxHigherPriorityTaskWoken ), 0U )
+
+#endif /* configUSE_TIMER_PHASE_LOCK */
+
+#if( configUSE_TIMER_PROFILING == 1 )
+
+/**
+ * void vTimerGetCallbackStats( TimerHandle_t xTimer, TimerCallbackStats_t *pxStats );
+ *
+ * configUSE_TIMER_PROFILING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Returns how long the callback of a timer takes, how late it is called and
+ * how many periods it has fallen behind, since the timer was created or the
+ * statistics were last reset.  A callback that blocks, or takes a long time,
+ * delays every other timer, as all the callbacks are called from the timer
+ * service task - these figures show which callbacks do so.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @param pxStats The structure to populate.
+ */
+void vTimerGetCallbackStats( TimerHandle_t xTimer, TimerCallbackStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTimerResetCallbackStats( TimerHandle_t xTimer );
+ *
+ * configUSE_TIMER_PROFILING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Clears the statistics returned by vTimerGetCallbackStats().  The callback
+ * budget is kept.
+ *
+ * @param xTimer The handle of the timer being reset.
+ */
+void vTimerResetCallbackStats( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTimerSetCallbackBudget( TimerHandle_t xTimer, const uint32_t ulBudgetCycles );
+ *
+ * configUSE_TIMER_PROFILING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Sets the number of core clock cycles the callback of a timer can take
+ * before a call is counted as an overrun.  Each overrun calls the
+ * traceTIMER_CALLBACK_OVERRUN() trace macro and, if
+ * configUSE_TIMER_OVERRUN_HOOK is set to 1, the overrun hook:
+ *
+ * void vApplicationTimerOverrunHook( TimerHandle_t xTimer, uint32_t ulCycles );
+ *
+ * which is called from the timer service task after the callback returns,
+ * with the time the callback took.  Timers are created with a budget of
+ * configTIMER_CALLBACK_BUDGET_CYCLES.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param ulBudgetCycles The budget in core clock cycles.  0 means no budget.
+ *
+ * Example usage:
+ * @verbatim
+ * // Allow the callback 50us at 180MHz.
+ * vTimerSetCallbackBudget( xTimer, 9000UL );
+ * @endverbatim
+ */
+void vTimerSetCallbackBudget( TimerHandle_t xTimer, const uint32_t ulBudgetCycles ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_PROFILING */
+
+/**
+ * BaseType_t xTimerStartMultiple( TimerHandle_t const *pxTimers,
+ *								   UBaseType_t uxCount,
+ *								   TickType_t xTicksToWait );
+ *
+ * Starts uxCount timers, as if xTimerStart() were called for each timer in
+ * the array pxTimers, but without switching to the timer service task after
+ * each one.  The commands are sent to the timer service task with the
+ * scheduler suspended, so it processes them together, and all the timers are
+ * started with the same command time.  Only if the timer command queue fills
+ * does the calling task wait, for up to xTicksToWait ticks, for the timer
+ * service task to make space before the rest are sent.
+ *
+ * xTimerResetMultiple() and xTimerStopMultiple() do the same for
+ * xTimerReset() and xTimerStop().  None of them can be called from an
+ * interrupt service routine.
+ *
+ * @param pxTimers An array of the handles of the timers being started.
+ *
+ * @param uxCount The number of handles in pxTimers.
+ *
+ * @param xTicksToWait As for xTimerStart(), but applied each time the timer
+ * command queue is found to be full.
+ *
+ * @return pdPASS if a command was sent for every timer, otherwise pdFAIL.  If
+ * pdFAIL is returned some of the timers may have been started.
+ *
+ * Example usage:
+ * @verbatim
+ * // Restart every timeout of a connection when a frame arrives.
+ * static TimerHandle_t xTimeouts[ 20 ];
+ *
+ * void vFrameReceived( void )
+ * {
+ *     xTimerResetMultiple( xTimeouts, 20, 0 );
+ * }
+ * @endverbatim
+ */
+#define xTimerStartMultiple( pxTimers, uxCount, xTicksToWait ) xTimerGenericCommandMultiple( ( pxTimers ), ( uxCount ), tmrCOMMAND_START, ( xTaskGetTickCount() ), ( xTicksToWait ) )
+#define xTimerResetMultiple( pxTimers, uxCount, xTicksToWait ) xTimerGenericCommandMultiple( ( pxTimers ), ( uxCount ), tmrCOMMAND_RESET, ( xTaskGetTickCount() ), ( xTicksToWait ) )
+#define xTimerStopMultiple( pxTimers, uxCount, xTicksToWait ) xTimerGenericCommandMultiple( ( pxTimers ), ( uxCount ), tmrCOMMAND_STOP, 0U, ( xTicksToWait ) )
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
  */
 BaseType_t xTimerCreateTimerTask( void ) PRIVILEGED_FUNCTION;
 BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTimerGenericCommandMultiple( TimerHandle_t const * const pxTimers, const UBaseType_t uxCount, const BaseType_t xCommandID, const TickType_t xOptionalValue, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_PHASE_LOCK == 1 )
+	BaseType_t xTimerGenericCommandExact( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, const uint32_t ulPeriodFraction, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
 
 #if( configUSE_TRACE_FACILITY == 1 )
 	void vTimerSetTimerNumber( TimerHandle_t xTimer, UBaseType_t uxTimerNumber ) PRIVILEGED_FUNCTION;
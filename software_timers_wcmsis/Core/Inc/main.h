@@ -46,7 +46,22 @@ extern "C" {
 
 /* Exported macro ------------------------------------------------------------*/
 /* USER CODE BEGIN EM */
-
+/* Places zero initialized data in the 64 KB CCM-RAM at 0x10000000, which is
+   single cycle and never stalled by DMA traffic.  The DMA controllers cannot
+   reach it at all, so DMA buffers must stay in the main SRAM - and so off task
+   stacks, which are in the CCM-RAM (see task_heap.h).  pvPortMalloc() memory
+   is in the main SRAM and safe to use. */
+#define CCMRAM_BSS  __attribute__((section(".ccmbss")))
+
+/* Places a DMA buffer in the .dma_buffer section, which the linker script
+   keeps in the main SRAM.  The buffer is not zeroed at startup. */
+#define DMA_BUFFER  __attribute__((section(".dma_buffer"), aligned(4)))
+
+/* Whether the DMA controllers can reach an address, for a configASSERT()
+   before a buffer whose origin is not known, such as one passed in by the
+   caller, is handed to a HAL_xxx_DMA() call. */
+#define IS_DMA_ADDRESS(ADDRESS)  (((uint32_t)(ADDRESS) < CCMDATARAM_BASE) || \
+                                  ((uint32_t)(ADDRESS) > CCMDATARAM_END))
 /* USER CODE END EM */
 
 /* Exported functions prototypes ---------------------------------------------*/
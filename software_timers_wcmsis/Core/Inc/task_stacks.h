@@ -0,0 +1,18 @@
+/* Generated by tools/stack_analyzer.py from the -fstack-usage output and the
+ * call graph of the linked image.  Do not edit: the file is rewritten by every
+ * build whose worst case stack usage changed.
+ *
+ * Each size is the deepest call chain of the task, plus 204 bytes for the
+ * port to save the task context and a 32 byte margin, in words.
+ */
+
+#ifndef TASK_STACKS_H
+#define TASK_STACKS_H
+
+/* UartTask: 264 bytes, UartTask -> osTimerStart -> xTimerGenericCommand -> xQueueGenericSendFromISR -> prvCopyDataToQueue -> xTaskPriorityDisinherit -> uxListRemove */
+#define TASK_STACK_WORDS_UartTask 126
+
+/* LedTask: 264 bytes, LedTask -> osTimerStart -> xTimerGenericCommand -> xQueueGenericSendFromISR -> prvCopyDataToQueue -> xTaskPriorityDisinherit -> uxListRemove */
+#define TASK_STACK_WORDS_LedTask 126
+
+#endif /* TASK_STACKS_H */
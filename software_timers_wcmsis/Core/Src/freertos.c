@@ -24,6 +24,7 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "hrtimer.h"
 
 /* USER CODE END Includes */
 
@@ -49,6 +50,9 @@
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN FunctionPrototypes */
+#if (configUSE_TASK_DELETE_HOOK == 1)
+void vApplicationTaskDeleteHook(TaskHandle_t xTask);
+#endif
 
 /* USER CODE END FunctionPrototypes */
 
@@ -59,8 +63,8 @@ void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackTy
 void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
 
 /* USER CODE BEGIN GET_IDLE_TASK_MEMORY */
-static StaticTask_t xIdleTaskTCBBuffer;
-static StackType_t xIdleStack[configMINIMAL_STACK_SIZE];
+static StaticTask_t xIdleTaskTCBBuffer CCMRAM_BSS;
+static StackType_t xIdleStack[configMINIMAL_STACK_SIZE] CCMRAM_BSS;
 
 void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
 {
@@ -68,12 +72,17 @@ void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackTy
   *ppxIdleTaskStackBuffer = &xIdleStack[0];
   *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
   /* place for user code */
+#if (configUSE_HRTIMER == 1)
+  /* vTaskStartScheduler() calls this once, with the clocks set up and before
+     any task runs, so start the microsecond counter here. */
+  vHRTimerInit();
+#endif
 }
 /* USER CODE END GET_IDLE_TASK_MEMORY */
 
 /* USER CODE BEGIN GET_TIMER_TASK_MEMORY */
-static StaticTask_t xTimerTaskTCBBuffer;
-static StackType_t xTimerStack[configTIMER_TASK_STACK_DEPTH];
+static StaticTask_t xTimerTaskTCBBuffer CCMRAM_BSS;
+static StackType_t xTimerStack[configTIMER_TASK_STACK_DEPTH] CCMRAM_BSS;
 
 void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
 {
@@ -86,5 +95,17 @@ void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, Stack
 
 /* Private application code --------------------------------------------------*/
 /* USER CODE BEGIN Application */
+#if (configUSE_TASK_DELETE_HOOK == 1)
+/* Called by vTaskDelete() from inside a critical section, while the stack of
+   the task being deleted is still valid. */
+void vApplicationTaskDeleteHook(TaskHandle_t xTask)
+{
+#if (configUSE_HRTIMER == 1)
+  vHRTimerTaskDeleted(xTask);
+#else
+  (void)xTask;
+#endif
+}
+#endif
 
 /* USER CODE END Application */
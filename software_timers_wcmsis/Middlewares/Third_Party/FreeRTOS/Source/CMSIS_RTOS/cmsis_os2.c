@@ -0,0 +1,2347 @@
+/* --------------------------------------------------------------------------
+ * Project:      CMSIS-RTOS2 API
+ * Title:        cmsis_os2.c CMSIS-RTOS2 implementation for FreeRTOS
+ *
+ * Implements cmsis_os2.h on the FreeRTOS kernel, alongside the CMSIS-RTOS v1
+ * wrapper in cmsis_os.c.  Every object is a plain FreeRTOS object, created in
+ * caller supplied memory when the attributes provide it and on the FreeRTOS
+ * heap otherwise.  See freertos_os2.h for the control block types and for how
+ * v1 and v2 code share objects.
+ * -------------------------------------------------------------------------- */
+
+#include <string.h>
+#include "freertos_os2.h"
+#include "cmsis_compiler.h"
+
+#if (INCLUDE_xTaskGetSchedulerState != 1) && (configUSE_TIMERS != 1)
+#error cmsis_os2.c requires INCLUDE_xTaskGetSchedulerState or configUSE_TIMERS to be set to 1
+#endif
+
+/* Kernel version and identification string */
+#define KERNEL_VERSION            (((uint32_t)tskKERNEL_VERSION_MAJOR * 10000000UL) | \
+                                   ((uint32_t)tskKERNEL_VERSION_MINOR *    10000UL) | \
+                                   ((uint32_t)tskKERNEL_VERSION_BUILD *        1UL))
+#define KERNEL_ID                 ("FreeRTOS " tskKERNEL_VERSION_NUMBER)
+
+/* Thread flags use the same notification value as the v1 signals; bit 31 is
+   kept free to tell flags from error codes. */
+#define THREAD_FLAGS_INVALID_BITS 0x80000000UL
+
+/* The top byte of an event group is used by the kernel. */
+#if (configUSE_16_BIT_TICKS == 1)
+#define EVENT_FLAGS_INVALID_BITS  0xFFFFFF00UL
+#else
+#define EVENT_FLAGS_INVALID_BITS  0xFF000000UL
+#endif
+
+/* Event flags can be set and cleared from an ISR either directly or through
+   the timer daemon. */
+#if (configUSE_EVENT_GROUP_DIRECT_WAKE == 1) || ((INCLUDE_xTimerPendFunctionCall == 1) && (configUSE_TIMERS == 1))
+#define EVENT_FLAGS_FROM_ISR      1
+#else
+#define EVENT_FLAGS_FROM_ISR      0
+#endif
+
+/* Recursive mutexes are told apart by bit 0 of their ID. */
+#define MUTEX_RECURSIVE_TAG       1U
+
+/* Timers created in caller memory are told apart by bit 0 of their ID. */
+#define TIMER_STATIC_TAG          1U
+
+/* Parts of a memory pool taken from the FreeRTOS heap. */
+#define MPOOL_DYNAMIC_CB          1U
+#define MPOOL_DYNAMIC_MEM         2U
+
+/* SysTick and interrupt control registers, for the system timer count. */
+#ifndef configSYSTICK_CLOCK_HZ
+#define configSYSTICK_CLOCK_HZ    configCPU_CLOCK_HZ
+#endif
+#define SYSTICK_LOAD_REG          (*((volatile uint32_t *)0xE000E014UL))
+#define SYSTICK_CURRENT_VALUE_REG (*((volatile uint32_t *)0xE000E018UL))
+#define SCB_ICSR_REG              (*((volatile uint32_t *)0xE000ED04UL))
+#define SCB_ICSR_PENDSTSET        (1UL << 26)
+
+static osKernelState_t KernelState = osKernelInactive;
+
+/* Determine whether we are in thread mode or handler mode. */
+static int inHandlerMode (void)
+{
+  return __get_IPSR() != 0U;
+}
+
+/* Convert a CMSIS timeout to FreeRTOS ticks */
+static TickType_t makeTicks (uint32_t timeout)
+{
+  TickType_t ticks;
+
+  if (timeout == osWaitForever) {
+    ticks = portMAX_DELAY;
+  }
+  else if (timeout >= (uint32_t)portMAX_DELAY) {
+    /* Longest finite wait a 16 bit tick count can express */
+    ticks = portMAX_DELAY - 1U;
+  }
+  else {
+    ticks = (TickType_t)timeout;
+  }
+
+  return ticks;
+}
+
+/* Convert from CMSIS type osPriority_t to FreeRTOS priority number */
+static UBaseType_t makeFreeRtosPriority (osPriority_t priority)
+{
+  UBaseType_t fpriority;
+
+#if (configMAX_PRIORITIES >= 56)
+  fpriority = (UBaseType_t)priority;
+#else
+  /* osPriorityIdle stays at tskIDLE_PRIORITY, osPriorityNormal..Normal7 map to
+     the FreeRTOS priority the v1 osPriorityNormal maps to, and so on. */
+  fpriority = tskIDLE_PRIORITY + ((UBaseType_t)priority / 8U);
+
+  if (fpriority > (UBaseType_t)(configMAX_PRIORITIES - 1)) {
+    fpriority = (UBaseType_t)(configMAX_PRIORITIES - 1);
+  }
+#endif
+
+  return fpriority;
+}
+
+#if (INCLUDE_uxTaskPriorityGet == 1)
+/* Convert from FreeRTOS priority number to CMSIS type osPriority_t */
+static osPriority_t makeCmsisPriority (UBaseType_t fpriority)
+{
+  osPriority_t priority;
+
+#if (configMAX_PRIORITIES >= 56)
+  priority = (osPriority_t)fpriority;
+#else
+  priority = (osPriority_t)((fpriority - tskIDLE_PRIORITY) * 8U);
+#endif
+
+  if (priority < osPriorityIdle) {
+    priority = osPriorityIdle;
+  }
+
+  return priority;
+}
+#endif
+
+/* Which memory an object is created in: 1 - caller supplied, 0 - FreeRTOS
+   heap, -1 - inconsistent attributes. */
+static int32_t objectMemory (const void *cb_mem, uint32_t cb_size, uint32_t cb_min)
+{
+  int32_t mem = -1;
+
+  if ((cb_mem != NULL) && (cb_size >= cb_min)) {
+    mem = 1;
+  }
+  else if ((cb_mem == NULL) && (cb_size == 0U)) {
+    mem = 0;
+  }
+
+  return mem;
+}
+
+/*---------------------------------------------------------------------------*/
+/*  Kernel Management                                                        */
+/*---------------------------------------------------------------------------*/
+
+osStatus_t osKernelInitialize (void)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (KernelState == osKernelInactive) {
+    KernelState = osKernelReady;
+    stat = osOK;
+  }
+  else {
+    stat = osError;
+  }
+
+  return stat;
+}
+
+osStatus_t osKernelGetInfo (osVersion_t *version, char *id_buf, uint32_t id_size)
+{
+  if (version != NULL) {
+    version->api    = 20010003UL;
+    version->kernel = KERNEL_VERSION;
+  }
+
+  if ((id_buf != NULL) && (id_size != 0U)) {
+    if (id_size > sizeof(KERNEL_ID)) {
+      id_size = sizeof(KERNEL_ID);
+    }
+    memcpy(id_buf, KERNEL_ID, id_size - 1U);
+    id_buf[id_size - 1U] = '\0';
+  }
+
+  return osOK;
+}
+
+osKernelState_t osKernelGetState (void)
+{
+  osKernelState_t state;
+
+  switch (xTaskGetSchedulerState()) {
+    case taskSCHEDULER_RUNNING:
+      state = osKernelRunning;
+      break;
+
+    case taskSCHEDULER_SUSPENDED:
+      state = (KernelState == osKernelSuspended) ? osKernelSuspended : osKernelLocked;
+      break;
+
+    case taskSCHEDULER_NOT_STARTED:
+    default:
+      state = (KernelState == osKernelReady) ? osKernelReady : osKernelInactive;
+      break;
+  }
+
+  return state;
+}
+
+osStatus_t osKernelStart (void)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (KernelState == osKernelReady) {
+    KernelState = osKernelRunning;
+    vTaskStartScheduler();
+
+    /* Only returns if the idle or timer task could not be created. */
+    KernelState = osKernelError;
+    stat = osErrorNoMemory;
+  }
+  else {
+    stat = osError;
+  }
+
+  return stat;
+}
+
+int32_t osKernelLock (void)
+{
+  int32_t lock;
+
+  if (inHandlerMode()) {
+    lock = (int32_t)osErrorISR;
+  }
+  else {
+    switch (xTaskGetSchedulerState()) {
+      case taskSCHEDULER_SUSPENDED:
+        lock = 1;
+        break;
+
+      case taskSCHEDULER_RUNNING:
+        vTaskSuspendAll();
+        lock = 0;
+        break;
+
+      case taskSCHEDULER_NOT_STARTED:
+      default:
+        lock = (int32_t)osError;
+        break;
+    }
+  }
+
+  return lock;
+}
+
+int32_t osKernelUnlock (void)
+{
+  int32_t lock;
+
+  if (inHandlerMode()) {
+    lock = (int32_t)osErrorISR;
+  }
+  else {
+    switch (xTaskGetSchedulerState()) {
+      case taskSCHEDULER_SUSPENDED:
+        lock = 1;
+        (void)xTaskResumeAll();
+        break;
+
+      case taskSCHEDULER_RUNNING:
+        lock = 0;
+        break;
+
+      case taskSCHEDULER_NOT_STARTED:
+      default:
+        lock = (int32_t)osError;
+        break;
+    }
+  }
+
+  return lock;
+}
+
+int32_t osKernelRestoreLock (int32_t lock)
+{
+  BaseType_t state;
+
+  if (inHandlerMode()) {
+    lock = (int32_t)osErrorISR;
+  }
+  else if ((lock != 0) && (lock != 1)) {
+    lock = (int32_t)osErrorParameter;
+  }
+  else {
+    state = xTaskGetSchedulerState();
+
+    if (state == taskSCHEDULER_NOT_STARTED) {
+      lock = (int32_t)osError;
+    }
+    else if ((lock == 1) && (state == taskSCHEDULER_RUNNING)) {
+      vTaskSuspendAll();
+    }
+    else if ((lock == 0) && (state == taskSCHEDULER_SUSPENDED)) {
+      (void)xTaskResumeAll();
+    }
+    else {
+      /* Already in the requested state. */
+    }
+  }
+
+  return lock;
+}
+
+/* FreeRTOS stops the tick by itself when configUSE_TICKLESS_IDLE is set, so
+   osKernelSuspend only locks the scheduler and reports no time to sleep, and
+   osKernelResume unlocks it again. */
+uint32_t osKernelSuspend (void)
+{
+  if (!inHandlerMode() && (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)) {
+    vTaskSuspendAll();
+    KernelState = osKernelSuspended;
+  }
+
+  return 0U;
+}
+
+void osKernelResume (uint32_t sleep_ticks)
+{
+  (void)sleep_ticks;
+
+  if (!inHandlerMode() && (KernelState == osKernelSuspended)) {
+    KernelState = osKernelRunning;
+    (void)xTaskResumeAll();
+  }
+}
+
+uint32_t osKernelGetTickCount (void)
+{
+  TickType_t ticks;
+
+  if (inHandlerMode()) {
+    ticks = xTaskGetTickCountFromISR();
+  }
+  else {
+    ticks = xTaskGetTickCount();
+  }
+
+  return (uint32_t)ticks;
+}
+
+uint32_t osKernelGetTickFreq (void)
+{
+  return configTICK_RATE_HZ;
+}
+
+uint32_t osKernelGetSysTimerCount (void)
+{
+  uint32_t primask;
+  uint32_t load;
+  uint32_t val;
+  TickType_t ticks;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  ticks = xTaskGetTickCountFromISR();
+  load  = SYSTICK_LOAD_REG;
+  val   = load - SYSTICK_CURRENT_VALUE_REG;
+
+  /* A tick that wrapped while interrupts were off has not been counted yet. */
+  if ((SCB_ICSR_REG & SCB_ICSR_PENDSTSET) != 0U) {
+    val = load - SYSTICK_CURRENT_VALUE_REG;
+    ticks++;
+  }
+
+  val += (uint32_t)ticks * (load + 1U);
+
+  if (primask == 0U) {
+    __enable_irq();
+  }
+
+  return val;
+}
+
+uint32_t osKernelGetSysTimerFreq (void)
+{
+  return configSYSTICK_CLOCK_HZ;
+}
+
+/*---------------------------------------------------------------------------*/
+/*  Thread Management                                                        */
+/*---------------------------------------------------------------------------*/
+
+osThreadId_t osThreadNew (osThreadFunc_t func, void *argument, const osThreadAttr_t *attr)
+{
+  const char *name;
+  uint32_t stack;
+  osPriority_t prio;
+  TaskHandle_t hTask;
+  int32_t mem;
+
+  hTask = NULL;
+
+  if (!inHandlerMode() && (func != NULL)) {
+    name  = NULL;
+    stack = configMINIMAL_STACK_SIZE;
+    prio  = osPriorityNormal;
+    mem   = 0;
+
+    if (attr != NULL) {
+      name = attr->name;
+
+      if (attr->priority != osPriorityNone) {
+        prio = attr->priority;
+      }
+
+      if (attr->stack_size > 0U) {
+        /* stack_size is in bytes, FreeRTOS counts StackType_t words. */
+        stack = attr->stack_size / sizeof(StackType_t);
+      }
+
+      mem = objectMemory(attr->cb_mem, attr->cb_size, sizeof(StaticTask_t));
+
+      if ((mem == 1) && ((attr->stack_mem == NULL) || (attr->stack_size == 0U))) {
+        mem = -1;
+      }
+      if ((mem == 0) && (attr->stack_mem != NULL)) {
+        mem = -1;
+      }
+
+      /* Threads are always detached: nothing can wait for a FreeRTOS task to
+         end, so a joinable thread is refused rather than created. */
+      if ((prio < osPriorityIdle) || (prio > osPriorityISR) ||
+          ((attr->attr_bits & osThreadJoinable) == osThreadJoinable)) {
+        mem = -1;
+      }
+    }
+
+    if (mem == 1) {
+      #if (configSUPPORT_STATIC_ALLOCATION == 1)
+        hTask = xTaskCreateStatic((TaskFunction_t)func, name, stack, argument, makeFreeRtosPriority(prio),
+                                  (StackType_t *)attr->stack_mem, (StaticTask_t *)attr->cb_mem);
+      #endif
+    }
+    else if (mem == 0) {
+      #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        if (xTaskCreate((TaskFunction_t)func, name, (configSTACK_DEPTH_TYPE)stack, argument,
+                        makeFreeRtosPriority(prio), &hTask) != pdPASS) {
+          hTask = NULL;
+        }
+      #endif
+    }
+  }
+
+  return (osThreadId_t)hTask;
+}
+
+const char *osThreadGetName (osThreadId_t thread_id)
+{
+  const char *name;
+
+  if (inHandlerMode() || (thread_id == NULL)) {
+    name = NULL;
+  }
+  else {
+    name = pcTaskGetName((TaskHandle_t)thread_id);
+  }
+
+  return name;
+}
+
+osThreadId_t osThreadGetId (void)
+{
+#if ((INCLUDE_xTaskGetCurrentTaskHandle == 1) || (configUSE_MUTEXES == 1))
+  return (osThreadId_t)xTaskGetCurrentTaskHandle();
+#else
+  return NULL;
+#endif
+}
+
+osThreadState_t osThreadGetState (osThreadId_t thread_id)
+{
+  osThreadState_t state;
+
+  if (inHandlerMode() || (thread_id == NULL)) {
+    state = osThreadError;
+  }
+  else {
+#if ((INCLUDE_eTaskGetState == 1) || (configUSE_TRACE_FACILITY == 1))
+    switch (eTaskGetState((TaskHandle_t)thread_id)) {
+      case eRunning:   state = osThreadRunning;    break;
+      case eReady:     state = osThreadReady;      break;
+      case eBlocked:
+      case eSuspended: state = osThreadBlocked;    break;
+      case eDeleted:   state = osThreadTerminated; break;
+      case eInvalid:
+      default:         state = osThreadError;      break;
+    }
+#else
+    state = osThreadError;
+#endif
+  }
+
+  return state;
+}
+
+/* The stack size is not kept in the task control block. */
+uint32_t osThreadGetStackSize (osThreadId_t thread_id)
+{
+  (void)thread_id;
+
+  return 0U;
+}
+
+uint32_t osThreadGetStackSpace (osThreadId_t thread_id)
+{
+  uint32_t sz = 0U;
+
+  if (!inHandlerMode() && (thread_id != NULL)) {
+#if (INCLUDE_uxTaskGetStackHighWaterMark == 1)
+    sz = (uint32_t)(uxTaskGetStackHighWaterMark((TaskHandle_t)thread_id) * sizeof(StackType_t));
+#endif
+  }
+
+  return sz;
+}
+
+osStatus_t osThreadSetPriority (osThreadId_t thread_id, osPriority_t priority)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if ((thread_id == NULL) || (priority < osPriorityIdle) || (priority > osPriorityISR)) {
+    stat = osErrorParameter;
+  }
+  else {
+#if (INCLUDE_vTaskPrioritySet == 1)
+    vTaskPrioritySet((TaskHandle_t)thread_id, makeFreeRtosPriority(priority));
+    stat = osOK;
+#else
+    stat = osError;
+#endif
+  }
+
+  return stat;
+}
+
+osPriority_t osThreadGetPriority (osThreadId_t thread_id)
+{
+  osPriority_t prio;
+
+  if (inHandlerMode() || (thread_id == NULL)) {
+    prio = osPriorityError;
+  }
+  else {
+#if (INCLUDE_uxTaskPriorityGet == 1)
+    prio = makeCmsisPriority(uxTaskPriorityGet((TaskHandle_t)thread_id));
+#else
+    prio = osPriorityError;
+#endif
+  }
+
+  return prio;
+}
+
+osStatus_t osThreadYield (void)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else {
+    taskYIELD();
+    stat = osOK;
+  }
+
+  return stat;
+}
+
+osStatus_t osThreadSuspend (osThreadId_t thread_id)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (thread_id == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+#if (INCLUDE_vTaskSuspend == 1)
+    vTaskSuspend((TaskHandle_t)thread_id);
+    stat = osOK;
+#else
+    stat = osError;
+#endif
+  }
+
+  return stat;
+}
+
+osStatus_t osThreadResume (osThreadId_t thread_id)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (thread_id == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+#if (INCLUDE_vTaskSuspend == 1)
+    vTaskResume((TaskHandle_t)thread_id);
+    stat = osOK;
+#else
+    stat = osError;
+#endif
+  }
+
+  return stat;
+}
+
+/* Threads are never joinable (see osThreadNew), so there is nothing to detach
+   or join. */
+osStatus_t osThreadDetach (osThreadId_t thread_id)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (thread_id == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    stat = osErrorResource;
+  }
+
+  return stat;
+}
+
+osStatus_t osThreadJoin (osThreadId_t thread_id)
+{
+  return osThreadDetach(thread_id);
+}
+
+__NO_RETURN void osThreadExit (void)
+{
+#if (INCLUDE_vTaskDelete == 1)
+  vTaskDelete(NULL);
+#endif
+  for (;;);
+}
+
+osStatus_t osThreadTerminate (osThreadId_t thread_id)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (thread_id == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+#if (INCLUDE_vTaskDelete == 1)
+  #if ((INCLUDE_eTaskGetState == 1) || (configUSE_TRACE_FACILITY == 1))
+    if (eTaskGetState((TaskHandle_t)thread_id) == eDeleted) {
+      stat = osErrorResource;
+    }
+    else
+  #endif
+    {
+      vTaskDelete((TaskHandle_t)thread_id);
+      stat = osOK;
+    }
+#else
+    stat = osError;
+#endif
+  }
+
+  return stat;
+}
+
+uint32_t osThreadGetCount (void)
+{
+  uint32_t count;
+
+  if (inHandlerMode()) {
+    count = 0U;
+  }
+  else {
+    count = (uint32_t)uxTaskGetNumberOfTasks();
+  }
+
+  return count;
+}
+
+uint32_t osThreadEnumerate (osThreadId_t *thread_array, uint32_t array_items)
+{
+  uint32_t count = 0U;
+#if ((configUSE_TRACE_FACILITY == 1) && (configSUPPORT_DYNAMIC_ALLOCATION == 1))
+  TaskStatus_t *task;
+  uint32_t i;
+
+  if (!inHandlerMode() && (thread_array != NULL) && (array_items != 0U)) {
+    vTaskSuspendAll();
+
+    count = (uint32_t)uxTaskGetNumberOfTasks();
+    task  = pvPortMalloc(count * sizeof(TaskStatus_t));
+
+    if (task != NULL) {
+      count = (uint32_t)uxTaskGetSystemState(task, (UBaseType_t)count, NULL);
+
+      for (i = 0U; (i < count) && (i < array_items); i++) {
+        thread_array[i] = (osThreadId_t)task[i].xHandle;
+      }
+      count = i;
+
+      vPortFree(task);
+    }
+    else {
+      count = 0U;
+    }
+
+    (void)xTaskResumeAll();
+  }
+#else
+  (void)thread_array;
+  (void)array_items;
+#endif
+
+  return count;
+}
+
+/*---------------------------------------------------------------------------*/
+/*  Thread Flags                                                             */
+/*---------------------------------------------------------------------------*/
+
+#if (configUSE_TASK_NOTIFICATIONS == 1)
+
+uint32_t osThreadFlagsSet (osThreadId_t thread_id, uint32_t flags)
+{
+  TaskHandle_t hTask = (TaskHandle_t)thread_id;
+  uint32_t rflags;
+  BaseType_t yield;
+
+  rflags = 0U;
+
+  if ((hTask == NULL) || ((flags & THREAD_FLAGS_INVALID_BITS) != 0U)) {
+    rflags = osFlagsErrorParameter;
+  }
+  else if (inHandlerMode()) {
+    yield = pdFALSE;
+    (void)xTaskNotifyAndQueryFromISR(hTask, flags, eSetBits, &rflags, &yield);
+    rflags |= flags;
+    portYIELD_FROM_ISR(yield);
+  }
+  else {
+    (void)xTaskNotifyAndQuery(hTask, flags, eSetBits, &rflags);
+    rflags |= flags;
+  }
+
+  return rflags;
+}
+
+uint32_t osThreadFlagsClear (uint32_t flags)
+{
+  uint32_t rflags;
+
+  if (inHandlerMode()) {
+    rflags = osFlagsErrorISR;
+  }
+  else if ((flags & THREAD_FLAGS_INVALID_BITS) != 0U) {
+    rflags = osFlagsErrorParameter;
+  }
+  else {
+    /* Returns the value before the bits were cleared. */
+    rflags = ulTaskNotifyValueClear(NULL, flags);
+  }
+
+  return rflags;
+}
+
+uint32_t osThreadFlagsGet (void)
+{
+  uint32_t rflags;
+
+  if (inHandlerMode()) {
+    rflags = osFlagsErrorISR;
+  }
+  else {
+    rflags = ulTaskNotifyValueClear(NULL, 0U);
+  }
+
+  return rflags;
+}
+
+uint32_t osThreadFlagsWait (uint32_t flags, uint32_t options, uint32_t timeout)
+{
+  uint32_t rflags;
+  uint32_t nval;
+  BaseType_t match;
+  TickType_t t0;
+  TickType_t td;
+  TickType_t tout;
+
+  if (inHandlerMode()) {
+    rflags = osFlagsErrorISR;
+  }
+  else if ((flags == 0U) || ((flags & THREAD_FLAGS_INVALID_BITS) != 0U)) {
+    rflags = osFlagsErrorParameter;
+  }
+  else {
+    t0   = xTaskGetTickCount();
+    tout = makeTicks(timeout);
+
+    for (;;) {
+      /* Test and consume the flags in one critical section, so flags set by
+         another thread or an ISR in between are neither lost nor consumed
+         twice. */
+      taskENTER_CRITICAL();
+      nval = ulTaskNotifyValueClear(NULL, 0U);
+
+      if ((options & osFlagsWaitAll) == osFlagsWaitAll) {
+        match = ((nval & flags) == flags) ? pdTRUE : pdFALSE;
+      }
+      else {
+        match = ((nval & flags) != 0U) ? pdTRUE : pdFALSE;
+      }
+
+      if ((match != pdFALSE) && ((options & osFlagsNoClear) != osFlagsNoClear)) {
+        (void)ulTaskNotifyValueClear(NULL, flags);
+      }
+      taskEXIT_CRITICAL();
+
+      if (match != pdFALSE) {
+        rflags = nval;
+        break;
+      }
+
+      if (timeout == 0U) {
+        rflags = osFlagsErrorResource;
+        break;
+      }
+
+      if (timeout != osWaitForever) {
+        td = xTaskGetTickCount() - t0;
+
+        if (td >= makeTicks(timeout)) {
+          rflags = osFlagsErrorTimeout;
+          break;
+        }
+        tout = makeTicks(timeout) - td;
+      }
+
+      /* Any notification, including one that arrived since the test above,
+         ends the wait and the flags are tested again. */
+      (void)xTaskNotifyWait(0U, 0U, NULL, tout);
+    }
+  }
+
+  return rflags;
+}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+
+/*---------------------------------------------------------------------------*/
+/*  Generic Wait                                                             */
+/*---------------------------------------------------------------------------*/
+
+osStatus_t osDelay (uint32_t ticks)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else {
+#if (INCLUDE_vTaskDelay == 1)
+    if (ticks != 0U) {
+      vTaskDelay(makeTicks(ticks));
+    }
+    stat = osOK;
+#else
+    (void)ticks;
+    stat = osErrorResource;
+#endif
+  }
+
+  return stat;
+}
+
+osStatus_t osDelayUntil (uint32_t ticks)
+{
+  osStatus_t stat;
+  TickType_t tcnt;
+  TickType_t delay;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else {
+    tcnt  = xTaskGetTickCount();
+    delay = (TickType_t)ticks - tcnt;
+
+    /* A time in the past, or more than half the tick range ahead, is refused. */
+    if ((delay != 0U) && ((delay >> ((sizeof(TickType_t) * 8U) - 1U)) == 0U)) {
+#if (INCLUDE_vTaskDelayUntil == 1)
+      /* Measured from tcnt, so being preempted here does not add to the
+         delay. */
+      vTaskDelayUntil(&tcnt, delay);
+      stat = osOK;
+#elif (INCLUDE_vTaskDelay == 1)
+      vTaskDelay(delay);
+      stat = osOK;
+#else
+      stat = osErrorResource;
+#endif
+    }
+    else {
+      stat = osErrorParameter;
+    }
+  }
+
+  return stat;
+}
+
+/*---------------------------------------------------------------------------*/
+/*  Timer Management                                                         */
+/*---------------------------------------------------------------------------*/
+
+#if (configUSE_TIMERS == 1)
+
+static TimerCallback_t *timerCallback (TimerHandle_t hTimer)
+{
+  return (TimerCallback_t *)((uintptr_t)pvTimerGetTimerID(hTimer) & ~(uintptr_t)TIMER_STATIC_TAG);
+}
+
+/* Runs in the timer daemon.  The callback is read in a critical section so
+   osTimerDelete cannot free it between the ID and the function being read. */
+static void TimerCallback (TimerHandle_t hTimer)
+{
+  TimerCallback_t *callb;
+  osTimerFunc_t func = NULL;
+  void *arg = NULL;
+
+  taskENTER_CRITICAL();
+  callb = timerCallback(hTimer);
+  if (callb != NULL) {
+    func = callb->func;
+    arg  = callb->arg;
+  }
+  taskEXIT_CRITICAL();
+
+  if (func != NULL) {
+    func(arg);
+  }
+}
+
+osTimerId_t osTimerNew (osTimerFunc_t func, osTimerType_t type, void *argument, const osTimerAttr_t *attr)
+{
+  const char *name;
+  TimerHandle_t hTimer;
+  TimerCallback_t *callb;
+  UBaseType_t reload;
+  int32_t mem;
+
+  hTimer = NULL;
+
+  if (!inHandlerMode() && (func != NULL)) {
+    reload = (type == osTimerOnce) ? pdFALSE : pdTRUE;
+    name   = NULL;
+    mem    = 0;
+
+    if (attr != NULL) {
+      name = attr->name;
+      mem  = objectMemory(attr->cb_mem, attr->cb_size, sizeof(osStaticTimerDef_t));
+    }
+
+    if (mem == 1) {
+      #if (configSUPPORT_STATIC_ALLOCATION == 1)
+        callb = &((osStaticTimerDef_t *)attr->cb_mem)->callb;
+        callb->func = func;
+        callb->arg  = argument;
+
+        hTimer = xTimerCreateStatic(name, 1, reload, (void *)((uintptr_t)callb | TIMER_STATIC_TAG),
+                                    TimerCallback, &((osStaticTimerDef_t *)attr->cb_mem)->timer);
+      #endif
+    }
+    else if (mem == 0) {
+      #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        callb = pvPortMalloc(sizeof(TimerCallback_t));
+
+        if (callb != NULL) {
+          callb->func = func;
+          callb->arg  = argument;
+
+          hTimer = xTimerCreate(name, 1, reload, callb, TimerCallback);
+
+          if (hTimer == NULL) {
+            vPortFree(callb);
+          }
+        }
+      #endif
+    }
+  }
+
+  return (osTimerId_t)hTimer;
+}
+
+const char *osTimerGetName (osTimerId_t timer_id)
+{
+  const char *name;
+
+  if (inHandlerMode() || (timer_id == NULL)) {
+    name = NULL;
+  }
+  else {
+    name = pcTimerGetName((TimerHandle_t)timer_id);
+  }
+
+  return name;
+}
+
+osStatus_t osTimerStart (osTimerId_t timer_id, uint32_t ticks)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if ((timer_id == NULL) || (ticks == 0U)) {
+    stat = osErrorParameter;
+  }
+  else {
+    /* Changing the period also starts a dormant timer. */
+    if (xTimerChangePeriod((TimerHandle_t)timer_id, makeTicks(ticks), 0) == pdPASS) {
+      stat = osOK;
+    }
+    else {
+      stat = osErrorResource;
+    }
+  }
+
+  return stat;
+}
+
+osStatus_t osTimerStop (osTimerId_t timer_id)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (timer_id == NULL) {
+    stat = osErrorParameter;
+  }
+  else if (xTimerIsTimerActive((TimerHandle_t)timer_id) == pdFALSE) {
+    stat = osErrorResource;
+  }
+  else if (xTimerStop((TimerHandle_t)timer_id, 0) == pdPASS) {
+    stat = osOK;
+  }
+  else {
+    stat = osError;
+  }
+
+  return stat;
+}
+
+uint32_t osTimerIsRunning (osTimerId_t timer_id)
+{
+  uint32_t running;
+
+  if (inHandlerMode() || (timer_id == NULL)) {
+    running = 0U;
+  }
+  else {
+    running = (xTimerIsTimerActive((TimerHandle_t)timer_id) != pdFALSE) ? 1U : 0U;
+  }
+
+  return running;
+}
+
+osStatus_t osTimerDelete (osTimerId_t timer_id)
+{
+  osStatus_t stat;
+  TimerHandle_t hTimer = (TimerHandle_t)timer_id;
+  void *id;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (hTimer == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    /* Detach the callback first, so the daemon does not call it while the
+       delete command is queued. */
+    taskENTER_CRITICAL();
+    id = pvTimerGetTimerID(hTimer);
+    vTimerSetTimerID(hTimer, NULL);
+    taskEXIT_CRITICAL();
+
+    if (xTimerDelete(hTimer, 0) == pdPASS) {
+      #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        if (((uintptr_t)id & TIMER_STATIC_TAG) == 0U) {
+          vPortFree(id);
+        }
+      #endif
+      stat = osOK;
+    }
+    else {
+      vTimerSetTimerID(hTimer, id);
+      stat = osErrorResource;
+    }
+  }
+
+  return stat;
+}
+
+#endif /* configUSE_TIMERS */
+
+/*---------------------------------------------------------------------------*/
+/*  Event Flags                                                              */
+/*---------------------------------------------------------------------------*/
+
+osEventFlagsId_t osEventFlagsNew (const osEventFlagsAttr_t *attr)
+{
+  EventGroupHandle_t hEventGroup;
+  int32_t mem;
+
+  hEventGroup = NULL;
+
+  if (!inHandlerMode()) {
+    mem = 0;
+
+    if (attr != NULL) {
+      mem = objectMemory(attr->cb_mem, attr->cb_size, sizeof(StaticEventGroup_t));
+    }
+
+    if (mem == 1) {
+      #if (configSUPPORT_STATIC_ALLOCATION == 1)
+        hEventGroup = xEventGroupCreateStatic((StaticEventGroup_t *)attr->cb_mem);
+      #endif
+    }
+    else if (mem == 0) {
+      #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        hEventGroup = xEventGroupCreate();
+      #endif
+    }
+  }
+
+  return (osEventFlagsId_t)hEventGroup;
+}
+
+/* Event groups have no name. */
+const char *osEventFlagsGetName (osEventFlagsId_t ef_id)
+{
+  (void)ef_id;
+
+  return NULL;
+}
+
+uint32_t osEventFlagsSet (osEventFlagsId_t ef_id, uint32_t flags)
+{
+  EventGroupHandle_t hEventGroup = (EventGroupHandle_t)ef_id;
+  uint32_t rflags;
+#if (EVENT_FLAGS_FROM_ISR == 1)
+  BaseType_t yield;
+#endif
+
+  if ((hEventGroup == NULL) || ((flags & EVENT_FLAGS_INVALID_BITS) != 0U)) {
+    rflags = osFlagsErrorParameter;
+  }
+  else if (inHandlerMode()) {
+#if (EVENT_FLAGS_FROM_ISR == 1)
+    yield = pdFALSE;
+
+    if (xEventGroupSetBitsFromISR(hEventGroup, (EventBits_t)flags, &yield) == pdFAIL) {
+      rflags = osFlagsErrorResource;
+    }
+    else {
+      rflags = flags;
+      portYIELD_FROM_ISR(yield);
+    }
+#else
+    rflags = osFlagsErrorISR;
+#endif
+  }
+  else {
+    rflags = (uint32_t)xEventGroupSetBits(hEventGroup, (EventBits_t)flags);
+  }
+
+  return rflags;
+}
+
+uint32_t osEventFlagsClear (osEventFlagsId_t ef_id, uint32_t flags)
+{
+  EventGroupHandle_t hEventGroup = (EventGroupHandle_t)ef_id;
+  uint32_t rflags;
+
+  if ((hEventGroup == NULL) || ((flags & EVENT_FLAGS_INVALID_BITS) != 0U)) {
+    rflags = osFlagsErrorParameter;
+  }
+  else if (inHandlerMode()) {
+#if (EVENT_FLAGS_FROM_ISR == 1)
+    rflags = (uint32_t)xEventGroupGetBitsFromISR(hEventGroup);
+
+    if (xEventGroupClearBitsFromISR(hEventGroup, (EventBits_t)flags) == pdFAIL) {
+      rflags = osFlagsErrorResource;
+    }
+#else
+    rflags = osFlagsErrorISR;
+#endif
+  }
+  else {
+    rflags = (uint32_t)xEventGroupClearBits(hEventGroup, (EventBits_t)flags);
+  }
+
+  return rflags;
+}
+
+uint32_t osEventFlagsGet (osEventFlagsId_t ef_id)
+{
+  EventGroupHandle_t hEventGroup = (EventGroupHandle_t)ef_id;
+  uint32_t rflags;
+
+  if (hEventGroup == NULL) {
+    rflags = 0U;
+  }
+  else if (inHandlerMode()) {
+    rflags = (uint32_t)xEventGroupGetBitsFromISR(hEventGroup);
+  }
+  else {
+    rflags = (uint32_t)xEventGroupGetBits(hEventGroup);
+  }
+
+  return rflags;
+}
+
+uint32_t osEventFlagsWait (osEventFlagsId_t ef_id, uint32_t flags, uint32_t options, uint32_t timeout)
+{
+  EventGroupHandle_t hEventGroup = (EventGroupHandle_t)ef_id;
+  BaseType_t wait_all;
+  BaseType_t exit_clr;
+  uint32_t rflags;
+
+  if (inHandlerMode()) {
+    rflags = osFlagsErrorISR;
+  }
+  else if ((hEventGroup == NULL) || (flags == 0U) || ((flags & EVENT_FLAGS_INVALID_BITS) != 0U)) {
+    rflags = osFlagsErrorParameter;
+  }
+  else {
+    wait_all = ((options & osFlagsWaitAll) == osFlagsWaitAll) ? pdTRUE : pdFALSE;
+    exit_clr = ((options & osFlagsNoClear) == osFlagsNoClear) ? pdFALSE : pdTRUE;
+
+    rflags = (uint32_t)xEventGroupWaitBits(hEventGroup, (EventBits_t)flags, exit_clr, wait_all, makeTicks(timeout));
+
+    if (((wait_all != pdFALSE) && ((rflags & flags) != flags)) ||
+        ((wait_all == pdFALSE) && ((rflags & flags) == 0U))) {
+      rflags = (timeout == 0U) ? osFlagsErrorResource : osFlagsErrorTimeout;
+    }
+  }
+
+  return rflags;
+}
+
+osStatus_t osEventFlagsDelete (osEventFlagsId_t ef_id)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (ef_id == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    vEventGroupDelete((EventGroupHandle_t)ef_id);
+    stat = osOK;
+  }
+
+  return stat;
+}
+
+/*---------------------------------------------------------------------------*/
+/*  Mutex Management                                                         */
+/*---------------------------------------------------------------------------*/
+
+#if (configUSE_MUTEXES == 1)
+
+static SemaphoreHandle_t mutexHandle (osMutexId_t mutex_id, uint32_t *rmtx)
+{
+  *rmtx = (uint32_t)((uintptr_t)mutex_id & MUTEX_RECURSIVE_TAG);
+
+  return (SemaphoreHandle_t)((uintptr_t)mutex_id & ~(uintptr_t)MUTEX_RECURSIVE_TAG);
+}
+
+/* FreeRTOS mutexes always inherit priority, so osMutexPrioInherit is implied;
+   robust mutexes are not supported. */
+osMutexId_t osMutexNew (const osMutexAttr_t *attr)
+{
+  SemaphoreHandle_t hMutex;
+  uint32_t type;
+  uint32_t rmtx;
+  int32_t mem;
+
+  hMutex = NULL;
+  rmtx   = 0U;
+
+  if (!inHandlerMode()) {
+    type = (attr != NULL) ? attr->attr_bits : 0U;
+    rmtx = ((type & osMutexRecursive) == osMutexRecursive) ? 1U : 0U;
+    mem  = 0;
+
+    if (attr != NULL) {
+      mem = objectMemory(attr->cb_mem, attr->cb_size, sizeof(StaticSemaphore_t));
+    }
+
+    if ((type & osMutexRobust) == osMutexRobust) {
+      mem = -1;
+    }
+
+    if (mem == 1) {
+      #if (configSUPPORT_STATIC_ALLOCATION == 1)
+        if (rmtx != 0U) {
+          #if (configUSE_RECURSIVE_MUTEXES == 1)
+            hMutex = xSemaphoreCreateRecursiveMutexStatic((StaticSemaphore_t *)attr->cb_mem);
+          #endif
+        }
+        else {
+          hMutex = xSemaphoreCreateMutexStatic((StaticSemaphore_t *)attr->cb_mem);
+        }
+      #endif
+    }
+    else if (mem == 0) {
+      #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        if (rmtx != 0U) {
+          #if (configUSE_RECURSIVE_MUTEXES == 1)
+            hMutex = xSemaphoreCreateRecursiveMutex();
+          #endif
+        }
+        else {
+          hMutex = xSemaphoreCreateMutex();
+        }
+      #endif
+    }
+
+    #if (configQUEUE_REGISTRY_SIZE > 0)
+      if ((hMutex != NULL) && (attr != NULL) && (attr->name != NULL)) {
+        vQueueAddToRegistry(hMutex, attr->name);
+      }
+    #endif
+
+    if ((hMutex != NULL) && (rmtx != 0U)) {
+      hMutex = (SemaphoreHandle_t)((uintptr_t)hMutex | MUTEX_RECURSIVE_TAG);
+    }
+  }
+
+  return (osMutexId_t)hMutex;
+}
+
+const char *osMutexGetName (osMutexId_t mutex_id)
+{
+  const char *name = NULL;
+  uint32_t rmtx;
+  SemaphoreHandle_t hMutex = mutexHandle(mutex_id, &rmtx);
+
+  if (!inHandlerMode() && (hMutex != NULL)) {
+#if (configQUEUE_REGISTRY_SIZE > 0)
+    name = pcQueueGetName(hMutex);
+#endif
+  }
+
+  return name;
+}
+
+osStatus_t osMutexAcquire (osMutexId_t mutex_id, uint32_t timeout)
+{
+  osStatus_t stat;
+  uint32_t rmtx;
+  SemaphoreHandle_t hMutex = mutexHandle(mutex_id, &rmtx);
+  BaseType_t taken;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (hMutex == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    if (rmtx != 0U) {
+#if (configUSE_RECURSIVE_MUTEXES == 1)
+      taken = xSemaphoreTakeRecursive(hMutex, makeTicks(timeout));
+#else
+      taken = pdFAIL;
+#endif
+    }
+    else {
+      taken = xSemaphoreTake(hMutex, makeTicks(timeout));
+    }
+
+    if (taken == pdPASS) {
+      stat = osOK;
+    }
+    else {
+      stat = (timeout != 0U) ? osErrorTimeout : osErrorResource;
+    }
+  }
+
+  return stat;
+}
+
+osStatus_t osMutexRelease (osMutexId_t mutex_id)
+{
+  osStatus_t stat;
+  uint32_t rmtx;
+  SemaphoreHandle_t hMutex = mutexHandle(mutex_id, &rmtx);
+  BaseType_t given;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (hMutex == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    if (rmtx != 0U) {
+#if (configUSE_RECURSIVE_MUTEXES == 1)
+      given = xSemaphoreGiveRecursive(hMutex);
+#else
+      given = pdFAIL;
+#endif
+    }
+    else {
+      given = xSemaphoreGive(hMutex);
+    }
+
+    stat = (given == pdPASS) ? osOK : osErrorResource;
+  }
+
+  return stat;
+}
+
+osThreadId_t osMutexGetOwner (osMutexId_t mutex_id)
+{
+  osThreadId_t owner = NULL;
+  uint32_t rmtx;
+  SemaphoreHandle_t hMutex = mutexHandle(mutex_id, &rmtx);
+
+  if (!inHandlerMode() && (hMutex != NULL)) {
+#if (INCLUDE_xSemaphoreGetMutexHolder == 1)
+    owner = (osThreadId_t)xSemaphoreGetMutexHolder(hMutex);
+#endif
+  }
+
+  return owner;
+}
+
+osStatus_t osMutexDelete (osMutexId_t mutex_id)
+{
+  osStatus_t stat;
+  uint32_t rmtx;
+  SemaphoreHandle_t hMutex = mutexHandle(mutex_id, &rmtx);
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (hMutex == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    /* Also removes the mutex from the queue registry. */
+    vSemaphoreDelete(hMutex);
+    stat = osOK;
+  }
+
+  return stat;
+}
+
+#endif /* configUSE_MUTEXES */
+
+/*---------------------------------------------------------------------------*/
+/*  Semaphore Management                                                     */
+/*---------------------------------------------------------------------------*/
+
+/* A max_count of 1 gives a binary semaphore, anything larger a counting
+   semaphore, which needs configUSE_COUNTING_SEMAPHORES. */
+osSemaphoreId_t osSemaphoreNew (uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr)
+{
+  SemaphoreHandle_t hSemaphore;
+  int32_t mem;
+
+  hSemaphore = NULL;
+
+  if (!inHandlerMode() && (max_count > 0U) && (initial_count <= max_count)) {
+    mem = 0;
+
+    if (attr != NULL) {
+      mem = objectMemory(attr->cb_mem, attr->cb_size, sizeof(StaticSemaphore_t));
+    }
+
+    if (max_count == 1U) {
+      if (mem == 1) {
+        #if (configSUPPORT_STATIC_ALLOCATION == 1)
+          hSemaphore = xSemaphoreCreateBinaryStatic((StaticSemaphore_t *)attr->cb_mem);
+        #endif
+      }
+      else if (mem == 0) {
+        #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+          hSemaphore = xSemaphoreCreateBinary();
+        #endif
+      }
+
+      if ((hSemaphore != NULL) && (initial_count != 0U)) {
+        (void)xSemaphoreGive(hSemaphore);
+      }
+    }
+    else {
+      #if (configUSE_COUNTING_SEMAPHORES == 1)
+        if (mem == 1) {
+          #if (configSUPPORT_STATIC_ALLOCATION == 1)
+            hSemaphore = xSemaphoreCreateCountingStatic(max_count, initial_count, (StaticSemaphore_t *)attr->cb_mem);
+          #endif
+        }
+        else if (mem == 0) {
+          #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+            hSemaphore = xSemaphoreCreateCounting(max_count, initial_count);
+          #endif
+        }
+      #endif
+    }
+
+    #if (configQUEUE_REGISTRY_SIZE > 0)
+      if ((hSemaphore != NULL) && (attr != NULL) && (attr->name != NULL)) {
+        vQueueAddToRegistry(hSemaphore, attr->name);
+      }
+    #endif
+  }
+
+  return (osSemaphoreId_t)hSemaphore;
+}
+
+const char *osSemaphoreGetName (osSemaphoreId_t semaphore_id)
+{
+  const char *name = NULL;
+
+  if (!inHandlerMode() && (semaphore_id != NULL)) {
+#if (configQUEUE_REGISTRY_SIZE > 0)
+    name = pcQueueGetName((QueueHandle_t)semaphore_id);
+#endif
+  }
+
+  return name;
+}
+
+osStatus_t osSemaphoreAcquire (osSemaphoreId_t semaphore_id, uint32_t timeout)
+{
+  SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)semaphore_id;
+  osStatus_t stat;
+  BaseType_t yield;
+
+  if (hSemaphore == NULL) {
+    stat = osErrorParameter;
+  }
+  else if (inHandlerMode()) {
+    if (timeout != 0U) {
+      stat = osErrorParameter;
+    }
+    else {
+      yield = pdFALSE;
+
+      if (xSemaphoreTakeFromISR(hSemaphore, &yield) == pdPASS) {
+        stat = osOK;
+        portYIELD_FROM_ISR(yield);
+      }
+      else {
+        stat = osErrorResource;
+      }
+    }
+  }
+  else if (xSemaphoreTake(hSemaphore, makeTicks(timeout)) == pdPASS) {
+    stat = osOK;
+  }
+  else {
+    stat = (timeout != 0U) ? osErrorTimeout : osErrorResource;
+  }
+
+  return stat;
+}
+
+osStatus_t osSemaphoreRelease (osSemaphoreId_t semaphore_id)
+{
+  SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)semaphore_id;
+  osStatus_t stat;
+  BaseType_t yield;
+
+  if (hSemaphore == NULL) {
+    stat = osErrorParameter;
+  }
+  else if (inHandlerMode()) {
+    yield = pdFALSE;
+
+    if (xSemaphoreGiveFromISR(hSemaphore, &yield) == pdTRUE) {
+      stat = osOK;
+      portYIELD_FROM_ISR(yield);
+    }
+    else {
+      stat = osErrorResource;
+    }
+  }
+  else if (xSemaphoreGive(hSemaphore) == pdPASS) {
+    stat = osOK;
+  }
+  else {
+    stat = osErrorResource;
+  }
+
+  return stat;
+}
+
+uint32_t osSemaphoreGetCount (osSemaphoreId_t semaphore_id)
+{
+  SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)semaphore_id;
+  uint32_t count;
+
+  if (hSemaphore == NULL) {
+    count = 0U;
+  }
+  else if (inHandlerMode()) {
+    count = (uint32_t)uxQueueMessagesWaitingFromISR((QueueHandle_t)hSemaphore);
+  }
+  else {
+    count = (uint32_t)uxSemaphoreGetCount(hSemaphore);
+  }
+
+  return count;
+}
+
+osStatus_t osSemaphoreDelete (osSemaphoreId_t semaphore_id)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (semaphore_id == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    vSemaphoreDelete((SemaphoreHandle_t)semaphore_id);
+    stat = osOK;
+  }
+
+  return stat;
+}
+
+/*---------------------------------------------------------------------------*/
+/*  Memory Pool Management                                                   */
+/*---------------------------------------------------------------------------*/
+
+/* Blocks come off a free list, or off the never used end of the pool until it
+   has all been handed out once, so allocating and freeing are both O(1) and
+   creating a pool does not touch its memory.  A semaphore with an item size of
+   0 counts the free blocks, so osMemoryPoolAlloc can wait for one whether or
+   not configUSE_COUNTING_SEMAPHORES is set. */
+
+static void *allocBlock (MemPool_t *mp)
+{
+  MemPoolBlock_t *block;
+
+  block = mp->head;
+
+  if (block != NULL) {
+    mp->head = block->next;
+  }
+  else if (mp->unused < mp->mem_end) {
+    block = (MemPoolBlock_t *)mp->unused;
+    mp->unused += mp->bl_sz;
+  }
+
+  if (block != NULL) {
+    mp->n++;
+  }
+
+  return block;
+}
+
+static void freeBlock (MemPool_t *mp, void *block)
+{
+  ((MemPoolBlock_t *)block)->next = mp->head;
+  mp->head = (MemPoolBlock_t *)block;
+  mp->n--;
+}
+
+static void deletePool (MemPool_t *mp)
+{
+  if (mp->sem != NULL) {
+    vQueueDelete(mp->sem);
+    mp->sem = NULL;
+  }
+
+  #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    if ((mp->flags & MPOOL_DYNAMIC_MEM) != 0U) {
+      vPortFree(mp->mem_arr);
+    }
+    if ((mp->flags & MPOOL_DYNAMIC_CB) != 0U) {
+      vPortFree(mp);
+    }
+  #endif
+}
+
+osMemoryPoolId_t osMemoryPoolNew (uint32_t block_count, uint32_t block_size, const osMemoryPoolAttr_t *attr)
+{
+  MemPool_t *mp;
+  uint8_t *mem;
+  uint32_t sz;
+  uint32_t i;
+  int32_t mem_cb;
+  int32_t mem_mp;
+
+  mp = NULL;
+
+  if (!inHandlerMode() && (block_count > 0U) && (block_size > 0U)) {
+    sz = osMemoryPoolBlockSize(block_size);
+
+    if ((sz >= block_size) && (block_count <= (0xFFFFFFFFUL / sz))) {
+      mem_cb = 0;
+      mem_mp = 0;
+
+      if (attr != NULL) {
+        mem_cb = objectMemory(attr->cb_mem, attr->cb_size, sizeof(MemPool_t));
+        mem_mp = objectMemory(attr->mp_mem, attr->mp_size, block_count * sz);
+
+        /* The blocks hold a pointer while they are free. */
+        if ((((uintptr_t)attr->mp_mem) & (sizeof(void *) - 1U)) != 0U) {
+          mem_mp = -1;
+        }
+      }
+
+      if ((mem_cb == 1) && (mem_mp != -1)) {
+        mp = (MemPool_t *)attr->cb_mem;
+        mp->flags = 0U;
+      }
+      else if ((mem_cb == 0) && (mem_mp != -1)) {
+        #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+          mp = pvPortMalloc(sizeof(MemPool_t));
+          if (mp != NULL) {
+            mp->flags = MPOOL_DYNAMIC_CB;
+          }
+        #endif
+      }
+
+      if (mp != NULL) {
+        mp->sem = NULL;
+        mem = NULL;
+
+        if (mem_mp == 1) {
+          mem = (uint8_t *)attr->mp_mem;
+        }
+        else {
+          #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+            mem = pvPortMalloc(block_count * sz);
+            mp->flags |= MPOOL_DYNAMIC_MEM;
+          #endif
+        }
+
+        mp->mem_arr = mem;
+
+        if (mem != NULL) {
+          #if (configSUPPORT_STATIC_ALLOCATION == 1)
+            mp->sem = xQueueGenericCreateStatic(block_count, 0U, NULL, &mp->sem_cb, queueQUEUE_TYPE_COUNTING_SEMAPHORE);
+          #else
+            mp->sem = xQueueGenericCreate(block_count, 0U, queueQUEUE_TYPE_COUNTING_SEMAPHORE);
+          #endif
+        }
+
+        if (mp->sem != NULL) {
+          /* Every block starts out free. */
+          for (i = 0U; i < block_count; i++) {
+            (void)xSemaphoreGive(mp->sem);
+          }
+
+          mp->head    = NULL;
+          mp->unused  = mem;
+          mp->mem_end = mem + (block_count * sz);
+          mp->bl_sz   = sz;
+          mp->bl_cnt  = block_count;
+          mp->n       = 0U;
+          mp->name    = (attr != NULL) ? attr->name : NULL;
+        }
+        else {
+          if (mem == NULL) {
+            /* Nothing for deletePool to free. */
+            mp->flags &= ~MPOOL_DYNAMIC_MEM;
+          }
+          deletePool(mp);
+          mp = NULL;
+        }
+      }
+    }
+  }
+
+  return (osMemoryPoolId_t)mp;
+}
+
+const char *osMemoryPoolGetName (osMemoryPoolId_t mp_id)
+{
+  MemPool_t *mp = (MemPool_t *)mp_id;
+
+  return (inHandlerMode() || (mp == NULL)) ? NULL : mp->name;
+}
+
+void *osMemoryPoolAlloc (osMemoryPoolId_t mp_id, uint32_t timeout)
+{
+  MemPool_t *mp = (MemPool_t *)mp_id;
+  void *block;
+  UBaseType_t isrm;
+
+  block = NULL;
+
+  if (mp == NULL) {
+    /* Nothing to allocate from. */
+  }
+  else if (inHandlerMode()) {
+    if ((timeout == 0U) && (xSemaphoreTakeFromISR(mp->sem, NULL) == pdPASS)) {
+      isrm = taskENTER_CRITICAL_FROM_ISR();
+      block = allocBlock(mp);
+      taskEXIT_CRITICAL_FROM_ISR(isrm);
+    }
+  }
+  else if (xSemaphoreTake(mp->sem, makeTicks(timeout)) == pdPASS) {
+    /* The semaphore count guarantees a block is there. */
+    taskENTER_CRITICAL();
+    block = allocBlock(mp);
+    taskEXIT_CRITICAL();
+  }
+
+  return block;
+}
+
+/* Whether block is a block of mp that has been handed out at least once. */
+static int isPoolBlock (const MemPool_t *mp, const void *block)
+{
+  const uint8_t *p = (const uint8_t *)block;
+
+  return (p >= mp->mem_arr) && (p < mp->unused) &&
+         (((uint32_t)(p - mp->mem_arr) % mp->bl_sz) == 0U);
+}
+
+osStatus_t osMemoryPoolFree (osMemoryPoolId_t mp_id, void *block)
+{
+  MemPool_t *mp = (MemPool_t *)mp_id;
+  osStatus_t stat;
+  UBaseType_t isrm;
+  BaseType_t yield;
+
+  if ((mp == NULL) || !isPoolBlock(mp, block)) {
+    stat = osErrorParameter;
+  }
+  else if (inHandlerMode()) {
+    isrm = taskENTER_CRITICAL_FROM_ISR();
+    if (mp->n == 0U) {
+      stat = osErrorResource;
+    }
+    else {
+      freeBlock(mp, block);
+      stat = osOK;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(isrm);
+
+    if (stat == osOK) {
+      yield = pdFALSE;
+      (void)xSemaphoreGiveFromISR(mp->sem, &yield);
+      portYIELD_FROM_ISR(yield);
+    }
+  }
+  else {
+    taskENTER_CRITICAL();
+    if (mp->n == 0U) {
+      stat = osErrorResource;
+    }
+    else {
+      freeBlock(mp, block);
+      stat = osOK;
+    }
+    taskEXIT_CRITICAL();
+
+    if (stat == osOK) {
+      (void)xSemaphoreGive(mp->sem);
+    }
+  }
+
+  return stat;
+}
+
+uint32_t osMemoryPoolGetCapacity (osMemoryPoolId_t mp_id)
+{
+  MemPool_t *mp = (MemPool_t *)mp_id;
+
+  return (mp == NULL) ? 0U : mp->bl_cnt;
+}
+
+uint32_t osMemoryPoolGetBlockSize (osMemoryPoolId_t mp_id)
+{
+  MemPool_t *mp = (MemPool_t *)mp_id;
+
+  return (mp == NULL) ? 0U : mp->bl_sz;
+}
+
+uint32_t osMemoryPoolGetCount (osMemoryPoolId_t mp_id)
+{
+  MemPool_t *mp = (MemPool_t *)mp_id;
+
+  return (mp == NULL) ? 0U : mp->n;
+}
+
+uint32_t osMemoryPoolGetSpace (osMemoryPoolId_t mp_id)
+{
+  MemPool_t *mp = (MemPool_t *)mp_id;
+
+  return (mp == NULL) ? 0U : (mp->bl_cnt - mp->n);
+}
+
+osStatus_t osMemoryPoolDelete (osMemoryPoolId_t mp_id)
+{
+  MemPool_t *mp = (MemPool_t *)mp_id;
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (mp == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    deletePool(mp);
+    stat = osOK;
+  }
+
+  return stat;
+}
+
+/*---------------------------------------------------------------------------*/
+/*  Message Queue Management                                                 */
+/*---------------------------------------------------------------------------*/
+
+/* Messages are copied into and out of the queue storage; msg_prio is accepted
+   but not used, so messages are always received in the order they were put.
+   See the zero-copy message queue below for passing messages without copying
+   them. */
+osMessageQueueId_t osMessageQueueNew (uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr)
+{
+  QueueHandle_t hQueue;
+  int32_t mem;
+
+  hQueue = NULL;
+
+  if (!inHandlerMode() && (msg_count > 0U) && (msg_size > 0U)) {
+    mem = 0;
+
+    if (attr != NULL) {
+      mem = objectMemory(attr->cb_mem, attr->cb_size, sizeof(StaticQueue_t));
+
+      if ((mem == 1) && ((attr->mq_mem == NULL) || (attr->mq_size < osMessageQueueMemSize(msg_count, msg_size)))) {
+        mem = -1;
+      }
+      if ((mem == 0) && ((attr->mq_mem != NULL) || (attr->mq_size != 0U))) {
+        mem = -1;
+      }
+    }
+
+    if (mem == 1) {
+      #if (configSUPPORT_STATIC_ALLOCATION == 1)
+        hQueue = xQueueCreateStatic(msg_count, msg_size, (uint8_t *)attr->mq_mem, (StaticQueue_t *)attr->cb_mem);
+      #endif
+    }
+    else if (mem == 0) {
+      #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        hQueue = xQueueCreate(msg_count, msg_size);
+      #endif
+    }
+
+    #if (configQUEUE_REGISTRY_SIZE > 0)
+      if ((hQueue != NULL) && (attr != NULL) && (attr->name != NULL)) {
+        vQueueAddToRegistry(hQueue, attr->name);
+      }
+    #endif
+  }
+
+  return (osMessageQueueId_t)hQueue;
+}
+
+const char *osMessageQueueGetName (osMessageQueueId_t mq_id)
+{
+  const char *name = NULL;
+
+  if (!inHandlerMode() && (mq_id != NULL)) {
+#if (configQUEUE_REGISTRY_SIZE > 0)
+    name = pcQueueGetName((QueueHandle_t)mq_id);
+#endif
+  }
+
+  return name;
+}
+
+osStatus_t osMessageQueuePut (osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout)
+{
+  QueueHandle_t hQueue = (QueueHandle_t)mq_id;
+  osStatus_t stat;
+  BaseType_t yield;
+
+  (void)msg_prio;
+
+  if ((hQueue == NULL) || (msg_ptr == NULL)) {
+    stat = osErrorParameter;
+  }
+  else if (inHandlerMode()) {
+    if (timeout != 0U) {
+      stat = osErrorParameter;
+    }
+    else {
+      yield = pdFALSE;
+
+      if (xQueueSendToBackFromISR(hQueue, msg_ptr, &yield) == pdTRUE) {
+        stat = osOK;
+        portYIELD_FROM_ISR(yield);
+      }
+      else {
+        stat = osErrorResource;
+      }
+    }
+  }
+  else if (xQueueSendToBack(hQueue, msg_ptr, makeTicks(timeout)) == pdPASS) {
+    stat = osOK;
+  }
+  else {
+    stat = (timeout != 0U) ? osErrorTimeout : osErrorResource;
+  }
+
+  return stat;
+}
+
+osStatus_t osMessageQueueGet (osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout)
+{
+  QueueHandle_t hQueue = (QueueHandle_t)mq_id;
+  osStatus_t stat;
+  BaseType_t yield;
+
+  if (msg_prio != NULL) {
+    *msg_prio = 0U;
+  }
+
+  if ((hQueue == NULL) || (msg_ptr == NULL)) {
+    stat = osErrorParameter;
+  }
+  else if (inHandlerMode()) {
+    if (timeout != 0U) {
+      stat = osErrorParameter;
+    }
+    else {
+      yield = pdFALSE;
+
+      if (xQueueReceiveFromISR(hQueue, msg_ptr, &yield) == pdPASS) {
+        stat = osOK;
+        portYIELD_FROM_ISR(yield);
+      }
+      else {
+        stat = osErrorResource;
+      }
+    }
+  }
+  else if (xQueueReceive(hQueue, msg_ptr, makeTicks(timeout)) == pdPASS) {
+    stat = osOK;
+  }
+  else {
+    stat = (timeout != 0U) ? osErrorTimeout : osErrorResource;
+  }
+
+  return stat;
+}
+
+uint32_t osMessageQueueGetCapacity (osMessageQueueId_t mq_id)
+{
+  return (mq_id == NULL) ? 0U : (uint32_t)uxQueueGetQueueLength((QueueHandle_t)mq_id);
+}
+
+uint32_t osMessageQueueGetMsgSize (osMessageQueueId_t mq_id)
+{
+  return (mq_id == NULL) ? 0U : (uint32_t)uxQueueGetQueueItemSize((QueueHandle_t)mq_id);
+}
+
+uint32_t osMessageQueueGetCount (osMessageQueueId_t mq_id)
+{
+  QueueHandle_t hQueue = (QueueHandle_t)mq_id;
+  uint32_t count;
+
+  if (hQueue == NULL) {
+    count = 0U;
+  }
+  else if (inHandlerMode()) {
+    count = (uint32_t)uxQueueMessagesWaitingFromISR(hQueue);
+  }
+  else {
+    count = (uint32_t)uxQueueMessagesWaiting(hQueue);
+  }
+
+  return count;
+}
+
+uint32_t osMessageQueueGetSpace (osMessageQueueId_t mq_id)
+{
+  QueueHandle_t hQueue = (QueueHandle_t)mq_id;
+  uint32_t space;
+  UBaseType_t isrm;
+
+  if (hQueue == NULL) {
+    space = 0U;
+  }
+  else if (inHandlerMode()) {
+    isrm = taskENTER_CRITICAL_FROM_ISR();
+    space = (uint32_t)(uxQueueGetQueueLength(hQueue) - uxQueueMessagesWaitingFromISR(hQueue));
+    taskEXIT_CRITICAL_FROM_ISR(isrm);
+  }
+  else {
+    space = (uint32_t)uxQueueSpacesAvailable(hQueue);
+  }
+
+  return space;
+}
+
+osStatus_t osMessageQueueReset (osMessageQueueId_t mq_id)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (mq_id == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    (void)xQueueReset((QueueHandle_t)mq_id);
+    stat = osOK;
+  }
+
+  return stat;
+}
+
+osStatus_t osMessageQueueDelete (osMessageQueueId_t mq_id)
+{
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (mq_id == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    /* Also removes the queue from the queue registry. */
+    vQueueDelete((QueueHandle_t)mq_id);
+    stat = osOK;
+  }
+
+  return stat;
+}
+
+/*---------------------------------------------------------------------------*/
+/*  Zero-Copy Message Queue (extension, see freertos_os2.h)                  */
+/*---------------------------------------------------------------------------*/
+
+/* A memory pool of the message blocks and a FreeRTOS queue of pointers to the
+   blocks that have been put, with one entry for every block.  Both are made
+   by the v2 constructors, in the caller's memory when attr provides it: the
+   control block holds the pool and queue control blocks, and mq_mem the
+   blocks followed by the queue storage. */
+osMessageRefQueueId_t osMessageRefQueueNew (uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr)
+{
+  MessageRefQueue_t *mq;
+  osMemoryPoolAttr_t mp_attr;
+  osMessageQueueAttr_t q_attr;
+  uint32_t mp_size;
+  int32_t mem;
+
+  mq = NULL;
+
+  if (!inHandlerMode() && (msg_count > 0U) && (msg_size > 0U) &&
+      (msg_count <= (0xFFFFFFFFUL / (osMemoryPoolBlockSize(msg_size) + sizeof(void *))))) {
+    mp_size = osMemoryPoolMemSize(msg_count, msg_size);
+    mem = 0;
+
+    if (attr != NULL) {
+      mem = objectMemory(attr->cb_mem, attr->cb_size, sizeof(MessageRefQueue_t));
+
+      if ((mem == 1) && ((attr->mq_mem == NULL) || (attr->mq_size < osMessageRefQueueMemSize(msg_count, msg_size)))) {
+        mem = -1;
+      }
+      if ((mem == 0) && ((attr->mq_mem != NULL) || (attr->mq_size != 0U))) {
+        mem = -1;
+      }
+    }
+
+    if (mem == 1) {
+      mq = (MessageRefQueue_t *)attr->cb_mem;
+      mq->flags = 0U;
+    }
+    else if (mem == 0) {
+      #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        mq = pvPortMalloc(sizeof(MessageRefQueue_t));
+        if (mq != NULL) {
+          mq->flags = MPOOL_DYNAMIC_CB;
+        }
+      #endif
+    }
+
+    if (mq != NULL) {
+      (void)memset(&mp_attr, 0, sizeof(mp_attr));
+      (void)memset(&q_attr, 0, sizeof(q_attr));
+
+      mp_attr.name    = (attr != NULL) ? attr->name : NULL;
+      mp_attr.cb_mem  = &mq->pool;
+      mp_attr.cb_size = sizeof(mq->pool);
+      q_attr.name     = mp_attr.name;
+
+      if (mem == 1) {
+        mp_attr.mp_mem  = attr->mq_mem;
+        mp_attr.mp_size = mp_size;
+        q_attr.cb_mem   = &mq->queue_cb;
+        q_attr.cb_size  = sizeof(mq->queue_cb);
+        q_attr.mq_mem   = (uint8_t *)attr->mq_mem + mp_size;
+        q_attr.mq_size  = osMessageQueueMemSize(msg_count, sizeof(void *));
+      }
+
+      mq->queue = NULL;
+
+      if (osMemoryPoolNew(msg_count, msg_size, &mp_attr) != NULL) {
+        mq->queue = (QueueHandle_t)osMessageQueueNew(msg_count, sizeof(void *), &q_attr);
+
+        if (mq->queue == NULL) {
+          (void)osMemoryPoolDelete((osMemoryPoolId_t)&mq->pool);
+        }
+      }
+
+      if (mq->queue == NULL) {
+        #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+          if ((mq->flags & MPOOL_DYNAMIC_CB) != 0U) {
+            vPortFree(mq);
+          }
+        #endif
+        mq = NULL;
+      }
+    }
+  }
+
+  return (osMessageRefQueueId_t)mq;
+}
+
+void *osMessageQueueAllocBlock (osMessageRefQueueId_t mq_id, uint32_t timeout)
+{
+  MessageRefQueue_t *mq = (MessageRefQueue_t *)mq_id;
+
+  return (mq == NULL) ? NULL : osMemoryPoolAlloc((osMemoryPoolId_t)&mq->pool, timeout);
+}
+
+osStatus_t osMessageQueuePutRef (osMessageRefQueueId_t mq_id, void *block)
+{
+  MessageRefQueue_t *mq = (MessageRefQueue_t *)mq_id;
+  osStatus_t stat;
+
+  if ((mq == NULL) || !isPoolBlock(&mq->pool, block)) {
+    stat = osErrorParameter;
+  }
+  else {
+    /* Only the address is copied.  The queue has an entry for every block,
+       so it can only be full if a block is put twice. */
+    stat = osMessageQueuePut((osMessageQueueId_t)mq->queue, &block, 0U, 0U);
+  }
+
+  return stat;
+}
+
+osStatus_t osMessageQueueGetRef (osMessageRefQueueId_t mq_id, void **block, uint32_t timeout)
+{
+  MessageRefQueue_t *mq = (MessageRefQueue_t *)mq_id;
+  osStatus_t stat;
+
+  if ((mq == NULL) || (block == NULL)) {
+    stat = osErrorParameter;
+  }
+  else {
+    *block = NULL;
+    stat = osMessageQueueGet((osMessageQueueId_t)mq->queue, block, NULL, timeout);
+  }
+
+  return stat;
+}
+
+osStatus_t osMessageQueueFreeBlock (osMessageRefQueueId_t mq_id, void *block)
+{
+  MessageRefQueue_t *mq = (MessageRefQueue_t *)mq_id;
+
+  return (mq == NULL) ? osErrorParameter : osMemoryPoolFree((osMemoryPoolId_t)&mq->pool, block);
+}
+
+uint32_t osMessageRefQueueGetCount (osMessageRefQueueId_t mq_id)
+{
+  MessageRefQueue_t *mq = (MessageRefQueue_t *)mq_id;
+
+  return (mq == NULL) ? 0U : osMessageQueueGetCount((osMessageQueueId_t)mq->queue);
+}
+
+osStatus_t osMessageRefQueueDelete (osMessageRefQueueId_t mq_id)
+{
+  MessageRefQueue_t *mq = (MessageRefQueue_t *)mq_id;
+  osStatus_t stat;
+
+  if (inHandlerMode()) {
+    stat = osErrorISR;
+  }
+  else if (mq == NULL) {
+    stat = osErrorParameter;
+  }
+  else {
+    (void)osMessageQueueDelete((osMessageQueueId_t)mq->queue);
+    (void)osMemoryPoolDelete((osMemoryPoolId_t)&mq->pool);
+
+    #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+      if ((mq->flags & MPOOL_DYNAMIC_CB) != 0U) {
+        vPortFree(mq);
+      }
+    #endif
+    stat = osOK;
+  }
+
+  return stat;
+}
@@ -0,0 +1,813 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "jobs.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not configured
+to include the job executor.  This #if is closed at the very bottom of this
+file. */
+#if ( configUSE_JOB_EXECUTOR == 1 )
+
+#ifndef configJOB_EXECUTOR_TASK_NAME
+	#define configJOB_EXECUTOR_TASK_NAME "Jobs"
+#endif
+
+/* Jobs that are ready to run, one list per job priority.  Jobs of equal
+priority are run in turn by taking them from the head of the list and putting
+them back at the end. */
+PRIVILEGED_DATA static List_t pxReadyJobLists[ configMAX_JOB_PRIORITIES ];
+
+/* Jobs in jobDELAY(), jobDELAY_UNTIL() or a jobWAIT_NOTIFY() with a timeout,
+ordered by wake time.  As for delayed tasks, jobs that wake after the tick
+count overflows are kept in the second list, and the lists are swapped when
+the overflow is seen. */
+PRIVILEGED_DATA static List_t xDelayedJobList1;
+PRIVILEGED_DATA static List_t xDelayedJobList2;
+PRIVILEGED_DATA static List_t * pxDelayedJobList;
+PRIVILEGED_DATA static List_t * pxOverflowDelayedJobList;
+
+/* Jobs in jobWAIT_UNTIL() whose condition was false the last time it was
+evaluated. */
+PRIVILEGED_DATA static List_t xPollingJobList;
+
+/* Jobs started, or notified while waiting, from outside the executor task.
+Pushed from any context inside a critical section, and taken as a whole by the
+executor, so no list needs to be accessed from an interrupt. */
+PRIVILEGED_DATA static Job_t * volatile pxPendingJobs = NULL;
+
+/* The tick count when the delayed lists were last checked. */
+PRIVILEGED_DATA static TickType_t xJobLastTickCount = ( TickType_t ) 0U;
+
+PRIVILEGED_DATA static TaskHandle_t xJobExecutorTaskHandle = NULL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The executor task.  Runs one step of the highest priority ready job at a
+ * time, and blocks on its notification when no job is ready.
+ */
+static portTASK_FUNCTION_PROTO( prvJobExecutorTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the jobs on the pending list that have been started, or that have
+ * received the notification they are waiting for, to the ready lists.
+ */
+static void prvProcessPendingJobs( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the delayed jobs whose wake time has been reached to the ready lists.
+ */
+static void prvCheckDelayedJobs( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move every job in jobWAIT_UNTIL() to the ready lists so its condition is
+ * evaluated again.  Called when the executor is woken with no job ready, and
+ * whenever the tick count has changed.
+ */
+static void prvMovePollingJobsToReady( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Run one step of pxJob, then place it in the list its new state calls for.
+ */
+static void prvRunJob( Job_t *pxJob ) PRIVILEGED_FUNCTION;
+
+/*
+ * The time the executor can block for before a delayed job has to be woken.
+ */
+static TickType_t prvGetExecutorBlockTime( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place a job whose state has been set to jobSTATE_READY at the end of the
+ * ready list for its priority.
+ */
+static void prvAddJobToReadyList( Job_t *pxJob ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place a job in the delayed list that xWakeTime falls in.
+ */
+static void prvAddJobToDelayedList( Job_t *pxJob ) PRIVILEGED_FUNCTION;
+
+/*
+ * Wake a job whose delay or wait has ended.
+ */
+static void prvWakeDelayedJob( Job_t *pxJob ) PRIVILEGED_FUNCTION;
+
+/*
+ * Hand the notification value to the job.  Called from a critical section.
+ */
+static void prvReceiveNotification( Job_t *pxJob ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add a job to the pending list, if it is not already on it.  Called from a
+ * critical section.
+ */
+static void prvAddJobToPendingList( Job_t *pxJob ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xJobExecutorCreateTask( void )
+{
+BaseType_t xReturn = pdFAIL;
+
+	/* This function is called when the scheduler is started if
+	configUSE_JOB_EXECUTOR is set to 1.  Jobs started before then are held on
+	the pending list until the task first runs. */
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		PRIVILEGED_DATA static StaticTask_t xJobExecutorTaskTCB;
+		PRIVILEGED_DATA static StackType_t xJobExecutorTaskStack[ configJOB_EXECUTOR_STACK_DEPTH ];
+
+		xJobExecutorTaskHandle = xTaskCreateStatic(	prvJobExecutorTask,
+													configJOB_EXECUTOR_TASK_NAME,
+													configJOB_EXECUTOR_STACK_DEPTH,
+													NULL,
+													( ( UBaseType_t ) configJOB_EXECUTOR_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+													xJobExecutorTaskStack,
+													&xJobExecutorTaskTCB );
+
+		if( xJobExecutorTaskHandle != NULL )
+		{
+			xReturn = pdPASS;
+		}
+	}
+	#else
+	{
+		xReturn = xTaskCreate(	prvJobExecutorTask,
+								configJOB_EXECUTOR_TASK_NAME,
+								configJOB_EXECUTOR_STACK_DEPTH,
+								NULL,
+								( ( UBaseType_t ) configJOB_EXECUTOR_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+								&xJobExecutorTaskHandle );
+	}
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+	configASSERT( xReturn );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xJobExecutorGetTaskHandle( void )
+{
+	return xJobExecutorTaskHandle;
+}
+/*-----------------------------------------------------------*/
+
+void vJobInit( Job_t *pxJob, JobFunction_t pxJobFunction, void *pvParameter, UBaseType_t uxPriority )
+{
+	configASSERT( pxJob );
+	configASSERT( pxJobFunction );
+	configASSERT( uxPriority < ( UBaseType_t ) configMAX_JOB_PRIORITIES );
+
+	vListInitialiseItem( &( pxJob->xJobListItem ) );
+	listSET_LIST_ITEM_OWNER( &( pxJob->xJobListItem ), pxJob );
+	pxJob->pxJobFunction = pxJobFunction;
+	pxJob->pvParameter = pvParameter;
+	pxJob->pxNextPending = NULL;
+	pxJob->xWakeTime = ( TickType_t ) 0U;
+	pxJob->ulNotifiedValue = 0UL;
+	pxJob->ulReceivedValue = 0UL;
+	pxJob->usResumePoint = 0U;
+	pxJob->ucPriority = ( uint8_t ) uxPriority;
+	pxJob->ucState = jobSTATE_IDLE;
+	pxJob->ucPending = ( uint8_t ) pdFALSE;
+	pxJob->ucNotified = ( uint8_t ) pdFALSE;
+	pxJob->ucWaitForever = ( uint8_t ) pdFALSE;
+	pxJob->ucResult = ( uint8_t ) pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xJobStart( Job_t *pxJob )
+{
+BaseType_t xReturn;
+
+	configASSERT( pxJob );
+
+	taskENTER_CRITICAL();
+	{
+		if( pxJob->ucState == jobSTATE_IDLE )
+		{
+			pxJob->usResumePoint = 0U;
+			pxJob->ucState = jobSTATE_STARTING;
+			prvAddJobToPendingList( pxJob );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	/* Before the scheduler starts there is no task to notify, but the task
+	processes the pending list when it first runs. */
+	if( ( xReturn != pdFAIL ) && ( xJobExecutorTaskHandle != NULL ) )
+	{
+		( void ) xTaskNotifyGive( xJobExecutorTaskHandle );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xJobNotify( Job_t *pxJob, uint32_t ulBits )
+{
+	configASSERT( pxJob );
+
+	taskENTER_CRITICAL();
+	{
+		pxJob->ulNotifiedValue |= ulBits;
+		pxJob->ucNotified = ( uint8_t ) pdTRUE;
+
+		if( pxJob->ucState == jobSTATE_WAITING_NOTIFY )
+		{
+			prvAddJobToPendingList( pxJob );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xJobExecutorTaskHandle != NULL )
+	{
+		( void ) xTaskNotifyGive( xJobExecutorTaskHandle );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xJobNotifyFromISR( Job_t *pxJob, uint32_t ulBits, BaseType_t *pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxJob );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		pxJob->ulNotifiedValue |= ulBits;
+		pxJob->ucNotified = ( uint8_t ) pdTRUE;
+
+		if( pxJob->ucState == jobSTATE_WAITING_NOTIFY )
+		{
+			prvAddJobToPendingList( pxJob );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	if( xJobExecutorTaskHandle != NULL )
+	{
+		vTaskNotifyGiveFromISR( xJobExecutorTaskHandle, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vJobDelay( Job_t *pxJob, TickType_t xTicksToDelay )
+{
+	/* A delay of 0 leaves the job ready, so it goes to the back of its ready
+	list as if it had yielded. */
+	if( xTicksToDelay > ( TickType_t ) 0U )
+	{
+		pxJob->xWakeTime = xTaskGetTickCount() + xTicksToDelay;
+		pxJob->ucState = jobSTATE_DELAYED;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vJobDelayUntil( Job_t *pxJob, TickType_t *pxPreviousWakeTime, TickType_t xTimeIncrement )
+{
+TickType_t xTimeToWake;
+BaseType_t xShouldDelay = pdFALSE;
+const TickType_t xConstTickCount = xTaskGetTickCount();
+
+	configASSERT( pxPreviousWakeTime );
+	configASSERT( ( xTimeIncrement > 0U ) );
+
+	/* The same calculation as vTaskDelayUntil(). */
+	xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+
+	if( xConstTickCount < *pxPreviousWakeTime )
+	{
+		/* The tick count has overflowed since the function was last called,
+		so only delay if the wake time has also overflowed and is still in the
+		future. */
+		if( ( xTimeToWake < *pxPreviousWakeTime ) && ( xTimeToWake > xConstTickCount ) )
+		{
+			xShouldDelay = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		if( ( xTimeToWake < *pxPreviousWakeTime ) || ( xTimeToWake > xConstTickCount ) )
+		{
+			xShouldDelay = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	*pxPreviousWakeTime = xTimeToWake;
+
+	if( xShouldDelay != pdFALSE )
+	{
+		pxJob->xWakeTime = xTimeToWake;
+		pxJob->ucState = jobSTATE_DELAYED;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vJobWaitNotify( Job_t *pxJob, TickType_t xTicksToWait )
+{
+const TickType_t xConstTickCount = xTaskGetTickCount();
+
+	taskENTER_CRITICAL();
+	{
+		if( pxJob->ucNotified != pdFALSE )
+		{
+			/* Already notified, so the job stays ready and receives the value
+			when it next runs, after the other ready jobs of its priority. */
+			prvReceiveNotification( pxJob );
+		}
+		else
+		{
+			pxJob->ulReceivedValue = 0UL;
+			pxJob->ucResult = ( uint8_t ) pdFAIL;
+
+			if( xTicksToWait > ( TickType_t ) 0U )
+			{
+				pxJob->ucWaitForever = ( uint8_t ) ( ( xTicksToWait == portMAX_DELAY ) ? pdTRUE : pdFALSE );
+				pxJob->xWakeTime = xConstTickCount + xTicksToWait;
+				pxJob->ucState = jobSTATE_WAITING_NOTIFY;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vJobBeginPoll( Job_t *pxJob, TickType_t xTicksToWait )
+{
+	pxJob->ucWaitForever = ( uint8_t ) ( ( xTicksToWait == portMAX_DELAY ) ? pdTRUE : pdFALSE );
+	pxJob->xWakeTime = xTaskGetTickCount() + xTicksToWait;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xJobPollContinue( Job_t *pxJob )
+{
+BaseType_t xReturn;
+const TickType_t xElapsedSinceTimeout = xTaskGetTickCount() - pxJob->xWakeTime;
+
+	/* The timeout has passed once the tick count is at or after xWakeTime.
+	The unsigned difference is small when it has, and wraps to a value in the
+	top half of the tick range while it has not. */
+	if( ( pxJob->ucWaitForever != pdFALSE ) || ( xElapsedSinceTimeout > ( portMAX_DELAY >> 1 ) ) )
+	{
+		pxJob->ucState = jobSTATE_POLLING;
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvJobExecutorTask, pvParameters )
+{
+Job_t *pxJob;
+UBaseType_t uxPriority;
+TickType_t xPreviousTickCount;
+
+	/* Just to avoid compiler warnings. */
+	( void ) pvParameters;
+
+	for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_JOB_PRIORITIES; uxPriority++ )
+	{
+		vListInitialise( &( pxReadyJobLists[ uxPriority ] ) );
+	}
+
+	vListInitialise( &xDelayedJobList1 );
+	vListInitialise( &xDelayedJobList2 );
+	vListInitialise( &xPollingJobList );
+	pxDelayedJobList = &xDelayedJobList1;
+	pxOverflowDelayedJobList = &xDelayedJobList2;
+	xJobLastTickCount = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		/* Jobs made ready since the last step are considered before the next
+		one is chosen, so a higher priority job runs as soon as the current
+		step returns. */
+		prvProcessPendingJobs();
+
+		xPreviousTickCount = xJobLastTickCount;
+		prvCheckDelayedJobs();
+
+		/* Polling jobs are also given another chance each time the tick count
+		moves on, so a stream of lower priority ready jobs cannot keep the
+		executor from ever evaluating their conditions again. */
+		if( xJobLastTickCount != xPreviousTickCount )
+		{
+			prvMovePollingJobsToReady();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxJob = NULL;
+		uxPriority = ( UBaseType_t ) configMAX_JOB_PRIORITIES;
+
+		while( uxPriority > ( UBaseType_t ) 0U )
+		{
+			uxPriority--;
+
+			if( listLIST_IS_EMPTY( &( pxReadyJobLists[ uxPriority ] ) ) == pdFALSE )
+			{
+				pxJob = ( Job_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyJobLists[ uxPriority ] ) ); /*lint !e9087 Cast from list owner. */
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( pxJob != NULL )
+		{
+			prvRunJob( pxJob );
+		}
+		else
+		{
+			/* Nothing is ready.  Wait for a job to be started or notified, or
+			for the next delay to end, then give every polling job another
+			chance to find its condition true. */
+			( void ) ulTaskNotifyTake( pdTRUE, prvGetExecutorBlockTime() );
+			prvMovePollingJobsToReady();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunJob( Job_t *pxJob )
+{
+	( void ) uxListRemove( &( pxJob->xJobListItem ) );
+
+	pxJob->pxJobFunction( pxJob, pxJob->pvParameter );
+
+	switch( pxJob->ucState )
+	{
+		case jobSTATE_READY:
+			/* Yielded, or a wait that completed straight away. */
+			vListInsertEnd( &( pxReadyJobLists[ pxJob->ucPriority ] ), &( pxJob->xJobListItem ) );
+			break;
+
+		case jobSTATE_DELAYED:
+			prvAddJobToDelayedList( pxJob );
+			break;
+
+		case jobSTATE_WAITING_NOTIFY:
+			/* A wait without a timeout is in no list - only a notification
+			moves it on, through the pending list. */
+			if( pxJob->ucWaitForever == pdFALSE )
+			{
+				prvAddJobToDelayedList( pxJob );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			break;
+
+		case jobSTATE_POLLING:
+			vListInsertEnd( &xPollingJobList, &( pxJob->xJobListItem ) );
+			break;
+
+		default:
+			/* Reached jobEND(), so the job has finished. */
+			mtCOVERAGE_TEST_MARKER();
+			break;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessPendingJobs( void )
+{
+Job_t *pxJob, *pxNext;
+BaseType_t xMakeReady;
+
+	taskENTER_CRITICAL();
+	{
+		pxNext = pxPendingJobs;
+		pxPendingJobs = NULL;
+	}
+	taskEXIT_CRITICAL();
+
+	while( pxNext != NULL )
+	{
+		/* pxNextPending is read before ucPending is cleared, as the job can be
+		pushed again as soon as it is. */
+		pxJob = pxNext;
+		pxNext = pxJob->pxNextPending;
+
+		taskENTER_CRITICAL();
+		{
+			pxJob->ucPending = ( uint8_t ) pdFALSE;
+
+			if( pxJob->ucState == jobSTATE_STARTING )
+			{
+				pxJob->ucState = jobSTATE_READY;
+				xMakeReady = pdTRUE;
+			}
+			else if( ( pxJob->ucState == jobSTATE_WAITING_NOTIFY ) && ( pxJob->ucNotified != pdFALSE ) )
+			{
+				prvReceiveNotification( pxJob );
+				pxJob->ucState = jobSTATE_READY;
+				xMakeReady = pdTRUE;
+			}
+			else
+			{
+				/* Already woken by its timeout. */
+				xMakeReady = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xMakeReady != pdFALSE )
+		{
+			/* A waiting job with a timeout is in a delayed list. */
+			if( listLIST_ITEM_CONTAINER( &( pxJob->xJobListItem ) ) != NULL )
+			{
+				( void ) uxListRemove( &( pxJob->xJobListItem ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvAddJobToReadyList( pxJob );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckDelayedJobs( void )
+{
+const TickType_t xConstTickCount = xTaskGetTickCount();
+List_t *pxTemp;
+Job_t *pxJob;
+
+	if( xConstTickCount < xJobLastTickCount )
+	{
+		/* The tick count has overflowed since the last check, so every job
+		left in the current list was due before the overflow. */
+		while( listLIST_IS_EMPTY( pxDelayedJobList ) == pdFALSE )
+		{
+			pxJob = ( Job_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedJobList ); /*lint !e9087 Cast from list owner. */
+			( void ) uxListRemove( &( pxJob->xJobListItem ) );
+			prvWakeDelayedJob( pxJob );
+		}
+
+		pxTemp = pxDelayedJobList;
+		pxDelayedJobList = pxOverflowDelayedJobList;
+		pxOverflowDelayedJobList = pxTemp;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xJobLastTickCount = xConstTickCount;
+
+	while( listLIST_IS_EMPTY( pxDelayedJobList ) == pdFALSE )
+	{
+		pxJob = ( Job_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedJobList ); /*lint !e9087 Cast from list owner. */
+
+		if( listGET_LIST_ITEM_VALUE( &( pxJob->xJobListItem ) ) > xConstTickCount )
+		{
+			/* The list is in wake time order, so no later job is due. */
+			break;
+		}
+		else
+		{
+			( void ) uxListRemove( &( pxJob->xJobListItem ) );
+			prvWakeDelayedJob( pxJob );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMovePollingJobsToReady( void )
+{
+Job_t *pxJob;
+
+	while( listLIST_IS_EMPTY( &xPollingJobList ) == pdFALSE )
+	{
+		pxJob = ( Job_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xPollingJobList ); /*lint !e9087 Cast from list owner. */
+		( void ) uxListRemove( &( pxJob->xJobListItem ) );
+		pxJob->ucState = jobSTATE_READY;
+		prvAddJobToReadyList( pxJob );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvGetExecutorBlockTime( void )
+{
+TickType_t xBlockTime;
+
+	if( listLIST_IS_EMPTY( pxDelayedJobList ) == pdFALSE )
+	{
+		xBlockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedJobList ) - xJobLastTickCount;
+	}
+	else if( listLIST_IS_EMPTY( pxOverflowDelayedJobList ) == pdFALSE )
+	{
+		/* Wake when the tick count overflows, to swap the lists. */
+		xBlockTime = ( TickType_t ) 0U - xJobLastTickCount;
+	}
+	else
+	{
+		xBlockTime = portMAX_DELAY;
+	}
+
+	/* Polling jobs evaluate their conditions at least once a tick, which also
+	lets their timeouts expire. */
+	if( ( listLIST_IS_EMPTY( &xPollingJobList ) == pdFALSE ) && ( xBlockTime > ( TickType_t ) 1U ) )
+	{
+		xBlockTime = ( TickType_t ) 1U;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xBlockTime;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddJobToReadyList( Job_t *pxJob )
+{
+	vListInsertEnd( &( pxReadyJobLists[ pxJob->ucPriority ] ), &( pxJob->xJobListItem ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddJobToDelayedList( Job_t *pxJob )
+{
+	listSET_LIST_ITEM_VALUE( &( pxJob->xJobListItem ), pxJob->xWakeTime );
+
+	/* Wake times were calculated from a tick count at or after the last
+	check, so a wake time before it has overflowed. */
+	if( pxJob->xWakeTime < xJobLastTickCount )
+	{
+		vListInsert( pxOverflowDelayedJobList, &( pxJob->xJobListItem ) );
+	}
+	else
+	{
+		vListInsert( pxDelayedJobList, &( pxJob->xJobListItem ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeDelayedJob( Job_t *pxJob )
+{
+	taskENTER_CRITICAL();
+	{
+		if( pxJob->ucState == jobSTATE_WAITING_NOTIFY )
+		{
+			/* A notification that arrived after the pending list was processed
+			still counts, otherwise the wait has timed out.  The job's place on
+			the pending list, if any, is ignored once it is ready. */
+			if( pxJob->ucNotified != pdFALSE )
+			{
+				prvReceiveNotification( pxJob );
+			}
+			else
+			{
+				pxJob->ulReceivedValue = 0UL;
+				pxJob->ucResult = ( uint8_t ) pdFAIL;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxJob->ucState = jobSTATE_READY;
+	}
+	taskEXIT_CRITICAL();
+
+	prvAddJobToReadyList( pxJob );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiveNotification( Job_t *pxJob )
+{
+	pxJob->ulReceivedValue = pxJob->ulNotifiedValue;
+	pxJob->ulNotifiedValue = 0UL;
+	pxJob->ucNotified = ( uint8_t ) pdFALSE;
+	pxJob->ucResult = ( uint8_t ) pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddJobToPendingList( Job_t *pxJob )
+{
+	if( pxJob->ucPending == pdFALSE )
+	{
+		pxJob->ucPending = ( uint8_t ) pdTRUE;
+		pxJob->pxNextPending = pxPendingJobs;
+		pxPendingJobs = pxJob;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include the job executor.  This #if is closed at the very bottom of this
+file. */
+#endif /* configUSE_JOB_EXECUTOR == 1 */
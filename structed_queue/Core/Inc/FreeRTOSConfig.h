@@ -137,6 +137,11 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* The scheduler's data goes to the CCM-RAM, and so do the TCB and stack of
+   every task created with xTaskCreate(), from the heap in task_heap.c.  The
+   FreeRTOS heap stays in the main SRAM, as the DMA cannot reach the CCM-RAM. */
+#define configKERNEL_DATA_ATTRIBUTE              __attribute__((section(".ccmram")))
+#define configTASK_MEMORY_FROM_SEPARATE_HEAP     1
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
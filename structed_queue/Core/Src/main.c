@@ -32,6 +32,8 @@
 
 #include "stdio.h"
 #include "string.h"
+#include "task_stacks.h"
+#include "clock_profile.h"
 
 /* USER CODE END Includes */
 
@@ -146,9 +148,9 @@ int main(void)
 
 
   /******************************************CREATE TASK***************************************/
-  xTaskCreate(Sender1_Task, "Sender1", 128, NULL, 2, &Sender1_Task_Handler);
-  xTaskCreate(Sender2_Task, "Sender2", 128, NULL, 2, &Sender2_Task_Handler);
-  xTaskCreate(Receive_Task, "Receive", 128, NULL, 1, &Receiver_Task_Handler);
+  xTaskCreate(Sender1_Task, "Sender1", TASK_STACK_WORDS_Sender1_Task, NULL, 2, &Sender1_Task_Handler);
+  xTaskCreate(Sender2_Task, "Sender2", TASK_STACK_WORDS_Sender2_Task, NULL, 2, &Sender2_Task_Handler);
+  xTaskCreate(Receive_Task, "Receive", TASK_STACK_WORDS_Receive_Task, NULL, 1, &Receiver_Task_Handler);
 
   /******************************************Start the scheduler***************************************/
 vTaskStartScheduler();
@@ -367,6 +369,33 @@ void Receive_Task (void *argument)
 	}
 }
 
+/**
+  * @brief  Let the byte being sent on the UART finish before the bus clock
+  *         changes under it.
+  * @param  eProfile: Profile about to be switched to.
+  * @retval None
+  */
+void vClockProfileChangingHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartWaitIdle(&huart1);
+}
+
+/**
+  * @brief  Recompute the UART baud rate divider for the bus clock of the new
+  *         clock profile.  A task may be part way through
+  *         HAL_UART_Transmit(), so only BRR is rewritten.
+  * @param  eProfile: Profile now running.
+  * @retval None
+  */
+void vClockProfileChangedHook(ClockProfile_t eProfile)
+{
+  UNUSED(eProfile);
+
+  vClockProfileUartRetune(&huart1);
+}
+
 /* USER CODE END 4 */
 
 /* USER CODE BEGIN Header_StartDefaultTask */
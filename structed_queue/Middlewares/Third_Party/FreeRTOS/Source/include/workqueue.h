@@ -0,0 +1,183 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * The work queue defers processing from interrupts to a dedicated, high
+ * priority task.  Unlike xTimerPendFunctionCallFromISR() it does not share a
+ * queue with the timer commands, and posting a function from an interrupt only
+ * reserves a slot in a fixed size ring with an atomic compare-and-swap - no
+ * critical section is entered and nothing is copied through a kernel queue.
+ * Posting from a task reserves and fills the slot inside a short critical
+ * section, so the poster cannot be preempted while it holds a reserved but
+ * unpublished slot, which would stall the work queue task.  The work queue task
+ * runs every function that has been posted each time it is woken.
+ *
+ * configUSE_WORK_QUEUE must be set to 1 in FreeRTOSConfig.h for the work queue
+ * to be available.  The work queue task is created when the scheduler is
+ * started, at configWORK_QUEUE_TASK_PRIORITY.
+ */
+
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include workqueue.h"
+#endif
+
+/*lint -save -e537 This headers are only multiply included if the application code
+happens to also be including task.h. */
+#include "task.h"
+/*lint -restore */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Defines the prototype to which functions posted to the work queue must
+ * conform.
+ */
+typedef void (*WorkFunction_t)( void *pvParameter );
+
+/* Used with vWorkQueueGetStats().  Latencies are measured from the post to the
+start of the function, in run time counter units (core clock cycles when
+configUSE_DWT_RUN_TIME_COUNTER is set to 1), and are only recorded when
+configGENERATE_RUN_TIME_STATS is set to 1. */
+typedef struct xWORK_QUEUE_STATS
+{
+	uint32_t ulPosted;			/* The number of functions accepted by the work queue. */
+	uint32_t ulExecuted;		/* The number of functions the work queue task has run. */
+	uint32_t ulOverflows;		/* The number of functions rejected because the work queue was full. */
+	uint32_t ulMaxBatch;		/* The largest number of functions run in a single wake up of the work queue task. */
+	uint32_t ulLastLatency;		/* The latency of the function run most recently. */
+	uint32_t ulMaxLatency;		/* The largest latency of any function. */
+	uint64_t ullTotalLatency;	/* The sum of all latencies.  Divide by ulExecuted for the mean. */
+} WorkQueueStats_t;
+
+/**
+ * workqueue. h
+ * <pre>
+ BaseType_t xWorkQueuePostFromISR( WorkFunction_t pxFunction,
+                                   void *pvParameter,
+                                   BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Used from application interrupt service routines to defer the execution of
+ * a function to the work queue task.
+ *
+ * Functions are run in the order they were posted, and each wake up of the
+ * work queue task runs every function posted up to that point.  Posts from
+ * nested interrupts do not block each other.
+ *
+ * @param pxFunction The function to execute from the work queue task.
+ *
+ * @param pvParameter The value passed into pxFunction.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the function
+ * unblocked the work queue task and the work queue task has a priority higher
+ * than the currently running task.  If pdTRUE is returned a context switch
+ * should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if the function was posted, or pdFAIL if the work queue was
+ * full.
+ *
+ * Example usage:
+ * <pre>
+	// The callback function that will execute in the context of the work queue
+	// task.
+	void vProcessInterface( void *pvParameter )
+	{
+	BaseType_t xInterfaceToService = ( BaseType_t ) pvParameter;
+
+		// ...Perform the processing here...
+	}
+
+	// An ISR that receives data packets from multiple interfaces
+	void vAnISR( void )
+	{
+	BaseType_t xInterfaceToService, xHigherPriorityTaskWoken = pdFALSE;
+
+		// Query the hardware to determine which interface needs processing.
+		xInterfaceToService = prvCheckInterfaces();
+
+		xWorkQueuePostFromISR( vProcessInterface, ( void * ) xInterfaceToService, &xHigherPriorityTaskWoken );
+
+		portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+	}
+   </pre>
+ */
+BaseType_t xWorkQueuePostFromISR( WorkFunction_t pxFunction, void *pvParameter, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ * <pre>
+ BaseType_t xWorkQueuePost( WorkFunction_t pxFunction, void *pvParameter );
+ </pre>
+ *
+ * The task level version of xWorkQueuePostFromISR().  Never blocks, but
+ * reserves and publishes the slot inside a critical section.
+ *
+ * @return pdPASS if the function was posted, or pdFAIL if the work queue was
+ * full.
+ */
+BaseType_t xWorkQueuePost( WorkFunction_t pxFunction, void *pvParameter ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ * <pre>void vWorkQueueGetStats( WorkQueueStats_t *pxStats );</pre>
+ *
+ * Copies the work queue statistics into pxStats.
+ */
+void vWorkQueueGetStats( WorkQueueStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ * <pre>void vWorkQueueResetStats( void );</pre>
+ *
+ * Clears the work queue statistics.
+ */
+void vWorkQueueResetStats( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue. h
+ * <pre>TaskHandle_t xWorkQueueGetTaskHandle( void );</pre>
+ *
+ * Returns the handle of the work queue task, or NULL if the scheduler has not
+ * been started.
+ */
+TaskHandle_t xWorkQueueGetTaskHandle( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the kernel only.
+ */
+BaseType_t xWorkQueueCreateTask( void ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* WORK_QUEUE_H */
@@ -119,6 +119,11 @@ not necessary for to use this port.  They are defined so the common demo files
 #endif
 /*-----------------------------------------------------------*/
 
+/* Reprograms the tick interrupt for a new configCPU_CLOCK_HZ.  Call after
+changing the system clock and SystemCoreClock at run time. */
+extern void vPortRecalibrateTimerInterrupt( void );
+/*-----------------------------------------------------------*/
+
 /* Architecture specific optimisations. */
 #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
 	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
@@ -136,22 +141,120 @@ not necessary for to use this port.  They are defined so the common demo files
 	}
 
 	/* Check the configuration. */
-	#if( configMAX_PRIORITIES > 32 )
-		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#if( configMAX_PRIORITIES > 1024 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
 	#endif
 
-	/* Store/clear the ready priorities in a bit map. */
-	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
-	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+	#if( configMAX_PRIORITIES <= 32 )
+
+		/* Store/clear the ready priorities in a bit map. */
+		#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+		#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+		/*-----------------------------------------------------------*/
+
+		#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ) ) )
+
+	#else /* configMAX_PRIORITIES */
+
+		/* Above 32 priorities the ready priorities are held in a two level bit
+		map.  Bit n of ulPriorities[ g ] is set while priority ( g * 32 ) + n has
+		ready tasks, and bit g of ulGroups is set while any bit of
+		ulPriorities[ g ] is set, so the highest ready priority is still found
+		with two CLZ instructions.  Used by the kernel in place of the single
+		word uxTopReadyPriority. */
+		#define portREADY_PRIORITY_GROUPS ( ( configMAX_PRIORITIES + 31 ) / 32 )
+
+		typedef struct xPORT_READY_PRIORITIES
+		{
+			uint32_t ulGroups;
+			uint32_t ulPriorities[ portREADY_PRIORITY_GROUPS ];
+		} PortReadyPriorities_t;
 
-	/*-----------------------------------------------------------*/
+		#define portREADY_PRIORITIES_TYPE PortReadyPriorities_t
 
-	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ) ) )
+		/* Store/clear the ready priorities in the bit map.  Called with
+		interrupts masked, so the two words are updated together. */
+		#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )									\
+		{																									\
+			( uxReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5UL ] |= ( 1UL << ( ( uxPriority ) & 31UL ) );	\
+			( uxReadyPriorities ).ulGroups |= ( 1UL << ( ( uxPriority ) >> 5UL ) );						\
+		}
+
+		#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )									\
+		{																									\
+			( uxReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5UL ] &= ~( 1UL << ( ( uxPriority ) & 31UL ) );	\
+			if( ( uxReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5UL ] == 0UL )						\
+			{																								\
+				( uxReadyPriorities ).ulGroups &= ~( 1UL << ( ( uxPriority ) >> 5UL ) );					\
+			}																								\
+		}
+
+		/*-----------------------------------------------------------*/
+
+		#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )								\
+		{																									\
+		uint32_t ulTopGroup;																				\
+																											\
+			ulTopGroup = 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ).ulGroups );		\
+			uxTopPriority = ( ulTopGroup << 5UL ) + ( 31UL - ( uint32_t ) ucPortCountLeadingZeros( ( uxReadyPriorities ).ulPriorities[ ulTopGroup ] ) );	\
+		}
+
+		/* pdTRUE if a priority above the idle priority has ready tasks. */
+		#define portREADY_PRIORITY_ABOVE_IDLE( uxReadyPriorities ) ( ( ( ( uxReadyPriorities ).ulGroups > 1UL ) || ( ( uxReadyPriorities ).ulPriorities[ 0 ] > 1UL ) ) ? pdTRUE : pdFALSE )
+
+	#endif /* configMAX_PRIORITIES */
 
 #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /*-----------------------------------------------------------*/
 
+/* The DWT cycle counter, counting core clock cycles.  Used as the run time
+stats clock when configUSE_DWT_RUN_TIME_COUNTER is 1, and to timestamp the
+trace recorder. */
+#define portDWT_CTRL_REG				( * ( ( volatile uint32_t * ) 0xe0001000 ) )
+#define portDWT_CYCCNT_REG				( * ( ( volatile uint32_t * ) 0xe0001004 ) )
+#define portDCB_DEMCR_REG				( * ( ( volatile uint32_t * ) 0xe000edfc ) )
+#define portDWT_CYCCNTENA_BIT			( 1UL << 0UL )
+#define portDCB_DEMCR_TRCENA_BIT		( 1UL << 24UL )
+
+#define portENABLE_CYCLE_COUNTER()												\
+{																				\
+	portDCB_DEMCR_REG |= portDCB_DEMCR_TRCENA_BIT;								\
+	portDWT_CTRL_REG |= portDWT_CYCCNTENA_BIT;									\
+}
+
+#define portGET_CYCLE_COUNTER() portDWT_CYCCNT_REG
+
+/* Run time stats clocked from the DWT cycle counter, so no peripheral timer is
+needed.  The counter is 32 bits wide and wraps every 2^32 core clock cycles -
+the kernel accumulates differences between successive reads, so only the
+interval between two reads needs to be shorter than that. */
+#ifndef configUSE_DWT_RUN_TIME_COUNTER
+	#define configUSE_DWT_RUN_TIME_COUNTER 0
+#endif
+
+#if configUSE_DWT_RUN_TIME_COUNTER == 1
+
+	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()								\
+	{																				\
+		portENABLE_CYCLE_COUNTER();													\
+		portDWT_CYCCNT_REG = 0UL;													\
+	}
+
+	#define portGET_RUN_TIME_COUNTER_VALUE() portGET_CYCLE_COUNTER()
+
+#endif /* configUSE_DWT_RUN_TIME_COUNTER */
+
+/*-----------------------------------------------------------*/
+
+/* Used by the kernel when configUSE_TASK_FPU_FLAG is 1 to grant or withdraw
+access to the FPU as each task is switched in. */
+extern void vPortSetTaskFPUAccess( BaseType_t xTaskUsesFPU );
+#define portSET_TASK_FPU_ACCESS( xTaskUsesFPU ) vPortSetTaskFPUAccess( xTaskUsesFPU )
+
+/*-----------------------------------------------------------*/
+
 #ifdef configASSERT
 	void vPortValidateInterruptPriority( void );
 	#define portASSERT_IF_INTERRUPT_PRIORITY_INVALID() 	vPortValidateInterruptPriority()
@@ -188,6 +291,20 @@ BaseType_t xReturn;
 
 /*-----------------------------------------------------------*/
 
+/* Returns the number of the exception being handled, or 0 in thread mode. */
+portFORCE_INLINE static uint32_t ulPortGetInterruptNumber( void )
+{
+uint32_t ulCurrentInterrupt;
+
+	__asm volatile( "mrs %0, ipsr" : "=r"( ulCurrentInterrupt ) :: "memory" );
+
+	return ulCurrentInterrupt;
+}
+
+#define portGET_INTERRUPT_NUMBER() ulPortGetInterruptNumber()
+
+/*-----------------------------------------------------------*/
+
 portFORCE_INLINE static void vPortRaiseBASEPRI( void )
 {
 uint32_t ulNewBASEPRI;
@@ -233,6 +350,47 @@ portFORCE_INLINE static void vPortSetBASEPRI( uint32_t ulNewMaskValue )
 }
 /*-----------------------------------------------------------*/
 
+/* Atomically replace *pulDestination with ulNew if it still holds ulExpected.
+Exception entry and return clear the local exclusive monitor, so the store
+fails if the task is preempted between the load and the store. */
+portFORCE_INLINE static BaseType_t xPortCompareAndSwapU32( volatile uint32_t * pulDestination, uint32_t ulExpected, uint32_t ulNew )
+{
+uint32_t ulCurrent;
+uint32_t ulStoreFailed;
+BaseType_t xReturn;
+
+	__asm volatile( "dmb" ::: "memory" );
+
+	do
+	{
+		__asm volatile( "ldrex %0, [%1]" : "=r" ( ulCurrent ) : "r" ( pulDestination ) : "memory" );
+
+		if( ulCurrent != ulExpected )
+		{
+			__asm volatile( "clrex" ::: "memory" );
+			break;
+		}
+
+		__asm volatile( "strex %0, %2, [%1]" : "=&r" ( ulStoreFailed ) : "r" ( pulDestination ), "r" ( ulNew ) : "memory" );
+	} while( ulStoreFailed != 0UL );
+
+	if( ulCurrent == ulExpected )
+	{
+		__asm volatile( "dmb" ::: "memory" );
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+
+#define portCOMPARE_AND_SWAP_U32( pulDestination, ulExpected, ulNew ) xPortCompareAndSwapU32( ( pulDestination ), ( ulExpected ), ( ulNew ) )
+#define portCOMPARE_AND_SWAP_POINTER( ppvDestination, pvExpected, pvNew ) xPortCompareAndSwapU32( ( volatile uint32_t * ) ( ppvDestination ), ( uint32_t ) ( pvExpected ), ( uint32_t ) ( pvNew ) )
+/*-----------------------------------------------------------*/
+
 #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
 
 #ifdef __cplusplus
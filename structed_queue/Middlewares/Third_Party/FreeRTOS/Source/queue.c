@@ -81,6 +81,20 @@ zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME		 ( ( TickType_t ) 0U )
 
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+	/* When the fast path is used xMutexHolder doubles as the lock word.  Task
+	handles are word aligned, so the least significant bit is free to mark a
+	mutex that has tasks blocked on it - which forces the holder to give it back
+	through the slow path so the waiting task is unblocked.  A mutex is only
+	available while it has a count of one and no holder. */
+	#define queueMUTEX_CONTENDED_BIT	( ( portPOINTER_SIZE_TYPE ) 1 )
+	#define queueMUTEX_HOLDER( pxQueue )	( ( TaskHandle_t ) ( ( portPOINTER_SIZE_TYPE ) ( pxQueue )->u.xSemaphore.xMutexHolder & ~queueMUTEX_CONTENDED_BIT ) )
+	#define queueMUTEX_IS_HELD( pxQueue )	( ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX ) && ( ( pxQueue )->u.xSemaphore.xMutexHolder != NULL ) )
+#else
+	#define queueMUTEX_HOLDER( pxQueue )	( ( pxQueue )->u.xSemaphore.xMutexHolder )
+	#define queueMUTEX_IS_HELD( pxQueue )	( pdFALSE )
+#endif
+
 #if( configUSE_PREEMPTION == 0 )
 	/* If the cooperative scheduler is being used then a yield should not be
 	performed just because a higher priority task has been woken. */
@@ -128,6 +142,10 @@ typedef struct QueueDefinition 		/* The old naming convention is used to prevent
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+		UBaseType_t uxCeilingPriority;	/*< The priority a task holding the mutex runs at, or 0 if the mutex uses priority inheritance only. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -231,6 +249,16 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	 */
 	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+	/*
+	 * Attempt to take or give an uncontended mutex with a single atomic update
+	 * of the holder.  Both return pdFALSE if the caller must fall back to the
+	 * critical section based path.
+	 */
+	static BaseType_t prvMutexFastTake( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvMutexFastGive( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -457,6 +485,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+	{
+		pxNewQueue->uxCeilingPriority = ( UBaseType_t ) 0;
+	}
+	#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -527,6 +561,56 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority )
+	{
+	QueueHandle_t xNewQueue;
+
+		configASSERT( ( uxCeilingPriority > tskIDLE_PRIORITY ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+		xNewQueue = xQueueCreateMutex( queueQUEUE_TYPE_MUTEX );
+
+		if( xNewQueue != NULL )
+		{
+			( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xNewQueue;
+	}
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateMutexWithCeilingStatic( const UBaseType_t uxCeilingPriority, StaticQueue_t *pxStaticQueue )
+	{
+	QueueHandle_t xNewQueue;
+
+		configASSERT( ( uxCeilingPriority > tskIDLE_PRIORITY ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+		xNewQueue = xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, pxStaticQueue );
+
+		if( xNewQueue != NULL )
+		{
+			( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xNewQueue;
+	}
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
 	TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -543,7 +627,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 		{
 			if( pxSemaphore->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
-				pxReturn = pxSemaphore->u.xSemaphore.xMutexHolder;
+				pxReturn = queueMUTEX_HOLDER( pxSemaphore );
 			}
 			else
 			{
@@ -571,7 +655,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 		not required here. */
 		if( ( ( Queue_t * ) xSemaphore )->uxQueueType == queueQUEUE_IS_MUTEX )
 		{
-			pxReturn = ( ( Queue_t * ) xSemaphore )->u.xSemaphore.xMutexHolder;
+			pxReturn = queueMUTEX_HOLDER( ( Queue_t * ) xSemaphore );
 		}
 		else
 		{
@@ -599,7 +683,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 		this is the only condition we are interested in it does not matter if
 		pxMutexHolder is accessed simultaneously by another task.  Therefore no
 		mutual exclusion is required to test the pxMutexHolder variable. */
-		if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+		if( queueMUTEX_HOLDER( pxMutex ) == xTaskGetCurrentTaskHandle() )
 		{
 			traceGIVE_MUTEX_RECURSIVE( pxMutex );
 
@@ -653,7 +737,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 
 		traceTAKE_MUTEX_RECURSIVE( pxMutex );
 
-		if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+		if( queueMUTEX_HOLDER( pxMutex ) == xTaskGetCurrentTaskHandle() )
 		{
 			( pxMutex->u.xSemaphore.uxRecursiveCallCount )++;
 			xReturn = pdPASS;
@@ -752,6 +836,27 @@ Queue_t * const pxQueue = xQueue;
 	}
 	#endif
 
+	#if ( configUSE_MUTEX_FAST_PATH == 1 )
+	{
+		/* An uncontended mutex is given back without a critical section. */
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			if( prvMutexFastGive( pxQueue ) != pdFALSE )
+			{
+				return pdPASS;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_MUTEX_FAST_PATH */
+
 
 	/*lint -save -e904 This function relaxes the coding standard somewhat to
 	allow return statements within the function itself.  This is done in the
@@ -1439,6 +1544,27 @@ Queue_t * const pxQueue = xQueue;
 	}
 	#endif
 
+	#if ( configUSE_MUTEX_FAST_PATH == 1 )
+	{
+		/* An uncontended mutex is taken without a critical section. */
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			if( prvMutexFastTake( pxQueue ) != pdFALSE )
+			{
+				return pdPASS;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_MUTEX_FAST_PATH */
+
 
 	/*lint -save -e904 This function relaxes the coding standard somewhat to allow return
 	statements within the function itself.  This is done in the interest
@@ -1452,8 +1578,10 @@ Queue_t * const pxQueue = xQueue;
 			const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
 
 			/* Is there data in the queue now?  To be running the calling task
-			must be the highest priority task wanting to access the queue. */
-			if( uxSemaphoreCount > ( UBaseType_t ) 0 )
+			must be the highest priority task wanting to access the queue.  A
+			mutex taken through the fast path can have a holder before its
+			count is updated. */
+			if( ( uxSemaphoreCount > ( UBaseType_t ) 0 ) && ( queueMUTEX_IS_HELD( pxQueue ) == pdFALSE ) )
 			{
 				traceQUEUE_RECEIVE( pxQueue );
 
@@ -1468,6 +1596,38 @@ Queue_t * const pxQueue = xQueue;
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
 						pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+						/* Tasks still waiting for the mutex must be unblocked
+						when it is given back, so keep the holder off the fast
+						path. */
+						#if ( configUSE_MUTEX_FAST_PATH == 1 )
+						{
+							if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+							{
+								pxQueue->u.xSemaphore.xMutexHolder = ( TaskHandle_t ) ( ( portPOINTER_SIZE_TYPE ) pxQueue->u.xSemaphore.xMutexHolder | queueMUTEX_CONTENDED_BIT );
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_MUTEX_FAST_PATH */
+
+						/* A mutex with a ceiling raises its holder straight
+						away, so a task that could contend for it is never
+						scheduled while it is held. */
+						#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+						{
+							if( pxQueue->uxCeilingPriority != ( UBaseType_t ) 0 )
+							{
+								vTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority );
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_MUTEX_PRIORITY_CEILING */
 					}
 					else
 					{
@@ -1545,7 +1705,7 @@ Queue_t * const pxQueue = xQueue;
 			count is 0 then enter the Blocked state to wait for a semaphore to
 			become available.  As semaphores are implemented with queues the
 			queue being empty is equivalent to the semaphore count being 0. */
-			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			if( ( prvIsQueueEmpty( pxQueue ) != pdFALSE ) || ( queueMUTEX_IS_HELD( pxQueue ) != pdFALSE ) )
 			{
 				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
 
@@ -1555,7 +1715,25 @@ Queue_t * const pxQueue = xQueue;
 					{
 						taskENTER_CRITICAL();
 						{
-							xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+							/* Mark the mutex as contended so the holder gives
+							it back through the slow path and unblocks this
+							task.  The scheduler is suspended, so the holder
+							cannot run before this task is on the event
+							list. */
+							#if ( configUSE_MUTEX_FAST_PATH == 1 )
+							{
+								if( pxQueue->u.xSemaphore.xMutexHolder != NULL )
+								{
+									pxQueue->u.xSemaphore.xMutexHolder = ( TaskHandle_t ) ( ( portPOINTER_SIZE_TYPE ) pxQueue->u.xSemaphore.xMutexHolder | queueMUTEX_CONTENDED_BIT );
+								}
+								else
+								{
+									mtCOVERAGE_TEST_MARKER();
+								}
+							}
+							#endif /* configUSE_MUTEX_FAST_PATH */
+
+							xInheritanceOccurred = xTaskPriorityInherit( queueMUTEX_HOLDER( pxQueue ) );
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1595,7 +1773,7 @@ Queue_t * const pxQueue = xQueue;
 			expired.  Otherwise return to attempt to take the semaphore that is
 			known to be available.  As semaphores are implemented by queues the
 			queue being empty is equivalent to the semaphore count being 0. */
-			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			if( ( prvIsQueueEmpty( pxQueue ) != pdFALSE ) || ( queueMUTEX_IS_HELD( pxQueue ) != pdFALSE ) )
 			{
 				#if ( configUSE_MUTEXES == 1 )
 				{
@@ -1614,7 +1792,7 @@ Queue_t * const pxQueue = xQueue;
 							again, but only as low as the next highest priority
 							task that is waiting for the same mutex. */
 							uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
-							vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+							vTaskPriorityDisinheritAfterTimeout( queueMUTEX_HOLDER( pxQueue ), uxHighestWaitingPriority );
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1960,6 +2138,23 @@ Queue_t * const pxQueue = xQueue;
 } /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
 /*-----------------------------------------------------------*/
 
+UBaseType_t uxQueueGetQueueItemSize( const QueueHandle_t xQueue )
+{
+	configASSERT( xQueue );
+
+	/* Fixed when the queue is created, so no critical section is needed. */
+	return ( ( Queue_t * ) xQueue )->uxItemSize;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueGetQueueLength( const QueueHandle_t xQueue )
+{
+	configASSERT( xQueue );
+
+	return ( ( Queue_t * ) xQueue )->uxLength;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
 UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
 {
 UBaseType_t uxReturn;
@@ -2065,12 +2260,131 @@ Queue_t * const pxQueue = xQueue;
 			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
 		}
 
+		/* The holder of a mutex with a ceiling must not drop below the
+		ceiling while it holds the mutex. */
+		#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+		{
+			if( uxHighestPriorityOfWaitingTasks < pxQueue->uxCeilingPriority )
+			{
+				uxHighestPriorityOfWaitingTasks = pxQueue->uxCeilingPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+
 		return uxHighestPriorityOfWaitingTasks;
 	}
 
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+
+	static BaseType_t prvMutexFastTake( Queue_t * const pxQueue )
+	{
+	TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+	BaseType_t xReturn = pdFALSE;
+
+		/* A mutex with a ceiling has to raise its holder, and a mutex taken
+		before any task exists has no holder to record, so both are left to the
+		slow path.  The count is tested first so a held mutex does not cost an
+		exclusive access. */
+		#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+			if( pxQueue->uxCeilingPriority != ( UBaseType_t ) 0 )
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else
+		#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+		if( ( xCurrentTask != NULL ) && ( pxQueue->uxMessagesWaiting != ( UBaseType_t ) 0 ) )
+		{
+			if( portCOMPARE_AND_SWAP_POINTER( ( void * volatile * ) &( pxQueue->u.xSemaphore.xMutexHolder ), NULL, xCurrentTask ) != pdFALSE )
+			{
+				/* The holder now owns the count.  Any task that sees the
+				holder set before the count is cleared treats the mutex as
+				unavailable. */
+				traceQUEUE_RECEIVE( pxQueue );
+				pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0;
+				( void ) pvTaskIncrementMutexHeldCount();
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+
+	static BaseType_t prvMutexFastGive( Queue_t * const pxQueue )
+	{
+	TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+	BaseType_t xReturn = pdFALSE;
+
+		/* Only the holder can give the mutex, and only while no task has
+		marked it as contended.  A mutex that is a member of a queue set has to
+		notify the set, which only the slow path does. */
+		#if ( configUSE_QUEUE_SETS == 1 )
+			if( pxQueue->pxQueueSetContainer != NULL )
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else
+		#endif /* configUSE_QUEUE_SETS */
+		if( ( xCurrentTask != NULL ) && ( pxQueue->u.xSemaphore.xMutexHolder == xCurrentTask ) )
+		{
+			/* Restore the count before releasing the holder so the mutex never
+			appears free with a count of zero.  While the holder is still set
+			the count alone does not make the mutex available. */
+			pxQueue->uxMessagesWaiting = ( UBaseType_t ) 1;
+
+			if( portCOMPARE_AND_SWAP_POINTER( ( void * volatile * ) &( pxQueue->u.xSemaphore.xMutexHolder ), xCurrentTask, NULL ) != pdFALSE )
+			{
+				traceQUEUE_SEND( pxQueue );
+
+				if( xTaskDecrementMutexHeldCount() != pdFALSE )
+				{
+					/* Giving the mutex back dropped an inherited or ceiling
+					priority. */
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				/* A task blocked on the mutex since the holder was read. */
+				pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
 {
 BaseType_t xReturn = pdFALSE;
@@ -2087,7 +2401,7 @@ UBaseType_t uxMessagesWaiting;
 			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
 				/* The mutex is no longer being held. */
-				xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+				xReturn = xTaskPriorityDisinherit( queueMUTEX_HOLDER( pxQueue ) );
 				pxQueue->u.xSemaphore.xMutexHolder = NULL;
 			}
 			else
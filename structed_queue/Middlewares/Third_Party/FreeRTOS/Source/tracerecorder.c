@@ -0,0 +1,293 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not configured
+to include the trace recorder.  This #if is closed at the very bottom of this
+file. */
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/* "FRTR" read as a little endian word.  Lets the host tool find the recorder
+in a dump of the whole of RAM. */
+#define traceRECORDER_MAGIC		( ( uint32_t ) 0x52545246UL )
+
+/* Incremented whenever the layout of TraceRecorder_t or the event codes
+change, so the host tool can refuse dumps it does not understand. */
+#define traceRECORDER_VERSION	( ( uint16_t ) 2U )
+
+#define traceINDEX_MASK			( ( uint32_t ) configTRACE_RECORDER_EVENTS - 1UL )
+
+/* Values of ucKind in TraceObject_t. */
+#define traceOBJECT_UNUSED		( ( uint8_t ) 0U )
+#define traceOBJECT_TASK		( ( uint8_t ) 1U )
+#define traceOBJECT_QUEUE		( ( uint8_t ) 2U )
+
+/* One recorded event.  ucArgument depends on the event - see tracerecorder.h.
+usObject is the number the recorder gave the task or queue, 0 if there is
+none. */
+typedef struct xTRACE_EVENT
+{
+	uint32_t ulTimestamp;
+	uint8_t ucEvent;
+	uint8_t ucArgument;
+	uint16_t usObject;
+} TraceEvent_t;
+
+/* The name of a task or queue, indexed by its number.  ucDetail is the
+priority the task was created with, or the type of the queue. */
+typedef struct xTRACE_OBJECT
+{
+	uint8_t ucKind;
+	uint8_t ucDetail;
+	char cName[ configMAX_TASK_NAME_LEN ];
+} TraceObject_t;
+
+/* Everything the host tool needs is in this one structure, so dumping it is
+enough to decode the trace.  The header members give the sizes of the arrays
+and the rate of the timestamps - the rate when the dump was taken, with any
+earlier rate held in the traceEVENT_CLOCK_CHANGE events.  Events are written at ulEventsWritten, which
+runs freely and is masked into xEvents, so when it exceeds the size of the
+ring the oldest event is the one at ulEventsWritten. */
+typedef struct xTRACE_RECORDER
+{
+	uint32_t ulMagic;
+	uint16_t usVersion;
+	uint16_t usEventCount;
+	uint16_t usObjectCount;
+	uint16_t usNameLength;
+	uint32_t ulTimestampHz;
+	volatile uint32_t ulEventsWritten;
+	volatile uint32_t ulObjectsCreated;
+	TraceEvent_t xEvents[ configTRACE_RECORDER_EVENTS ];
+	TraceObject_t xObjects[ configTRACE_RECORDER_OBJECTS ];
+} TraceRecorder_t;
+
+/* Not static, so the debugger can find it by name. */
+PRIVILEGED_DATA TraceRecorder_t xTraceRecorder;
+
+PRIVILEGED_DATA static volatile BaseType_t xTraceRecording = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Give a newly created task or queue the next object number and record its
+ * kind.  Returns 0 if the recorder is stopped.
+ */
+static UBaseType_t prvTraceAllocateObject( uint8_t ucKind, uint8_t ucDetail ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStart( void )
+{
+	xTraceRecording = pdFALSE;
+
+	xTraceRecorder.usVersion = traceRECORDER_VERSION;
+	xTraceRecorder.usEventCount = ( uint16_t ) configTRACE_RECORDER_EVENTS;
+	xTraceRecorder.usObjectCount = ( uint16_t ) configTRACE_RECORDER_OBJECTS;
+	xTraceRecorder.usNameLength = ( uint16_t ) configMAX_TASK_NAME_LEN;
+	xTraceRecorder.ulTimestampHz = ( uint32_t ) configCPU_CLOCK_HZ;
+	xTraceRecorder.ulEventsWritten = 0UL;
+	xTraceRecorder.ulObjectsCreated = 0UL;
+
+	portENABLE_CYCLE_COUNTER();
+
+	/* Written last, so an earlier dump of a recorder that was never started
+	is not mistaken for a trace. */
+	xTraceRecorder.ulMagic = traceRECORDER_MAGIC;
+	xTraceRecording = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStop( void )
+{
+	xTraceRecording = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderClockChanged( void )
+{
+uint32_t ulPreviousKHz;
+
+	/* A stopped recorder keeps the rate its events were recorded at. */
+	if( xTraceRecording != pdFALSE )
+	{
+		ulPreviousKHz = xTraceRecorder.ulTimestampHz / 1000UL;
+		xTraceRecorder.ulTimestampHz = ( uint32_t ) configCPU_CLOCK_HZ;
+
+		vTraceRecordEvent( traceEVENT_CLOCK_CHANGE, ( UBaseType_t ) ( ulPreviousKHz >> 16UL ), ( UBaseType_t ) ( ulPreviousKHz & 0xffffUL ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecordEvent( uint8_t ucEvent, UBaseType_t uxArgument, UBaseType_t uxObject )
+{
+uint32_t ulIndex, ulTimestamp;
+TraceEvent_t *pxEvent;
+
+	if( xTraceRecording != pdFALSE )
+	{
+		/* Reserve the next position.  The timestamp is taken inside the loop,
+		so an interrupt that records an event between the read of the index
+		and the compare-and-swap makes the swap fail and both the index and
+		the timestamp are taken again - timestamps always increase through the
+		ring without a critical section. */
+		do
+		{
+			ulIndex = xTraceRecorder.ulEventsWritten;
+			ulTimestamp = portGET_CYCLE_COUNTER();
+		} while( portCOMPARE_AND_SWAP_U32( &( xTraceRecorder.ulEventsWritten ), ulIndex, ulIndex + 1UL ) == pdFALSE );
+
+		pxEvent = &( xTraceRecorder.xEvents[ ulIndex & traceINDEX_MASK ] );
+		pxEvent->ulTimestamp = ulTimestamp;
+		pxEvent->ucEvent = ucEvent;
+		pxEvent->ucArgument = ( uint8_t ) uxArgument;
+		pxEvent->usObject = ( uint16_t ) uxObject;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvTraceAllocateObject( uint8_t ucKind, uint8_t ucDetail )
+{
+uint32_t ulNumber;
+
+	if( xTraceRecording != pdFALSE )
+	{
+		do
+		{
+			ulNumber = xTraceRecorder.ulObjectsCreated;
+		} while( portCOMPARE_AND_SWAP_U32( &( xTraceRecorder.ulObjectsCreated ), ulNumber, ulNumber + 1UL ) == pdFALSE );
+
+		/* Numbers start at 1 so 0 can mean an object the recorder has not
+		numbered.  Objects beyond the end of the table are still numbered, but
+		have no name. */
+		ulNumber++;
+
+		if( ulNumber <= ( uint32_t ) configTRACE_RECORDER_OBJECTS )
+		{
+			xTraceRecorder.xObjects[ ulNumber - 1UL ].ucKind = ucKind;
+			xTraceRecorder.xObjects[ ulNumber - 1UL ].ucDetail = ucDetail;
+			xTraceRecorder.xObjects[ ulNumber - 1UL ].cName[ 0 ] = ( char ) 0x00;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		ulNumber = 0UL;
+	}
+
+	return ( UBaseType_t ) ulNumber;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecordTaskCreate( void *pxTCB, const char *pcName, UBaseType_t uxPriority )
+{
+UBaseType_t uxNumber;
+
+	/* The number is always written, as the TCB may not have been zeroed. */
+	uxNumber = prvTraceAllocateObject( traceOBJECT_TASK, ( uint8_t ) uxPriority );
+	vTaskSetTaskNumber( ( TaskHandle_t ) pxTCB, uxNumber );
+	vTraceRecordObjectName( uxNumber, pcName );
+	vTraceRecordEvent( traceEVENT_TASK_CREATE, uxPriority, uxNumber );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecordQueueCreate( void *pxQueue, uint8_t ucQueueType )
+{
+UBaseType_t uxNumber;
+
+	uxNumber = prvTraceAllocateObject( traceOBJECT_QUEUE, ucQueueType );
+	vQueueSetQueueNumber( ( QueueHandle_t ) pxQueue, uxNumber );
+	vTraceRecordEvent( traceEVENT_QUEUE_CREATE, ( UBaseType_t ) ucQueueType, uxNumber );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecordObjectName( UBaseType_t uxObject, const char *pcName )
+{
+TraceObject_t *pxObject;
+UBaseType_t x;
+
+	if( ( uxObject != 0U ) && ( uxObject <= ( UBaseType_t ) configTRACE_RECORDER_OBJECTS ) && ( pcName != NULL ) )
+	{
+		pxObject = &( xTraceRecorder.xObjects[ uxObject - 1U ] );
+
+		for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+		{
+			pxObject->cName[ x ] = pcName[ x ];
+
+			if( pcName[ x ] == ( char ) 0x00 )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* Names that fill the array are not terminated.  The host tool stops
+		at the end of the array. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include the trace recorder.  This #if is closed at the very bottom of this
+file. */
+#endif /* configUSE_TRACE_RECORDER == 1 */
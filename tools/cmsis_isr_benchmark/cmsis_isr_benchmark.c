@@ -0,0 +1,180 @@
+/*
+ * Target benchmark for the CMSIS-RTOS v1 interrupt entry points.
+ *
+ * Measures, in core clock cycles from the DWT cycle counter, what an interrupt
+ * handler pays for the common CMSIS calls made through the runtime dispatching
+ * functions (osMessagePut and so on, which read IPSR on every call) and
+ * through their osXxxFromISR counterparts:
+ *
+ *   message    - osMessagePut() of one message followed by osMessageGet().
+ *   semaphore  - osSemaphoreRelease() followed by osSemaphoreWait(0).
+ *   pool       - osPoolAlloc() followed by osPoolFree().
+ *   mail       - osMailAlloc(), osMailPut(), osMailGet() and osMailFree().
+ *
+ * No thread waits on the objects, so neither version switches context and the
+ * difference is the cost of the dispatch alone.
+ *
+ * vCmsisIsrBenchmark() runs the measurements from the handler of an interrupt
+ * the project does not use - EXTI0 unless benchIRQn and benchIRQHandler are
+ * defined otherwise - and leaves the average cycles per iteration in
+ * xCmsisIsrBenchmarkResults[].  See tools/README.md for how to run it.
+ */
+
+#include "main.h"
+#include "cmsis_os.h"
+
+#ifndef benchIRQn
+	#define benchIRQn			EXTI0_IRQn
+	#define benchIRQHandler		EXTI0_IRQHandler
+#endif
+
+#define benchITERATIONS			( 1000UL )
+
+typedef struct
+{
+	const char *pcName;
+	uint32_t ulDispatchCycles;	/* osXxx() called from the handler. */
+	uint32_t ulFromISRCycles;	/* osXxxFromISR() called from the handler. */
+} BenchResult_t;
+
+BenchResult_t xCmsisIsrBenchmarkResults[] =
+{
+	{ "message", 0, 0 },
+	{ "semaphore", 0, 0 },
+	{ "pool", 0, 0 },
+	{ "mail", 0, 0 }
+};
+
+osMessageQDef( xBenchMessageQ, 1, uint32_t );
+osSemaphoreDef( xBenchSemaphore );
+osPoolDef( xBenchPool, 1, uint32_t );
+osMailQDef( xBenchMailQ, 1, uint32_t );
+
+static osMessageQId xMessageQ;
+static osSemaphoreId xSemaphore;
+static osPoolId xPool;
+static osMailQId xMailQ;
+
+static volatile uint32_t ulBenchDone = 0;
+
+/*-----------------------------------------------------------*/
+
+static uint32_t prvCyclesPerIteration( uint32_t ulStart )
+{
+	return ( portGET_CYCLE_COUNTER() - ulStart ) / benchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchDispatch( void )
+{
+	uint32_t ulStart, i;
+	void *pvBlock;
+
+	ulStart = portGET_CYCLE_COUNTER();
+	for( i = 0; i < benchITERATIONS; i++ )
+	{
+		osMessagePut( xMessageQ, i, 0 );
+		osMessageGet( xMessageQ, 0 );
+	}
+	xCmsisIsrBenchmarkResults[ 0 ].ulDispatchCycles = prvCyclesPerIteration( ulStart );
+
+	ulStart = portGET_CYCLE_COUNTER();
+	for( i = 0; i < benchITERATIONS; i++ )
+	{
+		osSemaphoreRelease( xSemaphore );
+		osSemaphoreWait( xSemaphore, 0 );
+	}
+	xCmsisIsrBenchmarkResults[ 1 ].ulDispatchCycles = prvCyclesPerIteration( ulStart );
+
+	ulStart = portGET_CYCLE_COUNTER();
+	for( i = 0; i < benchITERATIONS; i++ )
+	{
+		pvBlock = osPoolAlloc( xPool );
+		osPoolFree( xPool, pvBlock );
+	}
+	xCmsisIsrBenchmarkResults[ 2 ].ulDispatchCycles = prvCyclesPerIteration( ulStart );
+
+	ulStart = portGET_CYCLE_COUNTER();
+	for( i = 0; i < benchITERATIONS; i++ )
+	{
+		pvBlock = osMailAlloc( xMailQ, 0 );
+		osMailPut( xMailQ, pvBlock );
+		osMailFree( xMailQ, osMailGet( xMailQ, 0 ).value.p );
+	}
+	xCmsisIsrBenchmarkResults[ 3 ].ulDispatchCycles = prvCyclesPerIteration( ulStart );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchFromISR( void )
+{
+	uint32_t ulStart, i;
+	void *pvBlock;
+
+	ulStart = portGET_CYCLE_COUNTER();
+	for( i = 0; i < benchITERATIONS; i++ )
+	{
+		osMessagePutFromISR( xMessageQ, i );
+		osMessageGetFromISR( xMessageQ );
+	}
+	xCmsisIsrBenchmarkResults[ 0 ].ulFromISRCycles = prvCyclesPerIteration( ulStart );
+
+	ulStart = portGET_CYCLE_COUNTER();
+	for( i = 0; i < benchITERATIONS; i++ )
+	{
+		osSemaphoreReleaseFromISR( xSemaphore );
+		osSemaphoreWaitFromISR( xSemaphore );
+	}
+	xCmsisIsrBenchmarkResults[ 1 ].ulFromISRCycles = prvCyclesPerIteration( ulStart );
+
+	ulStart = portGET_CYCLE_COUNTER();
+	for( i = 0; i < benchITERATIONS; i++ )
+	{
+		pvBlock = osPoolAllocFromISR( xPool );
+		osPoolFree( xPool, pvBlock );
+	}
+	xCmsisIsrBenchmarkResults[ 2 ].ulFromISRCycles = prvCyclesPerIteration( ulStart );
+
+	ulStart = portGET_CYCLE_COUNTER();
+	for( i = 0; i < benchITERATIONS; i++ )
+	{
+		pvBlock = osMailAllocFromISR( xMailQ );
+		osMailPutFromISR( xMailQ, pvBlock );
+		osMailFreeFromISR( xMailQ, osMailGetFromISR( xMailQ ).value.p );
+	}
+	xCmsisIsrBenchmarkResults[ 3 ].ulFromISRCycles = prvCyclesPerIteration( ulStart );
+}
+/*-----------------------------------------------------------*/
+
+void benchIRQHandler( void )
+{
+	prvBenchDispatch();
+	prvBenchFromISR();
+	ulBenchDone = 1;
+}
+/*-----------------------------------------------------------*/
+
+void vCmsisIsrBenchmark( void )
+{
+	xMessageQ = osMessageCreate( osMessageQ( xBenchMessageQ ), NULL );
+	xSemaphore = osSemaphoreCreate( osSemaphore( xBenchSemaphore ), 1 );
+	xPool = osPoolCreate( osPool( xBenchPool ) );
+	xMailQ = osMailCreate( osMailQ( xBenchMailQ ), NULL );
+	configASSERT( xMessageQ && xSemaphore && xPool && xMailQ );
+
+	/* Start with the semaphore taken, so each release has a token to give. */
+	osSemaphoreWait( xSemaphore, 0 );
+
+	portENABLE_CYCLE_COUNTER();
+
+	/* The highest priority from which FreeRTOS API calls are allowed. */
+	NVIC_SetPriority( benchIRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY );
+	NVIC_EnableIRQ( benchIRQn );
+	NVIC_SetPendingIRQ( benchIRQn );
+
+	while( ulBenchDone == 0 )
+	{
+		osDelay( 1 );
+	}
+
+	NVIC_DisableIRQ( benchIRQn );
+}
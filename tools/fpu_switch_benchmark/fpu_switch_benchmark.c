@@ -0,0 +1,177 @@
+/*
+ * Target benchmark for configUSE_TASK_FPU_FLAG on the Cortex-M4F port.
+ *
+ * Measures, in core clock cycles from the DWT cycle counter, the cost of a
+ * context switch between two tasks that use the FPU and between two tasks
+ * that only use the integer registers.  Each pair ping-pongs with direct to
+ * task notifications, so every hand over is one switch:
+ *
+ *   fpu      - both tasks do a floating point multiply-add between switches.
+ *   integer  - both tasks do the same work in integer arithmetic.
+ *
+ * The figure per switch includes the xTaskNotifyGive() and ulTaskNotifyTake()
+ * calls that cause it, which are the same in every configuration, so build
+ * the project once with configUSE_TASK_FPU_FLAG set to 0 and once with it set
+ * to 1 and compare the two runs.  With the flag set the FPU tasks mark
+ * themselves with vTaskUseFPU() before their first floating point
+ * instruction.
+ *
+ * The task calling vFpuSwitchBenchmark() must have a priority below
+ * configMAX_PRIORITIES - 1, as the two tasks run one above it.  The average
+ * cycles per switch are left in xFpuSwitchBenchmarkResults[].  See
+ * tools/README.md for how to run it.
+ */
+
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchITERATIONS			( 1000UL )
+#define benchSTACK_SIZE			( configMINIMAL_STACK_SIZE * 2 )
+
+typedef struct
+{
+	const char *pcName;
+	uint32_t ulFPUFlag;			/* configUSE_TASK_FPU_FLAG of the build. */
+	uint32_t ulCyclesPerSwitch;
+} BenchResult_t;
+
+BenchResult_t xFpuSwitchBenchmarkResults[] =
+{
+	{ "fpu", configUSE_TASK_FPU_FLAG, 0 },
+	{ "integer", configUSE_TASK_FPU_FLAG, 0 }
+};
+
+typedef struct
+{
+	TaskHandle_t xPartner;
+	BaseType_t xUsesFPU;
+	BenchResult_t *pxResult;	/* NULL for the task that only answers. */
+} BenchTaskParams_t;
+
+static TaskHandle_t xController;
+
+/* Written so the compiler cannot drop the work done between switches. */
+static volatile float fFloatSink;
+static volatile uint32_t ulIntegerSink;
+
+/*-----------------------------------------------------------*/
+
+static void prvWork( BaseType_t xUsesFPU, uint32_t ulIteration )
+{
+	if( xUsesFPU != pdFALSE )
+	{
+		fFloatSink = ( fFloatSink * 1.0001f ) + ( float ) ulIteration;
+	}
+	else
+	{
+		ulIntegerSink = ( ulIntegerSink * 3UL ) + ulIteration;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPingTask( void *pvParameters )
+{
+	BenchTaskParams_t *pxParams = ( BenchTaskParams_t * ) pvParameters;
+	uint32_t ulStart, i;
+
+	#if( configUSE_TASK_FPU_FLAG == 1 )
+	{
+		if( pxParams->xUsesFPU != pdFALSE )
+		{
+			vTaskUseFPU( NULL );
+		}
+	}
+	#endif
+
+	/* Let the partner reach its first ulTaskNotifyTake(), and give both tasks
+	their floating point context if they use one, before timing starts. */
+	prvWork( pxParams->xUsesFPU, 0 );
+	taskYIELD();
+
+	ulStart = portGET_CYCLE_COUNTER();
+	for( i = 0; i < benchITERATIONS; i++ )
+	{
+		xTaskNotifyGive( pxParams->xPartner );
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		prvWork( pxParams->xUsesFPU, i );
+	}
+
+	/* Each iteration switches to the partner and back. */
+	pxParams->pxResult->ulCyclesPerSwitch = ( portGET_CYCLE_COUNTER() - ulStart ) / ( 2UL * benchITERATIONS );
+
+	xTaskNotifyGive( xController );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPongTask( void *pvParameters )
+{
+	BenchTaskParams_t *pxParams = ( BenchTaskParams_t * ) pvParameters;
+	uint32_t i;
+
+	#if( configUSE_TASK_FPU_FLAG == 1 )
+	{
+		if( pxParams->xUsesFPU != pdFALSE )
+		{
+			vTaskUseFPU( NULL );
+		}
+	}
+	#endif
+
+	prvWork( pxParams->xUsesFPU, 0 );
+
+	for( i = 0; i < benchITERATIONS; i++ )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		prvWork( pxParams->xUsesFPU, i );
+		xTaskNotifyGive( pxParams->xPartner );
+	}
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunPair( BaseType_t xUsesFPU, BenchResult_t *pxResult )
+{
+	static BenchTaskParams_t xPingParams, xPongParams;
+	TaskHandle_t xPing, xPong;
+	UBaseType_t uxPriority = uxTaskPriorityGet( NULL ) + 1;
+	BaseType_t xCreated;
+
+	configASSERT( uxPriority < configMAX_PRIORITIES );
+
+	xPingParams.xUsesFPU = xUsesFPU;
+	xPingParams.pxResult = pxResult;
+	xPongParams.xUsesFPU = xUsesFPU;
+	xPongParams.pxResult = NULL;
+
+	/* Created with the scheduler suspended, so neither runs before both
+	handles are known. */
+	vTaskSuspendAll();
+	{
+		xCreated = xTaskCreate( prvPingTask, "Ping", benchSTACK_SIZE, &xPingParams, uxPriority, &xPing );
+		xCreated &= xTaskCreate( prvPongTask, "Pong", benchSTACK_SIZE, &xPongParams, uxPriority, &xPong );
+		configASSERT( xCreated == pdPASS );
+
+		xPingParams.xPartner = xPong;
+		xPongParams.xPartner = xPing;
+	}
+	( void ) xTaskResumeAll();
+
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+	/* Give the idle task the chance to free the two tasks. */
+	vTaskDelay( 1 );
+}
+/*-----------------------------------------------------------*/
+
+void vFpuSwitchBenchmark( void )
+{
+	xController = xTaskGetCurrentTaskHandle();
+
+	portENABLE_CYCLE_COUNTER();
+
+	prvRunPair( pdTRUE, &xFpuSwitchBenchmarkResults[ 0 ] );
+	prvRunPair( pdFALSE, &xFpuSwitchBenchmarkResults[ 1 ] );
+}
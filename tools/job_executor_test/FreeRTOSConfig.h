@@ -0,0 +1,32 @@
+/*
+ * Host configuration used by job_executor_test.c.  Only the job executor is
+ * compiled, so the settings that matter are the job ones.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <assert.h>
+
+#define configUSE_PREEMPTION                     1
+#define configSUPPORT_STATIC_ALLOCATION          0
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configUSE_IDLE_HOOK                      0
+#define configUSE_TICK_HOOK                      0
+#define configCPU_CLOCK_HZ                       ( 180000000UL )
+#define configTICK_RATE_HZ                       ( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES                     ( 7 )
+#define configMINIMAL_STACK_SIZE                 ( ( uint16_t ) 128 )
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_16_BIT_TICKS                   0
+#define configUSE_MUTEXES                        1
+#define configQUEUE_REGISTRY_SIZE                0
+
+#define configUSE_JOB_EXECUTOR                   1
+#define configMAX_JOB_PRIORITIES                 4
+
+#define INCLUDE_xTaskGetSchedulerState           1
+
+#define configASSERT( x )                        assert( x )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,271 @@
+/*
+ * Host test for the job executor's polling jobs.
+ *
+ * Builds the kernel's jobs.c and list.c for the host, with the task functions
+ * the executor calls replaced by the single threaded stand-ins below, and
+ * runs the executor loop with:
+ *
+ *   - a stream of low priority jobs that are always ready, each yielding after
+ *     a slice of work.  Time only passes while they run, as it would on the
+ *     target with the executor busy.
+ *   - a high priority consumer in jobWAIT_UNTIL(), waiting for items the test
+ *     produces every few ticks, as jobQUEUE_RECEIVE() would.
+ *   - a middle priority job in jobWAIT_UNTIL() on a condition that is never
+ *     true, which must time out.
+ *
+ * The ready stream never lets the executor go idle, so the polling jobs are
+ * only evaluated again because the tick count moved on.  The test checks that
+ * every item is consumed within a tick of being produced and that every wait
+ * times out within a tick of its timeout.  Build and run it from the
+ * directory holding this file, without strict aliasing as list.c accesses
+ * the end marker of a list through a full list item pointer:
+ *
+ *     K=../../mutex2/Middlewares/Third_Party/FreeRTOS/Source
+ *     gcc -O2 -fno-strict-aliasing -I. -I$K -I$K/include job_executor_test.c -o job_executor_test
+ *     ./job_executor_test
+ *
+ * It exits with 0 if every check passes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <setjmp.h>
+
+/* The kernel sources are compiled into this file so the test can run the
+executor task's function directly. */
+#include "list.c"
+#include "jobs.c"
+
+#define testRUN_TICKS			( ( TickType_t ) 2000 )
+#define testSTEPS_PER_TICK		( 10UL )
+#define testREADY_JOBS			( 4 )
+#define testPRODUCE_PERIOD		( ( TickType_t ) 7 )
+#define testPOLL_TIMEOUT		( ( TickType_t ) 20 )
+#define testNEVER_TIMEOUT		( ( TickType_t ) 10 )
+
+#define testCONSUMER_PRIORITY	( 3 )
+#define testNEVER_PRIORITY		( 2 )
+#define testSTREAM_PRIORITY		( 0 )
+
+/*-----------------------------------------------------------*/
+
+/* Stand-ins for the kernel functions called by jobs.c. */
+
+static TickType_t xTickCount = 0;
+static unsigned long ulSteps = 0;
+static jmp_buf xRunEnd;
+
+/* Produced by the tick, consumed by the high priority job. */
+static unsigned long ulProduced = 0, ulConsumed = 0;
+static TickType_t xProducedAt = 0;
+
+static TickType_t xMaxConsumeLatency = 0;
+static unsigned long ulConsumerTimeouts = 0;
+
+static unsigned long ulNeverTimeouts = 0;
+static TickType_t xMaxNeverOverrun = 0;
+static BaseType_t xNeverEarly = pdFALSE;
+
+static void prvTick( void )
+{
+	xTickCount++;
+
+	if( ( ( xTickCount % testPRODUCE_PERIOD ) == 0 ) && ( ulProduced == ulConsumed ) )
+	{
+		ulProduced++;
+		xProducedAt = xTickCount;
+	}
+
+	if( xTickCount == testRUN_TICKS )
+	{
+		longjmp( xRunEnd, 1 );
+	}
+}
+
+TickType_t xTaskGetTickCount( void )
+{
+	return xTickCount;
+}
+
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+{
+	( void ) uxIndexToWaitOn;
+	( void ) xClearCountOnExit;
+
+	/* Only reached if no job is ready, which the stream prevents, but sleep
+	out the block time as the executor would. */
+	do
+	{
+		prvTick();
+	} while( --xTicksToWait > ( TickType_t ) 0U );
+
+	return 0UL;
+}
+
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+{
+	( void ) xTaskToNotify;
+	( void ) uxIndexToNotify;
+	( void ) ulValue;
+	( void ) eAction;
+	( void ) pulPreviousNotificationValue;
+
+	return pdPASS;
+}
+
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	( void ) xTaskToNotify;
+	( void ) uxIndexToNotify;
+	( void ) pxHigherPriorityTaskWoken;
+}
+
+BaseType_t xTaskCreate( TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask )
+{
+	( void ) pxTaskCode;
+	( void ) pcName;
+	( void ) usStackDepth;
+	( void ) pvParameters;
+	( void ) uxPriority;
+	( void ) pxCreatedTask;
+
+	/* The test is the executor task. */
+	return pdPASS;
+}
+
+/*-----------------------------------------------------------*/
+
+/* A job of the ready stream.  Each step is a slice of work, and every
+testSTEPS_PER_TICK slices across all of them take a tick. */
+static void prvStreamJob( Job_t *pxJob, void *pvParameter )
+{
+	( void ) pvParameter;
+
+	jobBEGIN( pxJob );
+
+	for( ;; )
+	{
+		if( ( ++ulSteps % testSTEPS_PER_TICK ) == 0UL )
+		{
+			prvTick();
+		}
+
+		jobYIELD( pxJob );
+	}
+
+	jobEND( pxJob );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerJob( Job_t *pxJob, void *pvParameter )
+{
+static BaseType_t xResult;
+TickType_t xLatency;
+
+	( void ) pvParameter;
+
+	jobBEGIN( pxJob );
+
+	for( ;; )
+	{
+		jobWAIT_UNTIL( pxJob, ( ulProduced != ulConsumed ), testPOLL_TIMEOUT, &xResult );
+
+		if( xResult == pdPASS )
+		{
+			xLatency = xTickCount - xProducedAt;
+			if( xLatency > xMaxConsumeLatency )
+			{
+				xMaxConsumeLatency = xLatency;
+			}
+			ulConsumed++;
+		}
+		else
+		{
+			ulConsumerTimeouts++;
+		}
+	}
+
+	jobEND( pxJob );
+}
+/*-----------------------------------------------------------*/
+
+static void prvNeverJob( Job_t *pxJob, void *pvParameter )
+{
+static BaseType_t xResult;
+static TickType_t xStart;
+TickType_t xWaited;
+
+	( void ) pvParameter;
+
+	jobBEGIN( pxJob );
+
+	for( ;; )
+	{
+		xStart = xTickCount;
+		jobWAIT_UNTIL( pxJob, pdFALSE, testNEVER_TIMEOUT, &xResult );
+
+		configASSERT( xResult == pdFAIL );
+		ulNeverTimeouts++;
+
+		xWaited = xTickCount - xStart;
+		if( xWaited < testNEVER_TIMEOUT )
+		{
+			xNeverEarly = pdTRUE;
+		}
+		else if( ( xWaited - testNEVER_TIMEOUT ) > xMaxNeverOverrun )
+		{
+			xMaxNeverOverrun = xWaited - testNEVER_TIMEOUT;
+		}
+	}
+
+	jobEND( pxJob );
+}
+/*-----------------------------------------------------------*/
+
+static int prvCheck( const char *pcWhat, BaseType_t xPassed )
+{
+	printf( "%-48s %s\n", pcWhat, ( xPassed != pdFALSE ) ? "ok" : "FAILED" );
+	return ( xPassed != pdFALSE ) ? 0 : 1;
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+static Job_t xStreamJobs[ testREADY_JOBS ], xConsumerJob, xNeverJob;
+int i, iFailures = 0;
+
+	for( i = 0; i < testREADY_JOBS; i++ )
+	{
+		vJobInit( &( xStreamJobs[ i ] ), prvStreamJob, NULL, testSTREAM_PRIORITY );
+		( void ) xJobStart( &( xStreamJobs[ i ] ) );
+	}
+
+	vJobInit( &xConsumerJob, prvConsumerJob, NULL, testCONSUMER_PRIORITY );
+	( void ) xJobStart( &xConsumerJob );
+	vJobInit( &xNeverJob, prvNeverJob, NULL, testNEVER_PRIORITY );
+	( void ) xJobStart( &xNeverJob );
+
+	/* The executor never returns, so the tick jumps back here once the run
+	is over. */
+	if( setjmp( xRunEnd ) == 0 )
+	{
+		prvJobExecutorTask( NULL );
+	}
+
+	printf( "%lu produced, %lu consumed, max latency %lu ticks, %lu consumer timeouts\n",
+			ulProduced, ulConsumed, ( unsigned long ) xMaxConsumeLatency, ulConsumerTimeouts );
+	printf( "%lu timeouts of the never true wait, max overrun %lu ticks\n",
+			ulNeverTimeouts, ( unsigned long ) xMaxNeverOverrun );
+
+	/* An item is only produced once the last one has been consumed. */
+	iFailures += prvCheck( "consumer kept up with the producer",
+						   ulConsumed >= ( unsigned long ) ( testRUN_TICKS / testPRODUCE_PERIOD ) - 1UL );
+	iFailures += prvCheck( "items consumed within a tick", xMaxConsumeLatency <= ( TickType_t ) 1 );
+	iFailures += prvCheck( "consumer did not time out", ulConsumerTimeouts == 0UL );
+	iFailures += prvCheck( "never true wait timed out each time",
+						   ulNeverTimeouts >= ( unsigned long ) ( testRUN_TICKS / ( testNEVER_TIMEOUT + 1 ) ) - 1UL );
+	iFailures += prvCheck( "never true wait not timed out early", xNeverEarly == pdFALSE );
+	iFailures += prvCheck( "never true wait timed out within a tick", xMaxNeverOverrun <= ( TickType_t ) 1 );
+
+	return ( iFailures == 0 ) ? 0 : 1;
+}
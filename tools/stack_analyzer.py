@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+"""Worst-case task stack analysis for the STM32CubeIDE projects.
+
+Every project is compiled with -fstack-usage, so GCC writes the frame size of
+each function into a .su file next to its object.  This script combines those
+frame sizes with the call graph found in the objdump listing of the linked
+image (<project>.list) and, for every task entry function passed to
+xTaskCreate(), xTaskCreateStatic() or osThreadDef(), computes the deepest call
+chain the task can reach.
+
+The result is written to a header (Core/Inc/task_stacks.h by default) that
+defines TASK_STACK_WORDS_<entry function> for every task, in words as expected
+by xTaskCreate() and osThreadDef().  The header is only rewritten when its
+contents change, so an unchanged build stays up to date.
+
+Warnings are printed, in the form the IDE shows in its Problems view, when:
+  - a task can reach a recursive call chain,
+  - a task can reach an indirect call (function pointer), whose callee cannot
+    be known from the listing,
+  - a task can reach a function without stack usage information (library or
+    assembly code), for which a fixed frame is assumed,
+  - a function has a dynamically sized frame (alloca() or a VLA),
+  - the stack depth a task is created with is smaller than the computed worst
+    case.
+
+All but the last make the computed figure a lower bound rather than a bound,
+so the generated header should be reviewed whenever a warning is printed.
+
+The script is run from makefile.targets in each project directory, which the
+generated Debug/makefile includes, after the listing has been produced:
+
+    python3 stack_analyzer.py --list mutex2.list --su-dir . \\
+        --sources ../Core/Src --header ../Core/Inc/task_stacks.h
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# Bytes a task needs on top of its own call chain for the port to switch it
+# out.  On the ARM_CM4F port an exception stacks the extended (FPU) frame of
+# 26 words on the task stack, and PendSV then saves r4-r11, r14 and s16-s31 -
+# another 25 words.
+DEFAULT_CONTEXT_BYTES = (26 + 25) * 4
+
+# Extra headroom added to every task, in bytes.
+DEFAULT_MARGIN_BYTES = 32
+
+# Frame assumed for any other function without stack usage information, which
+# is mostly the C library.  A guess, so such tasks are always warned about.
+DEFAULT_UNKNOWN_FRAME_BYTES = 64
+
+# Frames of the newlib string routines, which are written in assembler and so
+# have no .su file.  None of them push more than r4-r7.  Others can be given
+# with --assume.
+LIBRARY_FRAMES = {
+    'memcpy': 16,
+    'memmove': 16,
+    'memset': 16,
+    'memcmp': 16,
+    'strlen': 16,
+    'strcmp': 16,
+}
+
+# Width of StackType_t and the stack alignment required by the AAPCS.
+STACK_WORD_BYTES = 4
+STACK_ALIGN_BYTES = 8
+
+RE_FUNCTION = re.compile(r'^([0-9a-f]{8}) <([^>]+)>:$')
+RE_INSN = re.compile(r'^\s+[0-9a-f]+:\t[0-9a-f ]+\t(\S+)(?:\t(.*))?$')
+RE_TARGET = re.compile(r'^[0-9a-f]+ <([^>+]+)(\+0x[0-9a-f]+)?>')
+RE_BRANCH = re.compile(r'^b(eq|ne|cs|hs|cc|lo|mi|pl|vs|vc|hi|ls|ge|lt|gt|le|al)?(\.w|\.n)?$')
+RE_INDIRECT_REG = re.compile(r'^(r\d+|ip|fp|sl|sb)$')
+
+RE_TASK_CREATE = re.compile(
+    r'xTaskCreate(?:Static)?\s*\(\s*(?:\(\s*TaskFunction_t\s*\)\s*)?&?(\w+)\s*,'
+    r'\s*(?:"[^"]*"|\w+)\s*,\s*([^,]+?)\s*,')
+RE_THREAD_DEF = re.compile(
+    r'osThreadDef\s*\(\s*\w+\s*,\s*(\w+)\s*,\s*[^,]+,\s*[^,]+,\s*([^)]+?)\s*\)')
+RE_COMMENT = re.compile(r'//[^\n]*|/\*.*?\*/', re.S)
+
+
+class Function:
+    def __init__(self, name):
+        self.name = name
+        self.frame = None
+        self.dynamic = False
+        self.callees = set()
+        self.indirect = False
+
+
+def warn(message, location=None):
+    prefix = (location + ': ') if location else ''
+    sys.stderr.write('%swarning: %s\n' % (prefix, message))
+
+
+def read_stack_usage(su_dir, functions):
+    """Reads the frame size of every function from the .su files under su_dir.
+    Static functions of the same name in different files cannot be told apart
+    in the listing, so the largest frame is kept."""
+    for root, _, files in os.walk(su_dir):
+        for file_name in files:
+            if not file_name.endswith('.su'):
+                continue
+            with open(os.path.join(root, file_name)) as su:
+                for line in su:
+                    fields = line.rstrip('\n').split('\t')
+                    if len(fields) < 3:
+                        continue
+                    name = fields[0].rsplit(':', 1)[-1]
+                    function = functions.setdefault(name, Function(name))
+                    function.frame = max(function.frame or 0, int(fields[1]))
+                    if 'dynamic' in fields[2] and 'bounded' not in fields[2]:
+                        function.dynamic = True
+
+
+def read_call_graph(list_file, functions):
+    """Adds the call edges found in the disassembly to functions.  bl and blx
+    to a symbol are calls, a branch to the start of another function is a tail
+    call, and blx or bx through a register other than lr is an indirect call."""
+    current = None
+    with open(list_file) as listing:
+        for line in listing:
+            match = RE_FUNCTION.match(line)
+            if match:
+                name = match.group(2)
+                current = functions.setdefault(name, Function(name))
+                continue
+            if current is None:
+                continue
+            match = RE_INSN.match(line)
+            if not match:
+                continue
+            mnemonic, operands = match.group(1), (match.group(2) or '').strip()
+            if mnemonic in ('bl', 'blx'):
+                target = RE_TARGET.match(operands)
+                if target:
+                    current.callees.add(target.group(1))
+                elif RE_INDIRECT_REG.match(operands):
+                    current.indirect = True
+            elif mnemonic == 'bx':
+                if RE_INDIRECT_REG.match(operands):
+                    current.indirect = True
+            elif RE_BRANCH.match(mnemonic):
+                target = RE_TARGET.match(operands)
+                if target and target.group(2) is None and target.group(1) != current.name:
+                    current.callees.add(target.group(1))
+
+
+def find_tasks(source_dirs):
+    """Returns (entry function, configured depth, location) for every task
+    created in the C sources of source_dirs."""
+    tasks = []
+    for source_dir in source_dirs:
+        for file_name in sorted(os.listdir(source_dir)):
+            if not file_name.endswith('.c'):
+                continue
+            path = os.path.join(source_dir, file_name)
+            with open(path) as source:
+                text = source.read()
+            # Blank out comments, keeping the line breaks so that line numbers
+            # still match the file.
+            text = RE_COMMENT.sub(lambda m: re.sub(r'[^\n]', ' ', m.group(0)), text)
+            for pattern in (RE_TASK_CREATE, RE_THREAD_DEF):
+                for match in pattern.finditer(text):
+                    line = text.count('\n', 0, match.start()) + 1
+                    tasks.append((match.group(1), match.group(2),
+                                  '%s:%d' % (path, line)))
+    return tasks
+
+
+class Analysis:
+    def __init__(self, functions, unknown_frame):
+        self.functions = functions
+        self.unknown_frame = unknown_frame
+
+    def worst_case(self, name):
+        """Returns the depth in bytes and the path of the deepest call chain
+        starting at name, and the sets of recursive chains, functions making
+        indirect calls, functions without stack usage information and
+        functions with a dynamic frame found on the way."""
+        recursive, indirect, unknown, dynamic = set(), set(), set(), set()
+        depth, path = self._visit(name, [], recursive, indirect, unknown, dynamic)
+        return depth, path, recursive, indirect, unknown, dynamic
+
+    def _visit(self, name, active, recursive, indirect, unknown, dynamic):
+        if name in active:
+            recursive.add(' -> '.join(active[active.index(name):] + [name]))
+            return 0, []
+        function = self.functions.get(name)
+        if function is None or function.frame is None:
+            unknown.add(name)
+        if function is None:
+            return self.unknown_frame, [name]
+        if function.indirect:
+            indirect.add(name)
+        if function.dynamic:
+            dynamic.add(name)
+        active.append(name)
+        deepest, deepest_path = 0, []
+        for callee in sorted(function.callees):
+            depth, path = self._visit(callee, active, recursive, indirect, unknown, dynamic)
+            if depth > deepest or not deepest_path:
+                deepest, deepest_path = depth, path
+        active.pop()
+        frame = self.unknown_frame if function.frame is None else function.frame
+        return frame + deepest, [name] + deepest_path
+
+
+def round_up(value, multiple):
+    return (value + multiple - 1) // multiple * multiple
+
+
+def render_header(guard, entries, context, margin):
+    lines = [
+        '/* Generated by tools/stack_analyzer.py from the -fstack-usage output and the',
+        ' * call graph of the linked image.  Do not edit: the file is rewritten by every',
+        ' * build whose worst case stack usage changed.',
+        ' *',
+        ' * Each size is the deepest call chain of the task, plus %d bytes for the' % context,
+        ' * port to save the task context and a %d byte margin, in words.' % margin,
+        ' */',
+        '',
+        '#ifndef %s' % guard,
+        '#define %s' % guard,
+        '',
+    ]
+    for name, depth, words, path in entries:
+        lines.append('/* %s: %d bytes, %s */' % (name, depth, ' -> '.join(path)))
+        lines.append('#define TASK_STACK_WORDS_%s %d' % (name, words))
+        lines.append('')
+    lines.append('#endif /* %s */' % guard)
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('--list', required=True,
+                        help='objdump -d or -S listing of the linked image')
+    parser.add_argument('--su-dir', required=True,
+                        help='directory searched for .su files')
+    parser.add_argument('--sources', action='append', required=True,
+                        help='directory of C sources searched for task creation')
+    parser.add_argument('--header', required=True,
+                        help='header to generate')
+    parser.add_argument('--context', type=int, default=DEFAULT_CONTEXT_BYTES,
+                        help='bytes added for the saved task context')
+    parser.add_argument('--margin', type=int, default=DEFAULT_MARGIN_BYTES,
+                        help='bytes of headroom added to every task')
+    parser.add_argument('--unknown-frame', type=int, default=DEFAULT_UNKNOWN_FRAME_BYTES,
+                        help='bytes assumed for a function without stack usage information')
+    parser.add_argument('--entry', action='append', default=[],
+                        help='additional task entry function to analyse')
+    parser.add_argument('--assume', action='append', default=[], metavar='FUNCTION=BYTES',
+                        help='frame size of a function without a .su file')
+    args = parser.parse_args()
+
+    functions = {}
+    for name, frame in LIBRARY_FRAMES.items():
+        functions[name] = Function(name)
+        functions[name].frame = frame
+    for assumption in args.assume:
+        name, frame = assumption.split('=')
+        functions[name] = Function(name)
+        functions[name].frame = int(frame)
+    read_stack_usage(args.su_dir, functions)
+    read_call_graph(args.list, functions)
+
+    tasks = find_tasks(args.sources)
+    tasks += [(name, None, None) for name in args.entry]
+
+    analysis = Analysis(functions, args.unknown_frame)
+    entries = []
+    seen = set()
+    for name, configured, location in tasks:
+        depth, path, recursive, indirect, unknown, dynamic = analysis.worst_case(name)
+        if name not in seen:
+            seen.add(name)
+            total = round_up(depth + args.context + args.margin, STACK_ALIGN_BYTES)
+            entries.append((name, depth, total // STACK_WORD_BYTES, path))
+            for cycle in sorted(recursive):
+                warn('task %s reaches recursion %s, its stack usage is unbounded'
+                     % (name, cycle), location)
+            if indirect:
+                warn('task %s makes indirect calls, whose callees are not included, in %s'
+                     % (name, ', '.join(sorted(indirect))), location)
+            if dynamic:
+                warn('task %s reaches dynamically sized frames in %s'
+                     % (name, ', '.join(sorted(dynamic))), location)
+            if unknown:
+                warn('task %s reaches functions without stack usage information, %d bytes assumed for each: %s'
+                     % (name, args.unknown_frame, ', '.join(sorted(unknown))), location)
+        if configured is not None and configured.isdigit():
+            needed = round_up(depth + args.context, STACK_WORD_BYTES) // STACK_WORD_BYTES
+            if int(configured) < needed:
+                warn('task %s is created with %s words but needs at least %d, use TASK_STACK_WORDS_%s'
+                     % (name, configured, needed, name), location)
+
+    guard = re.sub(r'\W', '_', os.path.basename(args.header)).upper()
+    header = render_header(guard, entries, args.context, args.margin)
+    previous = None
+    if os.path.exists(args.header):
+        with open(args.header) as existing:
+            previous = existing.read()
+    if header != previous:
+        with open(args.header, 'w') as generated:
+            generated.write(header)
+        print('%s updated, rebuild to apply the new task stack sizes' % args.header)
+    for name, depth, words, path in entries:
+        print('%-24s %5d bytes %5d words  %s' % (name, depth, words, ' -> '.join(path)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
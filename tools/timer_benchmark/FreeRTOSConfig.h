@@ -0,0 +1,37 @@
+/*
+ * Host configuration used by the programs in this directory.  Only the
+ * software timer daemon is compiled, so the settings that matter are the timer
+ * ones.  configUSE_TIMER_WHEEL and configTIMER_WHEEL_SLOTS are left to the
+ * command line so the same source runs with both implementations.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <assert.h>
+
+#define configUSE_PREEMPTION                     1
+#define configSUPPORT_STATIC_ALLOCATION          0
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configUSE_IDLE_HOOK                      0
+#define configUSE_TICK_HOOK                      0
+#define configCPU_CLOCK_HZ                       ( 180000000UL )
+#define configTICK_RATE_HZ                       ( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES                     ( 7 )
+#define configMINIMAL_STACK_SIZE                 ( ( uint16_t ) 128 )
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_16_BIT_TICKS                   0
+#define configUSE_MUTEXES                        1
+#define configQUEUE_REGISTRY_SIZE                0
+
+#define configUSE_TIMERS                         1
+#define configTIMER_TASK_PRIORITY                ( 2 )
+#define configTIMER_QUEUE_LENGTH                 1024
+#define configTIMER_TASK_STACK_DEPTH             256
+
+#define INCLUDE_xTaskGetSchedulerState           1
+#define INCLUDE_xTimerPendFunctionCall           0
+
+#define configASSERT( x )                        assert( x )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,153 @@
+/*
+ * Single threaded stand-ins for the scheduler and queue functions called by
+ * the software timer daemon, shared by the host programs in this directory.
+ * Include it after timers.c.  The program plays the part of the daemon task,
+ * running it with prvRunDaemon() each time it moves xTickCount on or sends a
+ * command.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+struct QueueDefinition
+{
+	uint8_t *pucStorage;
+	UBaseType_t uxLength;
+	UBaseType_t uxItemSize;
+	UBaseType_t uxHead;
+	UBaseType_t uxWaiting;
+};
+
+static TickType_t xTickCount = 0;
+static BaseType_t xDaemonBlocked = pdFALSE;
+
+TickType_t xTaskGetTickCount( void )
+{
+	return xTickCount;
+}
+
+void vTaskSuspendAll( void )
+{
+}
+
+BaseType_t xTaskResumeAll( void )
+{
+	/* Nothing else runs, so resuming never switches tasks, and the daemon
+	goes on to yield when it blocks. */
+	return pdFALSE;
+}
+
+BaseType_t xTaskGetSchedulerState( void )
+{
+	return taskSCHEDULER_RUNNING;
+}
+
+BaseType_t xTaskCreate( TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask )
+{
+	( void ) pxTaskCode;
+	( void ) pcName;
+	( void ) usStackDepth;
+	( void ) pvParameters;
+	( void ) uxPriority;
+	( void ) pxCreatedTask;
+
+	/* The benchmark is the daemon task. */
+	return pdPASS;
+}
+
+void *pvPortMalloc( size_t xSize )
+{
+	return malloc( xSize );
+}
+
+void vPortFree( void *pv )
+{
+	free( pv );
+}
+
+QueueHandle_t xQueueGenericCreate( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, const uint8_t ucQueueType )
+{
+QueueHandle_t xQueue;
+
+	( void ) ucQueueType;
+
+	xQueue = calloc( 1, sizeof( struct QueueDefinition ) );
+	xQueue->pucStorage = malloc( uxQueueLength * uxItemSize );
+	xQueue->uxLength = uxQueueLength;
+	xQueue->uxItemSize = uxItemSize;
+
+	return xQueue;
+}
+
+BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition )
+{
+UBaseType_t uxTail;
+
+	( void ) xTicksToWait;
+	( void ) xCopyPosition;
+
+	/* Nothing would empty a full queue, so the run is sized to never fill
+	it. */
+	configASSERT( xQueue->uxWaiting < xQueue->uxLength );
+
+	uxTail = ( xQueue->uxHead + xQueue->uxWaiting ) % xQueue->uxLength;
+	memcpy( xQueue->pucStorage + ( uxTail * xQueue->uxItemSize ), pvItemToQueue, xQueue->uxItemSize );
+	xQueue->uxWaiting++;
+
+	return pdPASS;
+}
+
+BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition )
+{
+	( void ) pxHigherPriorityTaskWoken;
+
+	return xQueueGenericSend( xQueue, pvItemToQueue, 0, xCopyPosition );
+}
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+	return xQueue->uxWaiting;
+}
+
+BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
+{
+	( void ) xTicksToWait;
+
+	if( xQueue->uxWaiting == 0U )
+	{
+		return pdFALSE;
+	}
+
+	memcpy( pvBuffer, xQueue->pucStorage + ( xQueue->uxHead * xQueue->uxItemSize ), xQueue->uxItemSize );
+	xQueue->uxHead = ( xQueue->uxHead + 1U ) % xQueue->uxLength;
+	xQueue->uxWaiting--;
+
+	return pdTRUE;
+}
+
+void vQueueWaitForMessageRestricted( QueueHandle_t xQueue, TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely )
+{
+	( void ) xQueue;
+	( void ) xTicksToWait;
+	( void ) xWaitIndefinitely;
+
+	/* This is where the daemon would block, so there is nothing more to do
+	until the tick count moves on or another command is sent. */
+	xDaemonBlocked = pdTRUE;
+}
+
+/* One pass of the daemon's loop (see prvTimerTask() in timers.c) for each
+timer that is due, until the daemon would block. */
+static void prvRunDaemon( void )
+{
+TickType_t xNextExpireTime;
+BaseType_t xListWasEmpty;
+
+	do
+	{
+		xDaemonBlocked = pdFALSE;
+		xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+		prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+		prvProcessReceivedCommands();
+	} while( xDaemonBlocked == pdFALSE );
+}
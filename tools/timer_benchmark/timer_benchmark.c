@@ -0,0 +1,213 @@
+/*
+ * Host benchmark for the software timer daemon.
+ *
+ * Builds the kernel's timers.c and list.c for the host, with the scheduler and
+ * queue functions the daemon calls replaced by the single threaded stand-ins
+ * below, and measures the two costs that grow with the number of armed timers:
+ *
+ *   reset   - xTimerReset() of a timer that is already running, as a protocol
+ *             does each time traffic arrives, including the daemon processing
+ *             the command.
+ *   expiry  - a tick of the daemon with auto-reload timers of mixed periods
+ *             expiring and being reloaded.
+ *
+ * Build it once with the sorted list and once with the timing wheel, from the
+ * directory holding this file, and compare the output:
+ *
+ *     K=../../mutex2/Middlewares/Third_Party/FreeRTOS/Source
+ *     gcc -O2 -I. -I$K -I$K/include -DconfigUSE_TIMER_WHEEL=0 timer_benchmark.c -o timer_list
+ *     gcc -O2 -I. -I$K -I$K/include -DconfigUSE_TIMER_WHEEL=1 timer_benchmark.c -o timer_wheel
+ *     ./timer_list && ./timer_wheel
+ *
+ * Add -DconfigTIMER_WHEEL_SLOTS=n to try another wheel size.  The times are
+ * host times, so only the way they change with the number of timers carries
+ * over to the target.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* The kernel sources are compiled into this file so the benchmark can call the
+daemon's static functions directly. */
+#include "list.c"
+#include "timers.c"
+#include "kernel_stubs.c"
+
+#define benchRESETS				( 200000UL )
+#define benchTICKS				( 20000UL )
+
+/* A protocol timeout, long compared to the rate at which it is reset. */
+#define benchTIMEOUT_MIN		( ( TickType_t ) 1000 )
+#define benchTIMEOUT_RANGE		( ( TickType_t ) 4000 )
+
+/* Periods of the auto-reload timers in the expiry run. */
+#define benchPERIOD_MIN			( ( TickType_t ) 10 )
+#define benchPERIOD_RANGE		( ( TickType_t ) 1000 )
+
+static const UBaseType_t uxTimerCounts[] = { 10, 100, 1000 };
+
+static unsigned long ulCallbacks = 0;
+
+/*-----------------------------------------------------------*/
+
+/* Small, repeatable pseudo random sequence, so both builds see the same
+timers and the same order of resets. */
+static uint32_t ulRandomState = 1UL;
+
+static uint32_t prvRandom( void )
+{
+	ulRandomState ^= ulRandomState << 13;
+	ulRandomState ^= ulRandomState >> 17;
+	ulRandomState ^= ulRandomState << 5;
+	return ulRandomState;
+}
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1e9 ) + ( double ) xNow.tv_nsec;
+}
+
+static void prvCountCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+	ulCallbacks++;
+}
+
+static TimerHandle_t *prvCreateTimers( UBaseType_t uxCount, TickType_t xMinimum, TickType_t xRange, UBaseType_t uxAutoReload )
+{
+TimerHandle_t *pxTimers;
+UBaseType_t x;
+
+	pxTimers = malloc( uxCount * sizeof( TimerHandle_t ) );
+
+	for( x = 0; x < uxCount; x++ )
+	{
+		pxTimers[ x ] = xTimerCreate( "Bench", xMinimum + ( TickType_t ) ( prvRandom() % xRange ), uxAutoReload, NULL, prvCountCallback );
+		configASSERT( pxTimers[ x ] != NULL );
+		xTimerStart( pxTimers[ x ], 0 );
+
+		/* Keep the command queue from filling. */
+		if( ( x % ( configTIMER_QUEUE_LENGTH / 2 ) ) == 0U )
+		{
+			prvRunDaemon();
+		}
+	}
+
+	prvRunDaemon();
+
+	return pxTimers;
+}
+
+static void prvDeleteTimers( TimerHandle_t *pxTimers, UBaseType_t uxCount )
+{
+UBaseType_t x;
+
+	for( x = 0; x < uxCount; x++ )
+	{
+		xTimerDelete( pxTimers[ x ], 0 );
+
+		if( ( x % ( configTIMER_QUEUE_LENGTH / 2 ) ) == 0U )
+		{
+			prvRunDaemon();
+		}
+	}
+
+	prvRunDaemon();
+	free( pxTimers );
+}
+
+/* Nanoseconds per reset of a running one-shot timeout.  The tick count moves
+on as the resets arrive, but each timer is reset long before it would
+expire. */
+static double prvMeasureReset( UBaseType_t uxCount )
+{
+TimerHandle_t *pxTimers;
+unsigned long ul;
+double dStart, dElapsed;
+
+	pxTimers = prvCreateTimers( uxCount, benchTIMEOUT_MIN, benchTIMEOUT_RANGE, pdFALSE );
+	ulCallbacks = 0;
+
+	dStart = prvNanoseconds();
+
+	for( ul = 0; ul < benchRESETS; ul++ )
+	{
+		if( ( ul % 16UL ) == 0UL )
+		{
+			xTickCount++;
+		}
+
+		xTimerReset( pxTimers[ prvRandom() % uxCount ], 0 );
+		prvRunDaemon();
+	}
+
+	dElapsed = prvNanoseconds() - dStart;
+
+	/* Timeouts with few timers can still expire between resets, which is
+	fine, but a large share would mean the reset run measured expiry. */
+	configASSERT( ulCallbacks < ( benchRESETS / 100UL ) );
+
+	prvDeleteTimers( pxTimers, uxCount );
+
+	return dElapsed / ( double ) benchRESETS;
+}
+
+/* Nanoseconds per tick of the daemon with auto-reload timers expiring, and
+the number of callbacks run. */
+static double prvMeasureExpiry( UBaseType_t uxCount, unsigned long *pulCallbacks )
+{
+TimerHandle_t *pxTimers;
+unsigned long ul;
+double dStart, dElapsed;
+
+	pxTimers = prvCreateTimers( uxCount, benchPERIOD_MIN, benchPERIOD_RANGE, pdTRUE );
+	ulCallbacks = 0;
+
+	dStart = prvNanoseconds();
+
+	for( ul = 0; ul < benchTICKS; ul++ )
+	{
+		xTickCount++;
+		prvRunDaemon();
+	}
+
+	dElapsed = prvNanoseconds() - dStart;
+	*pulCallbacks = ulCallbacks;
+
+	prvDeleteTimers( pxTimers, uxCount );
+
+	return dElapsed / ( double ) benchTICKS;
+}
+
+int main( void )
+{
+UBaseType_t x;
+double dReset, dExpiry;
+unsigned long ulExpiries;
+
+	#if( configUSE_TIMER_WHEEL == 1 )
+		printf( "Timing wheel, %u slots\n", ( unsigned ) configTIMER_WHEEL_SLOTS );
+	#else
+		printf( "Sorted list\n" );
+	#endif
+
+	printf( "%8s %16s %18s %12s\n", "timers", "reset (ns/op)", "expiry (ns/tick)", "callbacks" );
+
+	for( x = 0; x < ( sizeof( uxTimerCounts ) / sizeof( uxTimerCounts[ 0 ] ) ); x++ )
+	{
+		ulRandomState = 1UL + ( uint32_t ) x;
+		dReset = prvMeasureReset( uxTimerCounts[ x ] );
+		dExpiry = prvMeasureExpiry( uxTimerCounts[ x ], &ulExpiries );
+
+		printf( "%8lu %16.1f %18.1f %12lu\n", ( unsigned long ) uxTimerCounts[ x ], dReset, dExpiry, ulExpiries );
+	}
+
+	return 0;
+}
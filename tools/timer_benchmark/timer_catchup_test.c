@@ -0,0 +1,266 @@
+/*
+ * Host test of auto-reload timers catching up with missed expiries.
+ *
+ * Runs a phase locked timer with a period of 100/3 ticks (33 ticks plus a
+ * fraction of 0x55555556) through a tick count overflow, with the sorted list
+ * and with the timing wheel.  In the first run the daemon sees every tick.  In
+ * the second it regularly misses several periods at once, including across
+ * the overflow, so the timer has to catch up with a callback for each missed
+ * expiry.  Each run checks that:
+ *
+ *   - the callback is called once for every expiry, the nth at the tick count
+ *     T0 + n * 100 / 3 rounded down, and never before that tick;
+ *   - during the callback for expiry n the timer has already been reloaded,
+ *     so its expiry time is that of expiry n + 1;
+ *   - the callbacks are called in the order of their expiries.  A callback
+ *     cannot tell which expiry it is called for, but the daemon records how
+ *     late each call is, measured from the expiry it is for, in the timer's
+ *     callback statistics.  At each callback the worst lateness recorded so
+ *     far must match the calls made so far, taken in order.
+ *
+ * It then checks that xTimerChangePeriodExact() leaves the period and its
+ * fraction alone until the daemon processes the command, and then changes
+ * both, so the timer is not reloaded with one and not the other.
+ *
+ * Build and run it with each implementation, from the directory holding this
+ * file:
+ *
+ *     K=../../mutex2/Middlewares/Third_Party/FreeRTOS/Source
+ *     gcc -O2 -I. -I$K -I$K/include -DconfigUSE_TIMER_WHEEL=0 timer_catchup_test.c -o catchup_list
+ *     gcc -O2 -I. -I$K -I$K/include -DconfigUSE_TIMER_WHEEL=1 timer_catchup_test.c -o catchup_wheel
+ *     ./catchup_list && ./catchup_wheel
+ *
+ * Each exits with 0 if every check passes.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define configUSE_TIMER_PHASE_LOCK		1
+#define configUSE_TIMER_PROFILING		1
+
+/* The callbacks take no time as far as the statistics are concerned. */
+#define portENABLE_CYCLE_COUNTER()
+#define portGET_CYCLE_COUNTER()			( 0UL )
+
+/* The kernel sources are compiled into this file so the test can call the
+daemon's static functions directly. */
+#include "list.c"
+#include "timers.c"
+#include "kernel_stubs.c"
+
+#define testPERIOD					( ( TickType_t ) 33 )
+#define testPERIOD_FRACTION			( 0x55555556UL )
+
+/* Ticks run in each test, starting shortly before the tick count overflows. */
+#define testRUN_TICKS				( ( TickType_t ) 5000 )
+#define testSTART_TICK				( ( TickType_t ) 0 - ( TickType_t ) 1000 )
+#define testFIRST_EXPIRY_DELAY		( ( TickType_t ) 5 )
+
+/* In the second run the daemon misses testJUMP_TICKS ticks, several periods,
+every testJUMP_INTERVAL ticks, and once from testWRAP_JUMP_FROM over the
+overflow. */
+#define testJUMP_TICKS				( ( TickType_t ) 150 )
+#define testJUMP_INTERVAL			( ( TickType_t ) 50 )
+#define testWRAP_JUMP_FROM			( ( TickType_t ) 0 - ( TickType_t ) 100 )
+
+/*-----------------------------------------------------------*/
+
+static TickType_t xFirstExpiry;
+static unsigned long ulExpiries;
+static unsigned long ulReloadErrors, ulOrderErrors, ulEarlyCalls;
+static TickType_t xMaxLateness;
+
+/* The tick count the nth expiry after the first is due at. */
+static TickType_t prvExpiryTime( unsigned long ulExpiry )
+{
+	return xFirstExpiry + ( TickType_t ) ( ( ( uint64_t ) ulExpiry * 100ULL ) / 3ULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCallback( TimerHandle_t xTimer )
+{
+const TickType_t xDue = prvExpiryTime( ulExpiries );
+const TickType_t xLateness = xTickCount - xDue;
+TimerCallbackStats_t xStats;
+
+	if( xTimerGetExpiryTime( xTimer ) != prvExpiryTime( ulExpiries + 1UL ) )
+	{
+		ulReloadErrors++;
+	}
+
+	/* The statistics cover the calls before this one. */
+	vTimerGetCallbackStats( xTimer, &xStats );
+	if( xStats.xMaxLateness != xMaxLateness )
+	{
+		if( ulOrderErrors == 0UL )
+		{
+			printf( "  expiry %lu: worst lateness so far recorded as %lu ticks, expected %lu\n",
+					ulExpiries, ( unsigned long ) xStats.xMaxLateness, ( unsigned long ) xMaxLateness );
+		}
+
+		ulOrderErrors++;
+	}
+
+	/* The lateness wraps to a value in the top half of the tick range if the
+	callback is early. */
+	if( xLateness > ( portMAX_DELAY >> 1 ) )
+	{
+		ulEarlyCalls++;
+	}
+	else if( xLateness > xMaxLateness )
+	{
+		xMaxLateness = xLateness;
+	}
+
+	ulExpiries++;
+}
+/*-----------------------------------------------------------*/
+
+static int prvCheck( const char *pcWhat, BaseType_t xPassed )
+{
+	printf( "  %-46s %s\n", pcWhat, ( xPassed != pdFALSE ) ? "ok" : "FAILED" );
+	return ( xPassed != pdFALSE ) ? 0 : 1;
+}
+/*-----------------------------------------------------------*/
+
+static int prvRun( const char *pcName, BaseType_t xJump, TickType_t xLatenessLimit )
+{
+TimerHandle_t xTimer;
+TickType_t xElapsed;
+unsigned long ulExpected = 0;
+int iFailures = 0;
+
+	printf( "%s\n", pcName );
+
+	xTickCount = testSTART_TICK;
+	xFirstExpiry = testSTART_TICK + testFIRST_EXPIRY_DELAY;
+	ulExpiries = 0;
+	ulReloadErrors = 0;
+	ulOrderErrors = 0;
+	ulEarlyCalls = 0;
+	xMaxLateness = 0;
+
+	xTimer = xTimerCreate( "Catchup", testPERIOD, pdTRUE, NULL, prvCallback );
+	configASSERT( xTimer != NULL );
+	vTimerSetPeriodFraction( xTimer, testPERIOD_FRACTION );
+	( void ) xTimerStartAt( xTimer, xFirstExpiry, 0 );
+	prvRunDaemon();
+
+	while( ( TickType_t ) ( xTickCount - testSTART_TICK ) < testRUN_TICKS )
+	{
+		if( ( xJump != pdFALSE ) &&
+			( ( ( ( xTickCount - testSTART_TICK ) % testJUMP_INTERVAL ) == 0 ) || ( xTickCount == testWRAP_JUMP_FROM ) ) )
+		{
+			xTickCount += testJUMP_TICKS;
+		}
+		else
+		{
+			xTickCount++;
+		}
+
+		prvRunDaemon();
+	}
+
+	/* Every expiry up to the time now should have had its callback. */
+	xElapsed = xTickCount - xFirstExpiry;
+	while( ( TickType_t ) ( ( ( uint64_t ) ulExpected * 100ULL ) / 3ULL ) <= xElapsed )
+	{
+		ulExpected++;
+	}
+
+	printf( "  %lu callbacks, %lu expected, max lateness %lu ticks\n",
+			ulExpiries, ulExpected, ( unsigned long ) xMaxLateness );
+
+	iFailures += prvCheck( "one callback for each expiry", ulExpiries == ulExpected );
+	iFailures += prvCheck( "timer reloaded before each callback", ulReloadErrors == 0UL );
+	iFailures += prvCheck( "callbacks in the order of their expiries", ulOrderErrors == 0UL );
+	iFailures += prvCheck( "no callback early", ulEarlyCalls == 0UL );
+	iFailures += prvCheck( "callbacks no later than the daemon", xMaxLateness <= xLatenessLimit );
+
+	( void ) xTimerDelete( xTimer, 0 );
+	prvRunDaemon();
+
+	return iFailures;
+}
+/*-----------------------------------------------------------*/
+
+static int prvChangePeriodExact( void )
+{
+TimerHandle_t xTimer;
+TickType_t xCommandTime;
+unsigned long ulExpected;
+int iFailures = 0;
+
+	printf( "Change of period and fraction\n" );
+
+	xTickCount = testSTART_TICK;
+	xFirstExpiry = testSTART_TICK + ( TickType_t ) 10;
+	ulExpiries = 0;
+	ulOrderErrors = 0;
+	ulEarlyCalls = 0;
+	xMaxLateness = 0;
+
+	xTimer = xTimerCreate( "Exact", ( TickType_t ) 10, pdTRUE, NULL, prvCallback );
+	configASSERT( xTimer != NULL );
+	( void ) xTimerStart( xTimer, 0 );
+	prvRunDaemon();
+
+	/* Send the command and let the timer expire before the daemon gets to
+	it, so the reload in between still uses the old period and fraction. */
+	xTickCount += ( TickType_t ) 10;
+	xCommandTime = xTickCount;
+	( void ) xTimerChangePeriodExact( xTimer, testPERIOD, testPERIOD_FRACTION, 0 );
+	iFailures += prvCheck( "unchanged until the command is processed",
+						   ( xTimerGetPeriod( xTimer ) == ( TickType_t ) 10 ) && ( ulTimerGetPeriodFraction( xTimer ) == 0UL ) );
+	prvRunDaemon();
+	iFailures += prvCheck( "period and fraction changed together",
+						   ( xTimerGetPeriod( xTimer ) == testPERIOD ) && ( ulTimerGetPeriodFraction( xTimer ) == testPERIOD_FRACTION ) );
+
+	/* The phase of the new period is taken from the time the command was
+	processed, which is the time it was sent here, so expiry n is due at
+	xCommandTime + n * 100 / 3.  Count from expiry 1, as expiry 0 is the
+	command itself. */
+	xFirstExpiry = xCommandTime;
+	ulExpiries = 1;
+	ulReloadErrors = 0;
+	while( ( TickType_t ) ( xTickCount - xCommandTime ) < ( TickType_t ) 1000 )
+	{
+		xTickCount++;
+		prvRunDaemon();
+	}
+
+	/* Expiries 0 to n are due by the time now. */
+	ulExpected = 0;
+	while( ( TickType_t ) ( ( ( uint64_t ) ulExpected * 100ULL ) / 3ULL ) <= ( TickType_t ) ( xTickCount - xFirstExpiry ) )
+	{
+		ulExpected++;
+	}
+
+	iFailures += prvCheck( "new period and fraction used from then on",
+						   ( ulExpiries == ulExpected ) && ( ulReloadErrors == 0UL ) && ( ulOrderErrors == 0UL ) &&
+						   ( ulEarlyCalls == 0UL ) && ( xMaxLateness == 0 ) );
+
+	( void ) xTimerDelete( xTimer, 0 );
+	prvRunDaemon();
+
+	return iFailures;
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+int iFailures = 0;
+
+	#if( configUSE_TIMER_WHEEL == 1 )
+		printf( "Timing wheel, %u slots\n", ( unsigned ) configTIMER_WHEEL_SLOTS );
+	#else
+		printf( "Sorted list\n" );
+	#endif
+
+	iFailures += prvRun( "Every tick", pdFALSE, 0 );
+	iFailures += prvRun( "Missed periods", pdTRUE, testJUMP_TICKS - 1 );
+	iFailures += prvChangePeriodExact();
+
+	return ( iFailures == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+/*
+ * Host test of timer commands carried out directly by the calling task.
+ *
+ * With configUSE_TIMER_DIRECT_COMMANDS set to 1 a task that starts, resets,
+ * stops or changes the period of a timer while the timer service task is
+ * blocked updates the active timers itself, unless that would need the
+ * daemon to wake earlier than it is going to.  The test plays a second task,
+ * which runs whenever the daemon blocks (the daemon's yield is the hook) and
+ * moves the tick count on until the daemon would wake: at its wake time, or
+ * as soon as a command is waiting in the queue.  That task keeps resetting 20
+ * one-shot timers of different periods with xTimerResetMultiple(), in bursts
+ * with quiet spells in between so the timers also expire, across a tick count
+ * overflow.  With the sorted list and with the timing wheel it checks that:
+ *
+ *   - each callback is called on the tick its timer is due, one period after
+ *     its last reset - never early, and never late, which it would be if a
+ *     timer had been added to expire before the daemon's wake time;
+ *   - no expiry is lost, and no callback comes for a timer that has since been
+ *     reset;
+ *   - whenever the reset leaves no command in the queue, every armed timer
+ *     expires no earlier than the time the daemon is blocked until;
+ *   - some of the resets were carried out directly and some were sent to the
+ *     daemon, so both paths have been run.
+ *
+ * Build and run it with each implementation, from the directory holding this
+ * file:
+ *
+ *     K=../../mutex2/Middlewares/Third_Party/FreeRTOS/Source
+ *     gcc -O2 -I. -I$K -I$K/include -DconfigUSE_TIMER_WHEEL=0 timer_direct_command_test.c -o direct_list
+ *     gcc -O2 -I. -I$K -I$K/include -DconfigUSE_TIMER_WHEEL=1 timer_direct_command_test.c -o direct_wheel
+ *     ./direct_list && ./direct_wheel
+ *
+ * Each exits with 0 if every check passes.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define configUSE_TIMER_DIRECT_COMMANDS		1
+
+/* The other task runs each time the daemon blocks. */
+static void prvDaemonBlocked( void );
+#define portYIELD_WITHIN_API()				prvDaemonBlocked()
+
+/* The kernel sources are compiled into this file so the test can call the
+daemon's static functions directly. */
+#include "list.c"
+#include "timers.c"
+#include "kernel_stubs.c"
+
+#define testTIMERS					( 20 )
+
+/* Ticks run, starting shortly before the tick count overflows. */
+#define testRUN_TICKS				( ( TickType_t ) 6000 )
+#define testSTART_TICK				( ( TickType_t ) 0 - ( TickType_t ) 2500 )
+
+/* The timers are reset every testRESET_INTERVAL ticks for the first
+testBURST_TICKS of every testCYCLE_TICKS, and left to expire for the rest. */
+#define testRESET_INTERVAL			( ( TickType_t ) 7 )
+#define testBURST_TICKS				( ( TickType_t ) 120 )
+#define testCYCLE_TICKS				( ( TickType_t ) 200 )
+
+/* Periods of 3 to 98 ticks, some shorter than the reset interval. */
+#define testPERIOD( x )				( ( TickType_t ) ( 3 + ( 5 * ( x ) ) ) )
+
+/*-----------------------------------------------------------*/
+
+static TimerHandle_t xTimers[ testTIMERS ];
+
+/* When each timer is due, and whether it is armed, as far as the test knows. */
+static TickType_t xDue[ testTIMERS ];
+static BaseType_t xArmed[ testTIMERS ];
+
+static unsigned long ulCallbacks, ulEarlyCalls, ulLateCalls, ulUnexpectedCalls;
+static unsigned long ulResets, ulDirect, ulQueued, ulWakeErrors;
+
+/*-----------------------------------------------------------*/
+
+static void prvCallback( TimerHandle_t xTimer )
+{
+const size_t x = ( size_t ) pvTimerGetTimerID( xTimer );
+
+	if( xArmed[ x ] == pdFALSE )
+	{
+		ulUnexpectedCalls++;
+	}
+	else if( xTickCount != xDue[ x ] )
+	{
+		/* The difference wraps to the top half of the tick range if the
+		callback is early. */
+		if( ( TickType_t ) ( xTickCount - xDue[ x ] ) > ( portMAX_DELAY >> 1 ) )
+		{
+			ulEarlyCalls++;
+		}
+		else
+		{
+			ulLateCalls++;
+		}
+	}
+
+	xArmed[ x ] = pdFALSE;
+	ulCallbacks++;
+}
+/*-----------------------------------------------------------*/
+
+/* The other task's work: reset every timer, and note which of the resets the
+daemon has been left to do. */
+static void prvResetTimers( void )
+{
+UBaseType_t uxQueuedBefore = xTimerQueue->uxWaiting;
+size_t x;
+
+	( void ) xTimerResetMultiple( xTimers, testTIMERS, 0 );
+
+	for( x = 0; x < testTIMERS; x++ )
+	{
+		xDue[ x ] = xTickCount + testPERIOD( x );
+		xArmed[ x ] = pdTRUE;
+	}
+
+	ulResets += testTIMERS;
+	ulQueued += ( unsigned long ) ( xTimerQueue->uxWaiting - uxQueuedBefore );
+	ulDirect = ulResets - ulQueued;
+
+	/* With nothing in the queue the daemon stays blocked until its wake time,
+	so no timer may be due before then. */
+	if( ( xTimerQueue->uxWaiting == 0U ) && ( xDaemonState == tmrDAEMON_WAITING ) )
+	{
+		for( x = 0; x < testTIMERS; x++ )
+		{
+			if( ( TickType_t ) ( xDue[ x ] - xDaemonBlockTime ) < ( TickType_t ) ( xDaemonWakeTime - xDaemonBlockTime ) )
+			{
+				ulWakeErrors++;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvDaemonBlocked( void )
+{
+TickType_t xElapsed;
+
+	for( ;; )
+	{
+		/* A command in the queue, or reaching its wake time, wakes the
+		daemon. */
+		if( xTimerQueue->uxWaiting != 0U )
+		{
+			break;
+		}
+
+		if( ( xDaemonState == tmrDAEMON_WAITING ) &&
+			( ( TickType_t ) ( xTickCount - xDaemonBlockTime ) >= ( TickType_t ) ( xDaemonWakeTime - xDaemonBlockTime ) ) )
+		{
+			break;
+		}
+
+		if( ( TickType_t ) ( xTickCount - testSTART_TICK ) >= testRUN_TICKS )
+		{
+			break;
+		}
+
+		xTickCount++;
+
+		xElapsed = xTickCount - testSTART_TICK;
+		if( ( ( xElapsed % testCYCLE_TICKS ) < testBURST_TICKS ) && ( ( xElapsed % testRESET_INTERVAL ) == 0 ) )
+		{
+			prvResetTimers();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static int prvCheck( const char *pcWhat, BaseType_t xPassed )
+{
+	printf( "  %-46s %s\n", pcWhat, ( xPassed != pdFALSE ) ? "ok" : "FAILED" );
+	return ( xPassed != pdFALSE ) ? 0 : 1;
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+unsigned long ulLost = 0;
+size_t x;
+int iFailures = 0;
+
+	#if( configUSE_TIMER_WHEEL == 1 )
+		printf( "Timing wheel, %u slots\n", ( unsigned ) configTIMER_WHEEL_SLOTS );
+	#else
+		printf( "Sorted list\n" );
+	#endif
+
+	xTickCount = testSTART_TICK;
+
+	for( x = 0; x < testTIMERS; x++ )
+	{
+		xTimers[ x ] = xTimerCreate( "Direct", testPERIOD( x ), pdFALSE, ( void * ) x, prvCallback );
+		configASSERT( xTimers[ x ] != NULL );
+	}
+
+	/* The first reset is sent to the daemon, which has not blocked yet. */
+	prvResetTimers();
+
+	while( ( TickType_t ) ( xTickCount - testSTART_TICK ) < testRUN_TICKS )
+	{
+		prvRunDaemon();
+	}
+
+	/* The run ends in a quiet spell, by when every timer still armed should
+	have expired unless it is not yet due. */
+	for( x = 0; x < testTIMERS; x++ )
+	{
+		if( ( xArmed[ x ] != pdFALSE ) && ( ( TickType_t ) ( xTickCount - xDue[ x ] ) <= ( portMAX_DELAY >> 1 ) ) )
+		{
+			ulLost++;
+		}
+	}
+
+	printf( "  %lu resets, %lu direct, %lu sent to the daemon, %lu callbacks\n",
+			ulResets, ulDirect, ulQueued, ulCallbacks );
+
+	iFailures += prvCheck( "no callback early", ulEarlyCalls == 0UL );
+	iFailures += prvCheck( "no callback late", ulLateCalls == 0UL );
+	iFailures += prvCheck( "no expiry lost", ulLost == 0UL );
+	iFailures += prvCheck( "no callback after a reset", ulUnexpectedCalls == 0UL );
+	iFailures += prvCheck( "no timer due before the daemon wakes", ulWakeErrors == 0UL );
+	iFailures += prvCheck( "resets carried out directly", ulDirect > 0UL );
+	iFailures += prvCheck( "resets sent to the daemon", ulQueued > 0UL );
+
+	return ( iFailures == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+/*
+ * Host test of the software timer callback statistics.
+ *
+ * Replaces the port's cycle counter with a variable that only the callback
+ * moves on, by an amount taken in turn from a table, so every call of the
+ * callback costs a known number of cycles.  The counter starts shortly before
+ * it overflows.  With the sorted list and with the timing wheel the test
+ * runs an auto-reload timer and checks that:
+ *
+ *   - vTimerGetCallbackStats() reports the number of calls and the shortest,
+ *     longest and average cycles the callback was charged;
+ *   - vApplicationTimerOverrunHook() is called, with the timer and the cycles
+ *     taken, for each call over the default budget, and the overruns are
+ *     counted.  vTimerSetCallbackBudget() then changes the budget, and a
+ *     budget of 0 turns the check off;
+ *   - vTimerResetCallbackStats() clears every statistic, and the ones
+ *     recorded after it, including the lateness and missed periods of a
+ *     timer catching up, only cover the calls made since.
+ *
+ * Build and run it with each implementation, from the directory holding this
+ * file:
+ *
+ *     K=../../mutex2/Middlewares/Third_Party/FreeRTOS/Source
+ *     gcc -O2 -I. -I$K -I$K/include -DconfigUSE_TIMER_WHEEL=0 timer_profiling_test.c -o profiling_list
+ *     gcc -O2 -I. -I$K -I$K/include -DconfigUSE_TIMER_WHEEL=1 timer_profiling_test.c -o profiling_wheel
+ *     ./profiling_list && ./profiling_wheel
+ *
+ * Each exits with 0 if every check passes.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define configUSE_TIMER_PROFILING				1
+#define configUSE_TIMER_OVERRUN_HOOK			1
+#define configTIMER_CALLBACK_BUDGET_CYCLES		( 800UL )
+
+/* The fake cycle counter. */
+static uint32_t ulCycleCounter;
+
+#define portENABLE_CYCLE_COUNTER()
+#define portGET_CYCLE_COUNTER()					( ulCycleCounter )
+
+/* The kernel sources are compiled into this file so the test can call the
+daemon's static functions directly. */
+#include "list.c"
+#include "timers.c"
+#include "kernel_stubs.c"
+
+#define testPERIOD					( ( TickType_t ) 10 )
+#define testCYCLE_COUNTER_START		( 0xffffff00UL )
+
+/* Cycles charged to successive calls of the callback, round and round. */
+static const uint32_t ulCallbackCycles[] = { 500UL, 120UL, 900UL, 300UL, 1500UL, 120UL, 700UL, 60UL, 800UL };
+#define testCALLBACK_CYCLES_COUNT	( sizeof( ulCallbackCycles ) / sizeof( ulCallbackCycles[ 0 ] ) )
+
+/*-----------------------------------------------------------*/
+
+static TimerHandle_t xTimer;
+static unsigned long ulCalls;
+
+/* What the callback has been charged since the statistics were last
+cleared, worked out independently of timers.c. */
+static unsigned long ulChargedCalls;
+static uint64_t ullChargedCycles;
+static uint32_t ulChargedMin, ulChargedMax;
+static uint32_t ulBudget = configTIMER_CALLBACK_BUDGET_CYCLES;
+static unsigned long ulExpectedOverruns;
+
+/* Calls of the overrun hook. */
+static unsigned long ulHookCalls, ulHookErrors;
+
+static void prvClearCharges( void )
+{
+	ulChargedCalls = 0UL;
+	ullChargedCycles = 0ULL;
+	ulChargedMin = 0UL;
+	ulChargedMax = 0UL;
+	ulExpectedOverruns = 0UL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCallback( TimerHandle_t xExpiredTimer )
+{
+const uint32_t ulCycles = ulCallbackCycles[ ulCalls % testCALLBACK_CYCLES_COUNT ];
+
+	( void ) xExpiredTimer;
+
+	ulCycleCounter += ulCycles;
+	ulCalls++;
+
+	if( ( ulChargedCalls == 0UL ) || ( ulCycles < ulChargedMin ) )
+	{
+		ulChargedMin = ulCycles;
+	}
+
+	if( ulCycles > ulChargedMax )
+	{
+		ulChargedMax = ulCycles;
+	}
+
+	if( ( ulBudget != 0UL ) && ( ulCycles > ulBudget ) )
+	{
+		ulExpectedOverruns++;
+	}
+
+	ullChargedCycles += ulCycles;
+	ulChargedCalls++;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTimerOverrunHook( TimerHandle_t xOverrunTimer, uint32_t ulCycles )
+{
+	/* Called after the callback, so the cycles are those of the latest
+	call. */
+	if( ( xOverrunTimer != xTimer ) ||
+		( ulCycles != ulCallbackCycles[ ( ulCalls - 1UL ) % testCALLBACK_CYCLES_COUNT ] ) ||
+		( ulCycles <= ulBudget ) )
+	{
+		ulHookErrors++;
+	}
+
+	ulHookCalls++;
+}
+/*-----------------------------------------------------------*/
+
+static int prvCheck( const char *pcWhat, BaseType_t xPassed )
+{
+	printf( "  %-46s %s\n", pcWhat, ( xPassed != pdFALSE ) ? "ok" : "FAILED" );
+	return ( xPassed != pdFALSE ) ? 0 : 1;
+}
+/*-----------------------------------------------------------*/
+
+/* Move the tick count on one tick at a time, as the daemon would see it. */
+static void prvRunTicks( TickType_t xTicks )
+{
+	while( xTicks-- > ( TickType_t ) 0U )
+	{
+		xTickCount++;
+		prvRunDaemon();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static int prvCheckStats( const char *pcName, TickType_t xLateness, uint32_t ulMissedPeriods )
+{
+TimerCallbackStats_t xStats;
+int iFailures = 0;
+
+	vTimerGetCallbackStats( xTimer, &xStats );
+
+	printf( "%s\n  %lu calls, min %lu, max %lu, average %lu cycles, %lu overruns\n", pcName,
+			( unsigned long ) xStats.ulCallbacks, ( unsigned long ) xStats.ulMinCycles,
+			( unsigned long ) xStats.ulMaxCycles, ( unsigned long ) xStats.ulAverageCycles,
+			( unsigned long ) xStats.ulOverruns );
+
+	iFailures += prvCheck( "calls counted", xStats.ulCallbacks == ulChargedCalls );
+	iFailures += prvCheck( "shortest call", xStats.ulMinCycles == ulChargedMin );
+	iFailures += prvCheck( "longest call", xStats.ulMaxCycles == ulChargedMax );
+	iFailures += prvCheck( "average of the total",
+						   xStats.ulAverageCycles == ( ( ulChargedCalls != 0UL ) ? ( uint32_t ) ( ullChargedCycles / ulChargedCalls ) : 0UL ) );
+	iFailures += prvCheck( "overruns counted", xStats.ulOverruns == ulExpectedOverruns );
+	iFailures += prvCheck( "worst lateness", xStats.xMaxLateness == xLateness );
+	iFailures += prvCheck( "missed periods", xStats.ulMissedPeriods == ulMissedPeriods );
+
+	return iFailures;
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+TimerCallbackStats_t xStats;
+unsigned long ulHookCallsBefore, ulCallsBefore;
+int iFailures = 0;
+
+	#if( configUSE_TIMER_WHEEL == 1 )
+		printf( "Timing wheel, %u slots\n", ( unsigned ) configTIMER_WHEEL_SLOTS );
+	#else
+		printf( "Sorted list\n" );
+	#endif
+
+	ulCycleCounter = testCYCLE_COUNTER_START;
+	prvClearCharges();
+
+	xTimer = xTimerCreate( "Profiled", testPERIOD, pdTRUE, NULL, prvCallback );
+	configASSERT( xTimer != NULL );
+
+	/* Nothing recorded before the first call. */
+	vTimerGetCallbackStats( xTimer, &xStats );
+	iFailures += prvCheck( "no statistics before the first call",
+						   ( xStats.ulCallbacks == 0UL ) && ( xStats.ulMinCycles == 0UL ) &&
+						   ( xStats.ulMaxCycles == 0UL ) && ( xStats.ulAverageCycles == 0UL ) );
+
+	( void ) xTimerStart( xTimer, 0 );
+	prvRunDaemon();
+
+	/* Each cost in the table once, with the counter overflowing part way
+	through. */
+	prvRunTicks( testPERIOD * ( TickType_t ) testCALLBACK_CYCLES_COUNT );
+	iFailures += prvCheckStats( "Default budget", 0, 0UL );
+	iFailures += prvCheck( "hook called for each overrun", ulHookCalls == ulExpectedOverruns );
+	iFailures += prvCheck( "hook given the timer and its cycles", ulHookErrors == 0UL );
+
+	/* A budget of 0 turns the check off. */
+	ulBudget = 0UL;
+	vTimerSetCallbackBudget( xTimer, ulBudget );
+	ulHookCallsBefore = ulHookCalls;
+	prvRunTicks( testPERIOD * ( TickType_t ) testCALLBACK_CYCLES_COUNT );
+	iFailures += prvCheckStats( "No budget", 0, 0UL );
+	iFailures += prvCheck( "hook not called without a budget", ulHookCalls == ulHookCallsBefore );
+
+	/* A budget below every cost makes every call an overrun. */
+	ulBudget = 50UL;
+	vTimerSetCallbackBudget( xTimer, ulBudget );
+	ulHookCallsBefore = ulHookCalls;
+	ulCallsBefore = ulCalls;
+	prvRunTicks( testPERIOD * ( TickType_t ) testCALLBACK_CYCLES_COUNT );
+	iFailures += prvCheckStats( "Budget below every call", 0, 0UL );
+	iFailures += prvCheck( "hook called for every call", ( ulHookCalls - ulHookCallsBefore ) == ( ulCalls - ulCallsBefore ) );
+	iFailures += prvCheck( "hook given the timer and its cycles", ulHookErrors == 0UL );
+
+	/* Cleared statistics read as if the callback had not been called. */
+	vTimerResetCallbackStats( xTimer );
+	prvClearCharges();
+	iFailures += prvCheckStats( "Reset", 0, 0UL );
+
+	/* The calls after the next reset are neither the shortest nor the
+	longest in the table, so would not show statistics left over from the
+	calls before it. */
+	while( ulCallbackCycles[ ulCalls % testCALLBACK_CYCLES_COUNT ] != 800UL )
+	{
+		prvRunTicks( testPERIOD );
+	}
+
+	vTimerResetCallbackStats( xTimer );
+	prvClearCharges();
+
+	/* Miss the next three expiries, the last by three ticks, so the daemon
+	catches up with three calls, the first of them 23 ticks late. */
+	xTickCount += ( testPERIOD * ( TickType_t ) 3 ) + ( TickType_t ) 3;
+	prvRunDaemon();
+	iFailures += prvCheckStats( "After a reset, catching up", ( testPERIOD * ( TickType_t ) 2 ) + ( TickType_t ) 3, 2UL );
+
+	( void ) xTimerDelete( xTimer, 0 );
+	prvRunDaemon();
+
+	return ( iFailures == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,308 @@
+#!/usr/bin/env python3
+"""Converts a dump of the FreeRTOS trace recorder into a Chrome trace.
+
+The trace recorder (configUSE_TRACE_RECORDER, see tracerecorder.h in the kernel
+sources) writes scheduler, queue and interrupt events into xTraceRecorder in
+RAM.  Halt the target and dump the structure, for example from GDB:
+
+    (gdb) dump binary value trace.bin xTraceRecorder
+
+then convert it:
+
+    python3 trace_to_perfetto.py trace.bin -o trace.json
+
+and open trace.json in https://ui.perfetto.dev or chrome://tracing.  A dump of
+the whole of RAM works too - the recorder is found by its magic number.
+
+Each task gets a track showing when it ran, with its queue, semaphore and mutex
+operations as instant events, and a counter track following its priority so
+priority inheritance is visible.  Interrupts handled while recording get a
+track of their own under a separate "Interrupts" process.  Traces that span a
+change of the core clock (vTraceRecorderClockChanged) are converted at the
+rate each part was recorded at.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x52545246
+VERSIONS = (1, 2)
+
+HEADER = struct.Struct('<IHHHHIII')
+EVENT = struct.Struct('<IBBH')
+
+# Event codes, from tracerecorder.h.
+TASK_CREATE = 0x01
+TASK_DELETE = 0x02
+TASK_SWITCHED_IN = 0x03
+TASK_SWITCHED_OUT = 0x04
+TASK_READY = 0x05
+TASK_DELAY = 0x06
+TASK_PRIORITY_INHERIT = 0x07
+TASK_PRIORITY_DISINHERIT = 0x08
+QUEUE_CREATE = 0x10
+QUEUE_SEND = 0x11
+QUEUE_SEND_FAILED = 0x12
+QUEUE_SEND_FROM_ISR = 0x13
+QUEUE_RECEIVE = 0x14
+QUEUE_RECEIVE_FAILED = 0x15
+QUEUE_RECEIVE_FROM_ISR = 0x16
+QUEUE_BLOCKING_ON_SEND = 0x17
+QUEUE_BLOCKING_ON_RECEIVE = 0x18
+ISR_ENTER = 0x20
+ISR_EXIT = 0x21
+CLOCK_CHANGE = 0x30
+
+# Object kinds, from tracerecorder.c.
+OBJECT_TASK = 1
+OBJECT_QUEUE = 2
+
+# ucQueueType values, from queue.h.
+QUEUE_TYPES = {
+    0: 'Queue',
+    1: 'Mutex',
+    2: 'Counting semaphore',
+    3: 'Binary semaphore',
+    4: 'Recursive mutex',
+}
+
+QUEUE_OPERATIONS = {
+    QUEUE_SEND: ('send', 'give', ''),
+    QUEUE_SEND_FAILED: ('send', 'give', ' failed'),
+    QUEUE_SEND_FROM_ISR: ('send', 'give', ' from ISR'),
+    QUEUE_RECEIVE: ('receive', 'take', ''),
+    QUEUE_RECEIVE_FAILED: ('receive', 'take', ' failed'),
+    QUEUE_RECEIVE_FROM_ISR: ('receive', 'take', ' from ISR'),
+    QUEUE_BLOCKING_ON_SEND: ('send', 'give', ' blocked'),
+    QUEUE_BLOCKING_ON_RECEIVE: ('receive', 'take', ' blocked'),
+}
+
+TASKS_PID = 1
+INTERRUPTS_PID = 2
+
+
+class Recorder:
+    def __init__(self, data):
+        offset = find_recorder(data)
+        (magic, version, event_count, object_count, name_length, self.hz,
+         self.written, self.objects_created) = HEADER.unpack_from(data, offset)
+        if version not in VERSIONS:
+            raise ValueError('recorder version %d is not supported' % version)
+        if self.hz == 0:
+            raise ValueError('recorder timestamp rate is 0')
+        events_offset = offset + HEADER.size
+        objects_offset = events_offset + event_count * EVENT.size
+        object_size = 2 + name_length
+        if len(data) < objects_offset + object_count * object_size:
+            raise ValueError('dump is shorter than the recorder')
+
+        # The ring holds the last event_count events, oldest first from the
+        # write position once it has wrapped.
+        first = max(0, self.written - event_count)
+        self.events = []
+        for index in range(first, self.written):
+            slot = index & (event_count - 1)
+            self.events.append(EVENT.unpack_from(data, events_offset + slot * EVENT.size))
+        self.lost = first
+
+        # Timestamps count core clock cycles.  The header holds the rate when
+        # the dump was taken and each clock change event the rate before it,
+        # so work back from the newest event to find the rate in effect up to
+        # each one.
+        self.rates = []
+        rate = self.hz
+        for _, event, argument, number in reversed(self.events):
+            if event == CLOCK_CHANGE:
+                rate = ((argument << 16) | number) * 1000
+            self.rates.append(rate)
+        self.rates.reverse()
+        if 0 in self.rates:
+            raise ValueError('recorder timestamp rate is 0')
+
+        self.objects = {}
+        for number in range(1, min(object_count, self.objects_created) + 1):
+            base = objects_offset + (number - 1) * object_size
+            kind, detail = data[base], data[base + 1]
+            name = data[base + 2:base + object_size].split(b'\0')[0]
+            self.objects[number] = (kind, detail, name.decode('ascii', 'replace'))
+
+        # Objects beyond the end of the name table are known from their create
+        # events, if those are still in the ring.
+        for _, event, argument, number in self.events:
+            if number not in self.objects:
+                if event == TASK_CREATE:
+                    self.objects[number] = (OBJECT_TASK, argument, '')
+                elif event == QUEUE_CREATE:
+                    self.objects[number] = (OBJECT_QUEUE, argument, '')
+
+    def name(self, number):
+        kind, detail, name = self.objects.get(number, (OBJECT_TASK, 0, ''))
+        if name:
+            return name
+        if kind == OBJECT_QUEUE:
+            return '%s %d' % (QUEUE_TYPES.get(detail, 'Queue'), number)
+        return 'Task %d' % number
+
+    def is_semaphore(self, number):
+        kind, detail, _ = self.objects.get(number, (OBJECT_QUEUE, 0, ''))
+        return kind == OBJECT_QUEUE and detail != 0
+
+
+def find_recorder(data):
+    magic = struct.pack('<I', MAGIC)
+    offset = data.find(magic)
+    while offset >= 0 and offset % 4 != 0:
+        offset = data.find(magic, offset + 1)
+    if offset < 0:
+        raise ValueError('no trace recorder found - was vTraceRecorderStart() called?')
+    return offset
+
+
+def interrupt_name(number):
+    names = {2: 'NMI', 3: 'HardFault', 11: 'SVCall', 14: 'PendSV', 15: 'SysTick'}
+    if number in names:
+        return names[number]
+    if number >= 16:
+        return 'IRQ %d' % (number - 16)
+    return 'Exception %d' % number
+
+
+def convert(recorder):
+    trace = []
+
+    def meta(pid, tid, name, value):
+        trace.append({'ph': 'M', 'pid': pid, 'tid': tid, 'name': name, 'args': {'name': value}})
+
+    meta(TASKS_PID, 0, 'process_name', 'Tasks')
+    meta(INTERRUPTS_PID, 0, 'process_name', 'Interrupts')
+
+    tracks = {TASKS_PID: set(), INTERRUPTS_PID: set()}
+    running = None          # (task, start)
+    isr_stack = []          # [(exception, start)]
+    current = 0             # 0 until the first task runs
+    switched = False
+    timestamp = 0
+    previous = None
+
+    def slice_(pid, tid, name, begin, end, args=None):
+        tracks[pid].add(tid)
+        event = {'ph': 'X', 'pid': pid, 'tid': tid, 'name': name,
+                 'ts': begin, 'dur': max(end - begin, 0)}
+        if args:
+            event['args'] = args
+        trace.append(event)
+
+    def instant(pid, tid, name, at, args=None):
+        tracks[pid].add(tid)
+        event = {'ph': 'i', 's': 't', 'pid': pid, 'tid': tid, 'name': name, 'ts': at}
+        if args:
+            event['args'] = args
+        trace.append(event)
+
+    def priority(task, at, value):
+        trace.append({'ph': 'C', 'pid': TASKS_PID, 'name': '%s priority' % recorder.name(task),
+                      'ts': at, 'args': {'priority': value}})
+
+    for index, (raw, event, argument, number) in enumerate(recorder.events):
+        # Timestamps are a 32 bit cycle count, so unwrap them by accumulating
+        # the difference from the previous event, in microseconds.
+        if previous is not None:
+            timestamp += ((raw - previous) & 0xffffffff) * 1e6 / recorder.rates[index]
+        previous = raw
+
+        if event == TASK_SWITCHED_IN:
+            if running is not None:
+                slice_(TASKS_PID, running[0], 'Running', running[1], timestamp)
+            running = (number, timestamp)
+            current = number
+            switched = True
+            priority(number, timestamp, argument)
+        elif event == TASK_SWITCHED_OUT:
+            if running is not None and running[0] == number:
+                slice_(TASKS_PID, number, 'Running', running[1], timestamp)
+            elif not switched:
+                # The ring started part way through this task running.
+                slice_(TASKS_PID, number, 'Running', 0, timestamp)
+            running = None
+            current = number
+            switched = True
+        elif event == TASK_CREATE:
+            instant(TASKS_PID, number, 'Created', timestamp, {'priority': argument})
+            priority(number, timestamp, argument)
+        elif event == TASK_DELETE:
+            instant(TASKS_PID, number, 'Deleted', timestamp)
+        elif event == TASK_READY:
+            instant(TASKS_PID, number, 'Ready', timestamp, {'priority': argument})
+        elif event == TASK_DELAY:
+            instant(TASKS_PID, number, 'Delay', timestamp)
+        elif event == TASK_PRIORITY_INHERIT:
+            instant(TASKS_PID, number, 'Priority inherited', timestamp, {'priority': argument})
+            priority(number, timestamp, argument)
+        elif event == TASK_PRIORITY_DISINHERIT:
+            instant(TASKS_PID, number, 'Priority disinherited', timestamp, {'priority': argument})
+            priority(number, timestamp, argument)
+        elif event == QUEUE_CREATE:
+            instant(TASKS_PID, current, 'Create %s' % recorder.name(number), timestamp)
+        elif event in QUEUE_OPERATIONS:
+            queue_verb, semaphore_verb, suffix = QUEUE_OPERATIONS[event]
+            verb = semaphore_verb if recorder.is_semaphore(number) else queue_verb
+            name = '%s %s%s' % (verb, recorder.name(number), suffix)
+            if isr_stack:
+                instant(INTERRUPTS_PID, isr_stack[-1][0], name, timestamp, {'count': argument})
+            else:
+                instant(TASKS_PID, current, name, timestamp, {'count': argument})
+        elif event == ISR_ENTER:
+            isr_stack.append((argument, timestamp))
+        elif event == ISR_EXIT:
+            if isr_stack and isr_stack[-1][0] == argument:
+                exception, begin = isr_stack.pop()
+                slice_(INTERRUPTS_PID, exception, interrupt_name(exception), begin, timestamp)
+        elif event == CLOCK_CHANGE:
+            rate = recorder.rates[index + 1] if index + 1 < len(recorder.rates) else recorder.hz
+            instant(TASKS_PID, current, 'Clock changed', timestamp, {'hz': rate})
+
+    if running is not None:
+        slice_(TASKS_PID, running[0], 'Running', running[1], timestamp)
+    for exception, begin in isr_stack:
+        slice_(INTERRUPTS_PID, exception, interrupt_name(exception), begin, timestamp)
+
+    for task in sorted(tracks[TASKS_PID]):
+        meta(TASKS_PID, task, 'thread_name', recorder.name(task) if task else 'Before scheduler')
+    for exception in sorted(tracks[INTERRUPTS_PID]):
+        meta(INTERRUPTS_PID, exception, 'thread_name', interrupt_name(exception))
+
+    return {'traceEvents': trace, 'displayTimeUnit': 'ns',
+            'otherData': {'timestamp_hz': recorder.hz, 'events': len(recorder.events),
+                          'events_overwritten': recorder.lost}}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('dump', help='binary dump of xTraceRecorder, or of RAM')
+    parser.add_argument('-o', '--output', help='JSON file to write, standard output if omitted')
+    args = parser.parse_args()
+
+    with open(args.dump, 'rb') as dump:
+        data = dump.read()
+    try:
+        recorder = Recorder(data)
+    except ValueError as error:
+        sys.stderr.write('%s: %s\n' % (args.dump, error))
+        return 1
+
+    result = convert(recorder)
+    if recorder.lost:
+        sys.stderr.write('%d older events were overwritten before the dump\n' % recorder.lost)
+
+    if args.output:
+        with open(args.output, 'w') as output:
+            json.dump(result, output, indent=1)
+    else:
+        json.dump(result, sys.stdout, indent=1)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())